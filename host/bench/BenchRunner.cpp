@@ -0,0 +1,273 @@
+/**
+ * @file BenchRunner.cpp
+ * @brief Executor dos microbenchmarks, contagem de alocações e baseline.
+ *
+ * As alocações são contadas substituindo malloc/calloc/realloc/free da
+ * glibc (operator new passa por malloc). Só a thread que executa o
+ * benchmark deve alocar durante a medição.
+ *
+ * Uso:
+ *   core_bench [--filter texto] [--min-time-ms 200] [--repetitions 3]
+ *              [--baseline arquivo] [--save-baseline arquivo]
+ *              [--max-regression pct] [--list]
+ */
+
+#include "BenchRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void __libc_free(void* pointer);
+}
+
+static std::atomic<uint64_t> s_allocations{0};
+static std::atomic<uint64_t> s_allocatedBytes{0};
+
+extern "C" void* malloc(size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_allocatedBytes.fetch_add(count * size, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void free(void* pointer) {
+    __libc_free(pointer);
+}
+
+namespace Bench {
+
+namespace {
+
+struct Entry {
+    const char* name;
+    Function function;
+    size_t bytesPerOp;
+};
+
+struct Result {
+    double nsPerOp;
+    double allocsPerOp;
+    double bytesPerOp;
+};
+
+struct Options {
+    const char* filter = nullptr;
+    double minTimeMs = 200.0;
+    int repetitions = 3;
+    const char* baseline = BENCH_BASELINE_FILE;
+    const char* saveBaseline = nullptr;
+    double maxRegression = -1.0;
+    bool list = false;
+};
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<Entry>& registry() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+Result measureOnce(const Entry& entry, size_t iterations) {
+    uint64_t allocations = s_allocations.load(std::memory_order_relaxed);
+    uint64_t bytes = s_allocatedBytes.load(std::memory_order_relaxed);
+
+    Clock::time_point start = Clock::now();
+    entry.function(iterations);
+    double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    Result result;
+    result.nsPerOp = elapsedNs / iterations;
+    result.allocsPerOp = static_cast<double>(s_allocations.load(std::memory_order_relaxed) - allocations) / iterations;
+    result.bytesPerOp = static_cast<double>(s_allocatedBytes.load(std::memory_order_relaxed) - bytes) / iterations;
+    return result;
+}
+
+Result measure(const Entry& entry, const Options& options) {
+    // Calibra as iterações até uma rodada durar o tempo mínimo
+    size_t iterations = 1;
+    Result result = measureOnce(entry, iterations);
+    while (result.nsPerOp * iterations < options.minTimeMs * 1e6) {
+        double target = options.minTimeMs * 1e6 * 1.2 / std::max(result.nsPerOp, 0.1);
+        iterations = static_cast<size_t>(std::min(std::max(target, iterations * 2.0), iterations * 100.0));
+        result = measureOnce(entry, iterations);
+    }
+
+    // Repetições: fica com a rodada mais rápida, a menos afetada por ruído
+    for (int i = 1; i < options.repetitions; i++) {
+        Result again = measureOnce(entry, iterations);
+        if (again.nsPerOp < result.nsPerOp) {
+            result = again;
+        }
+    }
+    return result;
+}
+
+std::map<std::string, Result> loadBaseline(const char* path) {
+    std::map<std::string, Result> baseline;
+    FILE* file = path ? fopen(path, "r") : nullptr;
+    if (!file) {
+        return baseline;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        char name[128];
+        Result result;
+        if (line[0] == '#' ||
+            sscanf(line, "%127s %lf %lf %lf", name, &result.nsPerOp, &result.allocsPerOp, &result.bytesPerOp) != 4) {
+            continue;
+        }
+        baseline[name] = result;
+    }
+    fclose(file);
+    return baseline;
+}
+
+bool saveBaseline(const char* path, const std::vector<std::pair<const Entry*, Result>>& results) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    fprintf(file, "# Baseline de host/bench (core_bench --save-baseline). Valores dependem da máquina.\n");
+    fprintf(file, "# nome ns/op alocações/op bytes/op\n");
+    for (const auto& item : results) {
+        fprintf(file, "%s %.1f %.2f %.1f\n", item.first->name, item.second.nsPerOp,
+                item.second.allocsPerOp, item.second.bytesPerOp);
+    }
+    fclose(file);
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--list") == 0) {
+            options.list = true;
+            continue;
+        }
+        if (!value) {
+            fprintf(stderr, "Argumento inválido ou sem valor: %s\n", arg);
+            return false;
+        }
+
+        if (strcmp(arg, "--filter") == 0) {
+            options.filter = value;
+        } else if (strcmp(arg, "--min-time-ms") == 0) {
+            options.minTimeMs = atof(value);
+        } else if (strcmp(arg, "--repetitions") == 0) {
+            options.repetitions = std::max(1, atoi(value));
+        } else if (strcmp(arg, "--baseline") == 0) {
+            options.baseline = value;
+        } else if (strcmp(arg, "--save-baseline") == 0) {
+            options.saveBaseline = value;
+        } else if (strcmp(arg, "--max-regression") == 0) {
+            options.maxRegression = atof(value);
+        } else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+} // namespace
+
+bool add(const char* name, Function function, size_t bytesPerOp) {
+    registry().push_back({name, function, bytesPerOp});
+    return true;
+}
+
+int run(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    std::vector<Entry> entries = registry();
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return strcmp(a.name, b.name) < 0; });
+
+    if (options.list) {
+        for (const Entry& entry : entries) {
+            printf("%s\n", entry.name);
+        }
+        return 0;
+    }
+
+    std::map<std::string, Result> baseline = loadBaseline(options.baseline);
+    std::vector<std::pair<const Entry*, Result>> results;
+    int regressions = 0;
+
+    printf("%-32s %11s %9s %9s %13s %9s  %s\n",
+           "benchmark", "ns/op", "allocs/op", "B/op", "ops/s", "MB/s", "vs baseline");
+
+    for (const Entry& entry : entries) {
+        if (options.filter && !strstr(entry.name, options.filter)) {
+            continue;
+        }
+
+        Result result = measure(entry, options);
+        results.push_back({&entry, result});
+
+        char throughput[16] = "-";
+        if (entry.bytesPerOp > 0) {
+            snprintf(throughput, sizeof(throughput), "%.1f", entry.bytesPerOp * 1e3 / result.nsPerOp);
+        }
+
+        char comparison[64] = "-";
+        auto previous = baseline.find(entry.name);
+        if (previous != baseline.end()) {
+            double change = (result.nsPerOp / previous->second.nsPerOp - 1.0) * 100.0;
+            bool moreBytes = result.bytesPerOp > previous->second.bytesPerOp + 0.5;
+            bool regressed = options.maxRegression >= 0 && (change > options.maxRegression || moreBytes);
+            snprintf(comparison, sizeof(comparison), "%+6.1f%%%s%s", change,
+                     moreBytes ? " +B/op" : "", regressed ? "  REGRESSÃO" : "");
+            regressions += regressed ? 1 : 0;
+        }
+
+        printf("%-32s %11.1f %9.2f %9.1f %13.0f %9s  %s\n", entry.name, result.nsPerOp,
+               result.allocsPerOp, result.bytesPerOp, 1e9 / result.nsPerOp, throughput, comparison);
+    }
+
+    if (options.saveBaseline) {
+        if (!saveBaseline(options.saveBaseline, results)) {
+            fprintf(stderr, "Falha ao gravar %s\n", options.saveBaseline);
+            return 2;
+        }
+        printf("Baseline gravado em %s\n", options.saveBaseline);
+    }
+
+    if (regressions > 0) {
+        printf("%d benchmark(s) acima do limite de %.1f%%\n", regressions, options.maxRegression);
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace Bench
@@ -0,0 +1,62 @@
+/**
+ * @file BenchRunner.h
+ * @brief Microbenchmarks do host: ns/op, alocações por op e vazão.
+ *
+ * Cada benchmark é uma função que executa a operação `iterations` vezes.
+ * O executor aumenta as iterações até a medição passar do tempo mínimo e
+ * conta as alocações do processo (malloc/calloc/realloc) durante a rodada.
+ * Os resultados podem ser comparados com um arquivo de baseline.
+ */
+
+#ifndef HOST_BENCH_RUNNER_H
+#define HOST_BENCH_RUNNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Bench {
+
+typedef void (*Function)(size_t iterations);
+
+/**
+ * @brief Registra um benchmark (usado pela macro BENCHMARK).
+ * @param name Nome único, no formato "módulo.operação".
+ * @param function Executa a operação `iterations` vezes.
+ * @param bytesPerOp Bytes processados por operação, para a vazão em MB/s (0 = não se aplica).
+ */
+bool add(const char* name, Function function, size_t bytesPerOp = 0);
+
+/**
+ * @brief Impede que o compilador descarte um resultado calculado.
+ */
+template <typename T>
+inline void keep(const T& value) {
+    __asm__ __volatile__("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Impede que o compilador assuma o conteúdo da memória apontada.
+ */
+inline void clobber() {
+    __asm__ __volatile__("" : : : "memory");
+}
+
+/**
+ * @brief Executa os benchmarks conforme os argumentos da linha de comando.
+ * @return Código de saída do processo.
+ */
+int run(int argc, char** argv);
+
+} // namespace Bench
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+
+// Define e registra um benchmark: BENCHMARK("log.ring_add", bytes) { ... uso de iterations ... }
+#define BENCHMARK(name, ...) \
+    static void BENCH_CONCAT(benchFunction, __LINE__)(size_t iterations); \
+    static const bool BENCH_CONCAT(benchRegistered, __LINE__) = \
+        Bench::add(name, BENCH_CONCAT(benchFunction, __LINE__), ##__VA_ARGS__); \
+    static void BENCH_CONCAT(benchFunction, __LINE__)(size_t iterations)
+
+#endif // HOST_BENCH_RUNNER_H
@@ -0,0 +1,110 @@
+/**
+ * @file console_filter_bench.cpp
+ * @brief Custo por mensagem do filtro de console: autômato vs. busca ingênua.
+ *
+ * A referência reproduz a implementação anterior de ConsoleFilter: constrói
+ * uma string no heap a partir da mensagem e procura cada padrão em sequência.
+ * O autômato é o mesmo PatternMatcher usado no firmware.
+ */
+
+#include "PatternMatcher.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Padrões registrados pelo firmware
+const char* const kDefaultPatterns[] = {
+    "Watchdog resetado",
+    "Task watchdog got triggered",
+    "WATCHDOG-TIMER",
+    "WDT",
+};
+
+// Linhas típicas do console, em sua maioria não filtradas
+const char* const kMessages[] = {
+    "[   12.345][INFO ][SENSORS   ] Umidade do solo: 42.5% (ADC 2310)",
+    "[   12.355][INFO ][IRRIGATION] Bomba desligada após 30000 ms",
+    "[   12.365][WARN ][WIFI      ] Reconectando (tentativa 3 de 10)",
+    "[   12.375][DEBUG][WEBSERVER ] Cliente WebSocket #4 conectado de 192.168.0.17",
+    "[   12.385][INFO ][MONITOR   ] Heap livre: 182344 bytes, maior bloco: 110580",
+    "[   12.395][ERROR][SENSORS   ] Falha na leitura do DHT22 (timeout)",
+    "[   12.405][INFO ][SYSTEM    ] Uptime 00:12:34, 3 tarefas ativas",
+    "[   12.415][WARN ][SYSTEM    ] Task watchdog got triggered on CPU 1",
+};
+
+const size_t kMessageCount = sizeof(kMessages) / sizeof(kMessages[0]);
+const size_t kIterations = 200000;
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<std::string> makePatterns(size_t count) {
+    std::vector<std::string> patterns(std::begin(kDefaultPatterns), std::end(kDefaultPatterns));
+    char buffer[48];
+    for (size_t i = patterns.size(); i < count; i++) {
+        snprintf(buffer, sizeof(buffer), "componente-%02zu: ruido", i);
+        patterns.push_back(buffer);
+    }
+    return patterns;
+}
+
+// Implementação anterior: String da mensagem + indexOf por padrão
+bool naiveShouldFilter(const std::vector<std::string>& patterns, const char* message) {
+    std::string msg(message);
+    for (const auto& pattern : patterns) {
+        if (msg.find(pattern) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Fn>
+double measure(Fn&& filter, size_t& matched) {
+    matched = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < kIterations; i++) {
+        matched += filter(kMessages[i % kMessageCount]) ? 1 : 0;
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return elapsed / kIterations;
+}
+
+template <size_t MaxStates>
+void runCase(size_t patternCount) {
+    std::vector<std::string> patterns = makePatterns(patternCount);
+
+    static PatternMatcher<MaxStates> matcher;
+    matcher.clear();
+    for (const auto& pattern : patterns) {
+        if (!matcher.addPattern(pattern.c_str())) {
+            printf("ERRO: capacidade insuficiente para %zu padrões\n", patternCount);
+            return;
+        }
+    }
+
+    size_t naiveMatched = 0;
+    size_t automatonMatched = 0;
+    double naiveNs = measure([&](const char* m) { return naiveShouldFilter(patterns, m); }, naiveMatched);
+    double automatonNs = measure([&](const char* m) { return matcher.matches(m); }, automatonMatched);
+
+    if (naiveMatched != automatonMatched) {
+        printf("ERRO: resultados divergentes (%zu vs %zu)\n", naiveMatched, automatonMatched);
+        return;
+    }
+
+    printf("%3zu padrões (%4zu estados): ingênuo %8.1f ns/msg | autômato %8.1f ns/msg | %5.1fx\n",
+           patternCount, matcher.stateCount(), naiveNs, automatonNs, naiveNs / automatonNs);
+}
+
+} // namespace
+
+int main() {
+    printf("Filtro de console: %zu mensagens de ~65 bytes, %zu iterações\n", kMessageCount, kIterations);
+    runCase<128>(4);
+    runCase<2048>(64);
+    return 0;
+}
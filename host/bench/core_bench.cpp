@@ -0,0 +1,274 @@
+/**
+ * @file core_bench.cpp
+ * @brief Microbenchmarks dos módulos de lógica pura do firmware.
+ *
+ * Os módulos são compilados sem alterações contra os shims de host/shim.
+ * Os benchmarks de TelemetryBuffer e JSON só existem quando o ArduinoJson
+ * é encontrado (ver host/CMakeLists.txt).
+ */
+
+#include "BenchRunner.h"
+
+#include "ConsoleFormat.h"
+#include "ConsoleWriter.h"
+#include "DataTypes.h"
+#include "LogSystem.h"
+#include "SignalFilter.h"
+#include "StringUtils.h"
+
+#if HOST_HAS_ARDUINOJSON
+#include "TelemetryBuffer.h"
+#endif
+
+namespace {
+
+// Módulos e linhas típicas do firmware
+const char* const kModules[] = {
+    "Sensores", "Irrigacao", "WiFi", "WebServer", "Monitor", "Main",
+};
+
+const char* const kMessages[] = {
+    "Umidade do solo: 42.5% (ADC 2310)",
+    "Bomba desligada após 30000 ms",
+    "Reconectando (tentativa 3 de 10)",
+    "Cliente WebSocket #4 conectado de 192.168.0.17",
+    "Heap livre: 182344 bytes, maior bloco: 110580",
+    "Falha na leitura do DHT22 (timeout)",
+    "Uptime 00:12:34, 3 tarefas ativas",
+    "Task watchdog got triggered on CPU 1",
+};
+
+const size_t kModuleCount = sizeof(kModules) / sizeof(kModules[0]);
+const size_t kMessageCount = sizeof(kMessages) / sizeof(kMessages[0]);
+
+// Tamanho médio das mensagens, para a vazão
+const size_t kMessageBytes = 36;
+
+SensorData sampleSensorData(size_t i) {
+    SensorRawData raw;
+    raw.phRaw = static_cast<uint16_t>(i & 4095);
+    raw.temperatureRaw = 20.0f + (i & 15);
+    raw.humidityRaw = 40.0f + (i & 31);
+    raw.phosphorusState = i & 1;
+    raw.potassiumState = (i >> 1) & 1;
+    raw.timestamp = static_cast<uint32_t>(i);
+
+    SensorData data;
+    data.fromRaw(raw);
+    return data;
+}
+
+} // namespace
+
+BENCHMARK("string.safe_copy", 16) {
+    char destination[LOG_MODULE_NAME_MAX_SIZE];
+    for (size_t i = 0; i < iterations; i++) {
+        StringUtils::safeCopyString(destination, kModules[i % kModuleCount], sizeof(destination));
+        Bench::clobber();
+    }
+}
+
+BENCHMARK("string.safe_copy_truncate", kMessageBytes) {
+    char destination[16];
+    for (size_t i = 0; i < iterations; i++) {
+        StringUtils::safeCopyString(destination, kMessages[i % kMessageCount], sizeof(destination));
+        Bench::clobber();
+    }
+}
+
+BENCHMARK("sensor.from_raw") {
+    SensorRawData raw;
+    SensorData data;
+    for (size_t i = 0; i < iterations; i++) {
+        raw.phRaw = static_cast<uint16_t>(i & 4095);
+        raw.temperatureRaw = static_cast<float>(i & 63);
+        data.fromRaw(raw);
+        Bench::keep(data.ph);
+    }
+}
+
+BENCHMARK("sensor.filter_u16") {
+    uint16_t window[5] = {0};
+    uint8_t index = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        uint16_t value = SignalFilter::movingAverage<5, uint32_t>(window, index, static_cast<uint16_t>(i & 4095));
+        index = (index + 1) % 5;
+        Bench::keep(value);
+    }
+}
+
+BENCHMARK("sensor.filter_float") {
+    float window[5] = {0.0f};
+    uint8_t index = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        float value = SignalFilter::movingAverage<5, float>(window, index, static_cast<float>(i & 63));
+        index = (index + 1) % 5;
+        Bench::keep(value);
+    }
+}
+
+BENCHMARK("sensor.to_json_string") {
+    SensorData data = sampleSensorData(7);
+    char buffer[160];
+    for (size_t i = 0; i < iterations; i++) {
+        data.timestamp = static_cast<uint32_t>(i);
+        bool ok = data.toJsonString(buffer, sizeof(buffer));
+        Bench::keep(ok);
+    }
+}
+
+BENCHMARK("console.filter", kMessageBytes) {
+    // Os padrões de produção são registrados pelo LogRouter; sem eles o
+    // matcher retorna antes de percorrer a mensagem
+    LogRouter::getInstance();
+
+    for (size_t i = 0; i < iterations; i++) {
+        bool filtered = ConsoleFilter::shouldFilter(kMessages[i % kMessageCount]);
+        Bench::keep(filtered);
+    }
+}
+
+BENCHMARK("log.ring_add", kMessageBytes) {
+    CircularLogBuffer& ring = CircularLogBuffer::getInstance();
+    for (size_t i = 0; i < iterations; i++) {
+        ring.addEntry(LogLevel::WARN, kModules[i % kModuleCount], kMessages[i % kMessageCount]);
+    }
+}
+
+BENCHMARK("log.ring_read_16") {
+    CircularLogBuffer& ring = CircularLogBuffer::getInstance();
+    for (size_t i = 0; i < 64; i++) {
+        ring.addEntry(LogLevel::WARN, kModules[i % kModuleCount], kMessages[i % kMessageCount]);
+    }
+
+    CircularLogBuffer::Record record;
+    for (size_t i = 0; i < iterations; i++) {
+        CircularLogBuffer::Iterator iterator = ring.newest();
+        for (int n = 0; n < 16 && iterator.next(record); n++) {
+            Bench::keep(record.length);
+        }
+    }
+}
+
+BENCHMARK("log.router_store", kMessageBytes) {
+    LogRouter& router = LogRouter::getInstance();
+    for (size_t i = 0; i < iterations; i++) {
+        router.store(LogLevel::WARN, "Sensores", "Umidade do solo: %.1f%% (ADC %u)",
+                     42.5f, static_cast<unsigned>(i & 4095));
+    }
+}
+
+BENCHMARK("log.router_log", kMessageBytes) {
+    // Caminho completo: formatação, console (Serial descartada) e anel
+    LogRouter& router = LogRouter::getInstance();
+    for (size_t i = 0; i < iterations; i++) {
+        router.log(LogLevel::WARN, "Sensores", "Umidade do solo: %.1f%% (ADC %u)",
+                   42.5f, static_cast<unsigned>(i & 4095));
+    }
+}
+
+#if HOST_HAS_ARDUINOJSON
+namespace {
+
+TelemetryBuffer sampleTelemetry() {
+    SensorData data = sampleSensorData(1234);
+
+    TelemetryBuffer telemetry;
+    telemetry.temperature = data.temperature;
+    telemetry.humidity = data.humidityPercent;
+    telemetry.ph = data.ph;
+    telemetry.phosphorusPresent = data.phosphorusPresent;
+    telemetry.potassiumPresent = data.potassiumPresent;
+    telemetry.irrigationActive = true;
+    telemetry.irrigationUptime = 5400;
+    telemetry.lastIrrigationTime = 3600000;
+    telemetry.dailyActivations = 4;
+    telemetry.freeHeap = 182344;
+    telemetry.heapFragmentation = 12;
+    telemetry.uptime = 86400;
+    telemetry.wifiRssi = static_cast<uint32_t>(-67);
+    telemetry.timestamp = data.timestamp;
+    telemetry.readCount = 8640;
+    StringUtils::safeCopyString(telemetry.ipAddress, "192.168.0.42", sizeof(telemetry.ipAddress));
+    return telemetry;
+}
+
+} // namespace
+
+BENCHMARK("telemetry.console_string") {
+    TelemetryBuffer telemetry = sampleTelemetry();
+    char buffer[256];
+    for (size_t i = 0; i < iterations; i++) {
+        telemetry.timestamp = static_cast<uint32_t>(i);
+        Bench::keep(telemetry.toConsoleString(buffer, sizeof(buffer), TelemetryBuffer::TelemetryType::ALL));
+    }
+}
+
+BENCHMARK("telemetry.to_json") {
+    // Mesmo documento e buffer da mensagem enviada pelo WebSocket
+    TelemetryBuffer telemetry = sampleTelemetry();
+    char message[WS_MESSAGE_BUFFER_SIZE];
+    for (size_t i = 0; i < iterations; i++) {
+        telemetry.timestamp = static_cast<uint32_t>(i);
+        StaticJsonDocument<640> doc;
+        JsonObject root = doc.to<JsonObject>();
+        telemetry.toJson(root);
+        size_t length = serializeJson(doc, message, sizeof(message));
+        Bench::keep(length);
+    }
+}
+#endif // HOST_HAS_ARDUINOJSON
+
+namespace {
+
+/**
+ * Confere que cada registro do anel mantém o próprio módulo, também quando
+ * o nome chega por um buffer reaproveitado com o mesmo endereço.
+ */
+bool checkLogModules() {
+    LogRouter& router = LogRouter::getInstance();
+    router.log(LogLevel::WARN, "CheckA", "mensagem de A");
+    router.log(LogLevel::WARN, "CheckB", "mensagem de B");
+
+    char reused[LOG_MODULE_NAME_MAX_SIZE];
+    StringUtils::safeCopyString(reused, "CheckC", sizeof(reused));
+    CircularLogBuffer::getInstance().addEntry(LogLevel::WARN, reused, "mensagem de C");
+    StringUtils::safeCopyString(reused, "CheckD", sizeof(reused));
+    CircularLogBuffer::getInstance().addEntry(LogLevel::WARN, reused, "mensagem de D");
+
+    const char* const expected[][2] = {
+        {"CheckD", "mensagem de D"}, {"CheckC", "mensagem de C"},
+        {"CheckB", "mensagem de B"}, {"CheckA", "mensagem de A"},
+    };
+
+    CircularLogBuffer::Iterator iterator = CircularLogBuffer::getInstance().newest();
+    CircularLogBuffer::Record record;
+    for (const auto& entry : expected) {
+        if (!iterator.next(record) || strcmp(record.module, entry[0]) != 0 ||
+            strcmp(record.message, entry[1]) != 0) {
+            fprintf(stderr, "Falha: esperado \"%s | %s\", lido \"%s | %s\"\n",
+                    entry[0], entry[1], record.module, record.message);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // A saída do console é descartada; só a tabela de resultados é impressa
+    Serial.setMuted(true);
+    ConsoleWriter::begin(SERIAL_BAUD_RATE);
+
+    // Os benchmarks de log só medem algo válido se o anel guarda o módulo certo
+    if (!checkLogModules()) {
+        return 1;
+    }
+
+#if !HOST_HAS_ARDUINOJSON
+    printf("ArduinoJson não encontrado: benchmarks de TelemetryBuffer e JSON omitidos\n");
+#endif
+
+    return Bench::run(argc, argv);
+}
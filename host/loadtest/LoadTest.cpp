@@ -0,0 +1,707 @@
+/**
+ * @file LoadTest.cpp
+ * @brief Gerador de carga para o painel: clientes WebSocket e pollers HTTP.
+ *
+ * Abre N conexões em /ws, como abas do painel, e M pollers que alternam
+ * entre /data e /logs, contra o dispositivo ou um virtual_device local.
+ * Os clientes WebSocket podem enviar irrigation_toggle a uma taxa total
+ * configurável; a latência é medida até o irrigation_response.
+ *
+ * Ao final mostra, por endpoint, p50/p99/p999 e vazão; para a telemetria,
+ * o intervalo entre quadros (percentis e desvio padrão) e os quadros
+ * perdidos. Um quadro é perdido quando outro cliente recebeu um broadcast
+ * (identificado pelo timestamp do dispositivo) que este cliente, conectado
+ * no mesmo período, não recebeu.
+ *
+ * Uso:
+ *   load_test [--host 127.0.0.1] [--port 80] [--ws 4] [--pollers 2]
+ *             [--paths /data,/logs] [--poll-ms 500] [--toggle-hz 0]
+ *             [--duration 30] [--timeout-ms 5000]
+ *
+ * Com --toggle-hz > 0 a bomba do dispositivo é de fato acionada.
+ */
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string host = "127.0.0.1";
+    uint16_t port = 80;
+    uint32_t wsClients = 4;
+    uint32_t pollers = 2;
+    std::vector<std::string> paths = {"/data", "/logs"};
+    uint32_t pollMs = 500;       // 0 = sem pausa entre requisições
+    double toggleHz = 0.0;       // Total somando todos os clientes
+    double durationSeconds = 30.0;
+    uint32_t timeoutMs = 5000;
+};
+
+std::atomic<bool> g_stop(false);
+
+/**
+ * Latências (µs) e falhas de um endpoint; cada thread tem as suas e o
+ * resultado é combinado no final.
+ */
+struct EndpointStats {
+    std::vector<uint32_t> latencies;
+    uint64_t bytes = 0;
+    uint32_t errors = 0;
+    std::map<int, uint32_t> statuses;   // Respostas HTTP fora de 2xx
+
+    void merge(const EndpointStats& other) {
+        latencies.insert(latencies.end(), other.latencies.begin(), other.latencies.end());
+        bytes += other.bytes;
+        errors += other.errors;
+        for (const auto& status : other.statuses) {
+            statuses[status.first] += status.second;
+        }
+    }
+};
+
+/**
+ * Resultado de um cliente WebSocket.
+ */
+struct WsClientResult {
+    EndpointStats connect;
+    EndpointStats toggle;
+    std::vector<uint32_t> interArrivals;  // µs entre quadros de telemetria
+    std::set<uint32_t> frames;            // Timestamps de dispositivo recebidos
+    uint64_t frameBytes = 0;
+    uint32_t togglesSent = 0;
+    uint32_t togglesUnanswered = 0;
+    uint32_t disconnects = 0;
+};
+
+uint32_t elapsedUs(Clock::time_point start) {
+    return static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+int connectTo(const Options& options) {
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    char port[8];
+    snprintf(port, sizeof(port), "%u", options.port);
+
+    addrinfo* result = nullptr;
+    if (getaddrinfo(options.host.c_str(), port, &hints, &result) != 0 || !result) {
+        return -1;
+    }
+
+    int fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (fd >= 0 && connect(fd, result->ai_addr, result->ai_addrlen) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+
+    if (fd >= 0) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        ssize_t sent = send(fd, bytes, length, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        bytes += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+/**
+ * Espera dados por até timeoutMs e acrescenta ao buffer.
+ * @return bytes lidos, 0 no timeout e -1 no fechamento ou erro.
+ */
+ssize_t receiveSome(int fd, std::string& buffer, int timeoutMs) {
+    pollfd descriptor = {fd, POLLIN, 0};
+    int ready = poll(&descriptor, 1, timeoutMs);
+    if (ready < 0) {
+        return -1;
+    }
+    if (ready == 0) {
+        return 0;
+    }
+
+    char chunk[4096];
+    ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+    if (received <= 0) {
+        return -1;
+    }
+    buffer.append(chunk, static_cast<size_t>(received));
+    return received;
+}
+
+int parseStatus(const std::string& response) {
+    int status = 0;
+    if (sscanf(response.c_str(), "HTTP/%*s %d", &status) != 1) {
+        return 0;
+    }
+    return status;
+}
+
+void sleepFor(uint32_t ms) {
+    // Fatiado para que o fim do teste não espere a pausa inteira
+    Clock::time_point end = Clock::now() + std::chrono::milliseconds(ms);
+    while (!g_stop.load() && Clock::now() < end) {
+        std::this_thread::sleep_for(std::min(std::chrono::milliseconds(50),
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - Clock::now())));
+    }
+}
+
+// --------------------------------------------------------------------------
+// Pollers HTTP
+// --------------------------------------------------------------------------
+
+/**
+ * Faz uma requisição completa: conexão, envio e leitura até o servidor
+ * fechar (as respostas usam Connection: close).
+ */
+void pollOnce(const Options& options, const std::string& path, EndpointStats& stats) {
+    Clock::time_point start = Clock::now();
+
+    int fd = connectTo(options);
+    if (fd < 0) {
+        stats.errors++;
+        return;
+    }
+
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: " + options.host +
+                          "\r\nConnection: close\r\n\r\n";
+    std::string response;
+    bool ok = sendAll(fd, request.data(), request.size());
+
+    Clock::time_point deadline = start + std::chrono::milliseconds(options.timeoutMs);
+    while (ok) {
+        int remaining = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count());
+        if (remaining <= 0) {
+            ok = false;
+            break;
+        }
+        ssize_t received = receiveSome(fd, response, remaining);
+        if (received < 0) {
+            break;      // Fim da resposta
+        }
+    }
+    close(fd);
+
+    int status = parseStatus(response);
+    if (!ok || status == 0) {
+        stats.errors++;
+        return;
+    }
+    if (status < 200 || status >= 300) {
+        stats.statuses[status]++;
+        stats.errors++;
+        return;
+    }
+    stats.latencies.push_back(elapsedUs(start));
+    stats.bytes += response.size();
+}
+
+void pollerThread(const Options& options, uint32_t index, std::vector<EndpointStats>* results) {
+    size_t next = index % options.paths.size();
+    while (!g_stop.load()) {
+        pollOnce(options, options.paths[next], (*results)[next]);
+        next = (next + 1) % options.paths.size();
+        if (options.pollMs > 0) {
+            sleepFor(options.pollMs);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Clientes WebSocket
+// --------------------------------------------------------------------------
+
+class WsClient {
+public:
+    WsClient(const Options& options, uint32_t index)
+        : m_options(options), m_fd(-1), m_mask(0x9e3779b9u * (index + 1)) {}
+
+    ~WsClient() {
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    /**
+     * Abre a conexão e faz o handshake.
+     */
+    bool open() {
+        m_fd = connectTo(m_options);
+        if (m_fd < 0) {
+            return false;
+        }
+
+        std::string request = "GET /ws HTTP/1.1\r\nHost: " + m_options.host +
+            "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n";
+        if (!sendAll(m_fd, request.data(), request.size())) {
+            return false;
+        }
+
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(m_options.timeoutMs);
+        size_t headerEnd;
+        while ((headerEnd = m_buffer.find("\r\n\r\n")) == std::string::npos) {
+            int remaining = static_cast<int>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count());
+            if (remaining <= 0 || receiveSome(m_fd, m_buffer, remaining) < 0) {
+                return false;
+            }
+        }
+
+        bool upgraded = parseStatus(m_buffer) == 101;
+        m_buffer.erase(0, headerEnd + 4);   // Quadros que chegaram junto
+        return upgraded;
+    }
+
+    /**
+     * Envia um quadro de texto mascarado, como exige o RFC 6455 para clientes.
+     */
+    bool sendText(const char* text) {
+        size_t length = strlen(text);
+        std::string frame;
+        frame.push_back(static_cast<char>(0x81));
+        if (length < 126) {
+            frame.push_back(static_cast<char>(0x80 | length));
+        } else {
+            frame.push_back(static_cast<char>(0x80 | 126));
+            frame.push_back(static_cast<char>(length >> 8));
+            frame.push_back(static_cast<char>(length & 0xFF));
+        }
+        return sendMasked(frame, reinterpret_cast<const uint8_t*>(text), length);
+    }
+
+    /**
+     * Espera até timeoutMs por uma mensagem completa.
+     * @return 1 com mensagem em message, 0 no timeout e -1 se a conexão caiu.
+     */
+    int receive(std::string& message, int timeoutMs) {
+        while (true) {
+            int opcode = takeFrame(message);
+            if (opcode == 0x1 || opcode == 0x2) {
+                return 1;
+            }
+            if (opcode == 0x8) {
+                return -1;
+            }
+            if (opcode == 0x9) {
+                sendMasked(std::string("\x8A", 1) + static_cast<char>(0x80 | message.size()),
+                           reinterpret_cast<const uint8_t*>(message.data()), message.size());
+                continue;
+            }
+            if (opcode > 0) {
+                continue;   // Pong ou outros controles
+            }
+
+            ssize_t received = receiveSome(m_fd, m_buffer, timeoutMs);
+            if (received <= 0) {
+                return static_cast<int>(received);
+            }
+        }
+    }
+
+private:
+    bool sendMasked(std::string frame, const uint8_t* payload, size_t length) {
+        m_mask = m_mask * 1664525u + 1013904223u;
+        uint8_t key[4];
+        memcpy(key, &m_mask, sizeof(key));
+        frame.append(reinterpret_cast<const char*>(key), sizeof(key));
+        for (size_t i = 0; i < length; i++) {
+            frame.push_back(static_cast<char>(payload[i] ^ key[i % 4]));
+        }
+        return sendAll(m_fd, frame.data(), frame.size());
+    }
+
+    /**
+     * Retira um quadro completo do buffer; quadros fragmentados são juntados.
+     * @return opcode do quadro (0 se ainda incompleto).
+     */
+    int takeFrame(std::string& message) {
+        while (m_buffer.size() >= 2) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(m_buffer.data());
+            bool fin = (bytes[0] & 0x80) != 0;
+            int opcode = bytes[0] & 0x0F;
+            bool masked = (bytes[1] & 0x80) != 0;
+            uint64_t length = bytes[1] & 0x7F;
+            size_t offset = 2;
+
+            if (length == 126) {
+                if (m_buffer.size() < 4) return 0;
+                length = (static_cast<uint64_t>(bytes[2]) << 8) | bytes[3];
+                offset = 4;
+            } else if (length == 127) {
+                if (m_buffer.size() < 10) return 0;
+                length = 0;
+                for (int i = 0; i < 8; i++) {
+                    length = (length << 8) | bytes[2 + i];
+                }
+                offset = 10;
+            }
+            size_t maskOffset = offset;
+            if (masked) {
+                offset += 4;
+            }
+            if (m_buffer.size() < offset + length) {
+                return 0;
+            }
+
+            std::string payload = m_buffer.substr(offset, static_cast<size_t>(length));
+            if (masked) {
+                for (size_t i = 0; i < payload.size(); i++) {
+                    payload[i] = static_cast<char>(payload[i] ^ m_buffer[maskOffset + i % 4]);
+                }
+            }
+            m_buffer.erase(0, offset + static_cast<size_t>(length));
+
+            if (opcode >= 0x8) {
+                message = payload;
+                return opcode;
+            }
+            if (opcode != 0x0) {
+                m_fragmentOpcode = opcode;
+                m_fragments.clear();
+            }
+            m_fragments += payload;
+            if (fin) {
+                message.swap(m_fragments);
+                m_fragments.clear();
+                return m_fragmentOpcode;
+            }
+        }
+        return 0;
+    }
+
+    const Options& m_options;
+    int m_fd;
+    uint32_t m_mask;
+    std::string m_buffer;
+    std::string m_fragments;
+    int m_fragmentOpcode = 0x1;
+};
+
+bool parseDeviceTimestamp(const std::string& message, uint32_t& timestamp) {
+    size_t position = message.rfind("\"timestamp\":");
+    if (position == std::string::npos) {
+        return false;
+    }
+    timestamp = static_cast<uint32_t>(strtoul(message.c_str() + position + 12, nullptr, 10));
+    return true;
+}
+
+void wsClientThread(const Options& options, uint32_t index, WsClientResult* result) {
+    // A taxa total de comandos é dividida entre os clientes, com fases defasadas
+    double togglePeriodMs = options.toggleHz > 0.0 ? 1000.0 * options.wsClients / options.toggleHz : 0.0;
+
+    while (!g_stop.load()) {
+        WsClient client(options, index);
+        Clock::time_point start = Clock::now();
+        if (!client.open()) {
+            result->connect.errors++;
+            sleepFor(500);
+            continue;
+        }
+        result->connect.latencies.push_back(elapsedUs(start));
+
+        Clock::time_point nextToggle = Clock::now() + std::chrono::microseconds(
+            static_cast<int64_t>(togglePeriodMs * 1000.0 * (index + 1) / options.wsClients));
+        Clock::time_point lastFrame;
+        bool haveFrame = false;
+        std::deque<Clock::time_point> pendingToggles;
+        std::string message;
+
+        while (!g_stop.load()) {
+            Clock::time_point now = Clock::now();
+            if (togglePeriodMs > 0.0 && now >= nextToggle) {
+                if (!client.sendText("{\"action\":\"irrigation_toggle\"}")) {
+                    break;
+                }
+                pendingToggles.push_back(now);
+                result->togglesSent++;
+                nextToggle += std::chrono::microseconds(static_cast<int64_t>(togglePeriodMs * 1000.0));
+            }
+
+            int waitMs = 100;
+            if (togglePeriodMs > 0.0) {
+                int untilToggle = static_cast<int>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(nextToggle - now).count());
+                waitMs = std::max(0, std::min(waitMs, untilToggle));
+            }
+
+            int status = client.receive(message, waitMs);
+            if (status < 0) {
+                break;
+            }
+            if (status == 0) {
+                continue;
+            }
+
+            Clock::time_point arrival = Clock::now();
+            if (message.find("\"irrigation_response\"") != std::string::npos) {
+                if (!pendingToggles.empty()) {
+                    result->toggle.latencies.push_back(static_cast<uint32_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(arrival - pendingToggles.front()).count()));
+                    result->toggle.bytes += message.size();
+                    pendingToggles.pop_front();
+                }
+                if (message.find("\"success\":false") != std::string::npos) {
+                    result->toggle.errors++;
+                }
+                continue;
+            }
+
+            uint32_t timestamp;
+            if (message.find("\"sensors\"") != std::string::npos && parseDeviceTimestamp(message, timestamp)) {
+                if (haveFrame) {
+                    result->interArrivals.push_back(static_cast<uint32_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(arrival - lastFrame).count()));
+                }
+                lastFrame = arrival;
+                haveFrame = true;
+                result->frames.insert(timestamp);
+                result->frameBytes += message.size();
+            }
+        }
+
+        result->togglesUnanswered += static_cast<uint32_t>(pendingToggles.size());
+        if (!g_stop.load()) {
+            result->disconnects++;
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Relatório
+// --------------------------------------------------------------------------
+
+uint32_t percentile(std::vector<uint32_t>& samples, double fraction) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(std::ceil(fraction * samples.size())) - 1;
+    index = std::min(index, samples.size() - 1);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void printRow(const char* name, EndpointStats& stats, double seconds) {
+    size_t count = stats.latencies.size();
+    printf("%-12s %8zu %7u %9.2f %9.2f %9.2f %9.2f %9.1f %10.1f\n", name, count, stats.errors,
+           percentile(stats.latencies, 0.50) / 1000.0, percentile(stats.latencies, 0.99) / 1000.0,
+           percentile(stats.latencies, 0.999) / 1000.0, percentile(stats.latencies, 1.0) / 1000.0,
+           count / seconds, stats.bytes / 1024.0 / seconds);
+    for (const auto& status : stats.statuses) {
+        printf("%-12s   HTTP %d: %u\n", "", status.first, status.second);
+    }
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            fprintf(stderr, "Argumento inválido ou sem valor: %s\n", arg);
+            return false;
+        }
+
+        if (strcmp(arg, "--host") == 0) {
+            options.host = value;
+        } else if (strcmp(arg, "--port") == 0) {
+            options.port = static_cast<uint16_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--ws") == 0) {
+            options.wsClients = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--pollers") == 0) {
+            options.pollers = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--paths") == 0) {
+            options.paths.clear();
+            std::string list = value;
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t end = list.find(',', start);
+                if (end == std::string::npos) {
+                    end = list.size();
+                }
+                if (end > start) {
+                    options.paths.push_back(list.substr(start, end - start));
+                }
+                start = end + 1;
+            }
+        } else if (strcmp(arg, "--poll-ms") == 0) {
+            options.pollMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--toggle-hz") == 0) {
+            options.toggleHz = atof(value);
+        } else if (strcmp(arg, "--duration") == 0) {
+            options.durationSeconds = atof(value);
+        } else if (strcmp(arg, "--timeout-ms") == 0) {
+            options.timeoutMs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+
+    if (options.port == 0 || options.durationSeconds <= 0.0 || options.toggleHz < 0.0 ||
+        options.timeoutMs == 0 || (options.pollers > 0 && options.paths.empty()) ||
+        (options.toggleHz > 0.0 && options.wsClients == 0)) {
+        fprintf(stderr, "Valores inválidos para --port/--duration/--toggle-hz/--timeout-ms/--paths\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    printf("Alvo %s:%u: %u cliente(s) WebSocket, %u poller(s), %.1f comando(s)/s, %.0f s\n",
+           options.host.c_str(), options.port, options.wsClients, options.pollers,
+           options.toggleHz, options.durationSeconds);
+
+    std::vector<WsClientResult> wsResults(options.wsClients);
+    std::vector<std::vector<EndpointStats>> pollResults(options.pollers,
+        std::vector<EndpointStats>(options.paths.size()));
+    std::vector<std::thread> threads;
+
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < options.wsClients; i++) {
+        threads.emplace_back(wsClientThread, std::cref(options), i, &wsResults[i]);
+    }
+    for (uint32_t i = 0; i < options.pollers; i++) {
+        threads.emplace_back(pollerThread, std::cref(options), i, &pollResults[i]);
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.durationSeconds));
+    g_stop.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Combina os resultados das threads
+    EndpointStats wsConnect;
+    EndpointStats wsToggle;
+    std::vector<uint32_t> interArrivals;
+    std::set<uint32_t> allFrames;
+    uint64_t frameCount = 0;
+    uint64_t frameBytes = 0;
+    uint32_t togglesSent = 0;
+    uint32_t togglesUnanswered = 0;
+    uint32_t disconnects = 0;
+    for (const WsClientResult& result : wsResults) {
+        wsConnect.merge(result.connect);
+        wsToggle.merge(result.toggle);
+        interArrivals.insert(interArrivals.end(), result.interArrivals.begin(), result.interArrivals.end());
+        allFrames.insert(result.frames.begin(), result.frames.end());
+        frameCount += result.frames.size();
+        frameBytes += result.frameBytes;
+        togglesSent += result.togglesSent;
+        togglesUnanswered += result.togglesUnanswered;
+        disconnects += result.disconnects;
+    }
+
+    // Perdidos: broadcasts que outro cliente recebeu dentro do período deste
+    uint64_t dropped = 0;
+    uint64_t expected = 0;
+    for (const WsClientResult& result : wsResults) {
+        if (result.frames.empty()) {
+            continue;
+        }
+        auto first = allFrames.lower_bound(*result.frames.begin());
+        auto last = allFrames.upper_bound(*result.frames.rbegin());
+        uint64_t inWindow = static_cast<uint64_t>(std::distance(first, last));
+        expected += inWindow;
+        dropped += inWindow - result.frames.size();
+    }
+
+    printf("\n%-12s %8s %7s %9s %9s %9s %9s %9s %10s\n", "endpoint", "ok", "falhas",
+           "p50 ms", "p99 ms", "p999 ms", "máx ms", "req/s", "KiB/s");
+    if (options.wsClients > 0) {
+        printRow("ws connect", wsConnect, seconds);
+    }
+    if (togglesSent > 0) {
+        printRow("ws toggle", wsToggle, seconds);
+    }
+    std::vector<EndpointStats> perPath(options.paths.size());
+    for (const auto& poller : pollResults) {
+        for (size_t i = 0; i < poller.size(); i++) {
+            perPath[i].merge(poller[i]);
+        }
+    }
+    for (size_t i = 0; i < perPath.size() && options.pollers > 0; i++) {
+        printRow(options.paths[i].c_str(), perPath[i], seconds);
+    }
+
+    if (options.wsClients > 0) {
+        double mean = 0.0;
+        for (uint32_t value : interArrivals) {
+            mean += value;
+        }
+        mean = interArrivals.empty() ? 0.0 : mean / interArrivals.size();
+        double variance = 0.0;
+        for (uint32_t value : interArrivals) {
+            variance += (value - mean) * (value - mean);
+        }
+        double jitter = interArrivals.empty() ? 0.0 : std::sqrt(variance / interArrivals.size());
+
+        printf("\nTelemetria: %llu quadro(s) (%.1f/s, %.1f KiB/s), %llu broadcast(s) distintos\n",
+               static_cast<unsigned long long>(frameCount), frameCount / seconds,
+               frameBytes / 1024.0 / seconds, static_cast<unsigned long long>(allFrames.size()));
+        printf("Intervalo entre quadros: média %.1f ms, p50 %.1f ms, p99 %.1f ms, p999 %.1f ms, desvio %.1f ms\n",
+               mean / 1000.0, percentile(interArrivals, 0.50) / 1000.0, percentile(interArrivals, 0.99) / 1000.0,
+               percentile(interArrivals, 0.999) / 1000.0, jitter / 1000.0);
+        printf("Perdidos: %llu de %llu (%.2f%%); %u desconexão(ões)\n",
+               static_cast<unsigned long long>(dropped), static_cast<unsigned long long>(expected),
+               expected ? 100.0 * dropped / expected : 0.0, disconnects);
+    }
+    if (togglesSent > 0) {
+        printf("Comandos: %u enviado(s), %u sem resposta, %u recusado(s) pelo controlador\n",
+               togglesSent, togglesUnanswered, wsToggle.errors);
+    }
+
+    // Falha se nenhum cliente conseguiu falar com o alvo
+    bool reached = !wsConnect.latencies.empty();
+    for (const EndpointStats& stats : perPath) {
+        reached = reached || !stats.latencies.empty();
+    }
+    return reached ? 0 : 1;
+}
@@ -0,0 +1,9 @@
+/**
+ * @file Adafruit_Sensor.h
+ * @brief Vazio: a DHT do host não usa a API unificada de sensores.
+ */
+
+#ifndef HOST_ADAFRUIT_SENSOR_H
+#define HOST_ADAFRUIT_SENSOR_H
+
+#endif // HOST_ADAFRUIT_SENSOR_H
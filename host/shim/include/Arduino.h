@@ -0,0 +1,188 @@
+/**
+ * @file Arduino.h
+ * @brief Subconjunto do framework Arduino-ESP32 para compilar o firmware no host.
+ *
+ * Só o que os módulos compilados em host/ usam: tempo monotônico, GPIO em
+ * memória, Serial sobre stdout/stdin e uma String sobre std::string.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_system.h"
+
+// Atributos de seção do ESP32 não têm efeito no host
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define PI 3.1415926535897932384626433832795
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+// Como no core do ESP32, min/max são os de std
+using std::min;
+using std::max;
+
+#define constrain(value, low, high) ((value) < (low) ? (low) : ((value) > (high) ? (high) : (value)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+uint32_t getCpuFrequencyMhz();
+bool setCpuFrequencyMhz(uint32_t mhz);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+
+/**
+ * @class String
+ * @brief String do Arduino sobre std::string (aloca no heap como a original).
+ */
+class String {
+public:
+    String(const char* text = "") : m_text(text ? text : "") {}
+    String(const std::string& text) : m_text(text) {}
+    String(char c) : m_text(1, c) {}
+    String(int value) : m_text(std::to_string(value)) {}
+    String(unsigned int value) : m_text(std::to_string(value)) {}
+    String(long value) : m_text(std::to_string(value)) {}
+    String(unsigned long value) : m_text(std::to_string(value)) {}
+    String(float value, unsigned int decimals = 2) : m_text(format(value, decimals)) {}
+    String(double value, unsigned int decimals = 2) : m_text(format(value, decimals)) {}
+
+    const char* c_str() const { return m_text.c_str(); }
+    unsigned int length() const { return m_text.size(); }
+    bool isEmpty() const { return m_text.empty(); }
+    bool reserve(unsigned int size) { m_text.reserve(size); return true; }
+    char charAt(unsigned int index) const { return index < m_text.size() ? m_text[index] : '\0'; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    int indexOf(const String& text, unsigned int from = 0) const {
+        size_t position = m_text.find(text.m_text, from);
+        return position == std::string::npos ? -1 : static_cast<int>(position);
+    }
+    int indexOf(char c, unsigned int from = 0) const {
+        size_t position = m_text.find(c, from);
+        return position == std::string::npos ? -1 : static_cast<int>(position);
+    }
+    String substring(unsigned int from, unsigned int to = UINT32_MAX) const {
+        if (from >= m_text.size()) return String();
+        return String(m_text.substr(from, (to > m_text.size() ? m_text.size() : to) - from));
+    }
+    bool startsWith(const String& prefix) const { return m_text.rfind(prefix.m_text, 0) == 0; }
+    bool equals(const String& other) const { return m_text == other.m_text; }
+    bool equalsIgnoreCase(const String& other) const {
+        return m_text.size() == other.m_text.size() && strcasecmp(m_text.c_str(), other.m_text.c_str()) == 0;
+    }
+    int toInt() const { return atoi(m_text.c_str()); }
+    float toFloat() const { return static_cast<float>(atof(m_text.c_str())); }
+    void trim();
+
+    String& operator+=(const String& other) { m_text += other.m_text; return *this; }
+    String& operator+=(const char* other) { m_text += other ? other : ""; return *this; }
+    String& operator+=(char c) { m_text += c; return *this; }
+    String& concat(const String& other) { return *this += other; }
+
+    friend String operator+(const String& a, const String& b) { return String(a.m_text + b.m_text); }
+    friend String operator+(const String& a, const char* b) { return String(a.m_text + (b ? b : "")); }
+    friend String operator+(const char* a, const String& b) { return String((a ? a : "") + b.m_text); }
+
+    bool operator==(const String& other) const { return m_text == other.m_text; }
+    bool operator==(const char* other) const { return m_text == (other ? other : ""); }
+    bool operator!=(const String& other) const { return m_text != other.m_text; }
+    bool operator!=(const char* other) const { return !(*this == other); }
+
+private:
+    static std::string format(double value, unsigned int decimals);
+
+    std::string m_text;
+};
+
+/**
+ * @class HardwareSerial
+ * @brief Serial do console: escreve em stdout e lê de stdin sem bloquear.
+ */
+class HardwareSerial {
+public:
+    void begin(unsigned long baudRate);
+    void end() {}
+    size_t setTxBufferSize(size_t size);
+    void flush();
+
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t length);
+    size_t write(const char* text) { return write(reinterpret_cast<const uint8_t*>(text), strlen(text)); }
+    int availableForWrite();
+
+    size_t print(const char* text) { return write(text); }
+    size_t print(const String& text) { return write(text.c_str()); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned int value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(double value, int decimals = 2) { return printf("%.*f", decimals, value); }
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T& value) { return print(value) + println(); }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    int available();
+    int read();
+    int peek();
+
+    /**
+     * @brief Descarta a saída (benchmarks); a entrada continua disponível.
+     */
+    void setMuted(bool muted) { m_muted = muted; }
+
+private:
+    bool m_muted = false;
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * @class EspClass
+ * @brief Contadores do chip; o heap informado é o do processo.
+ */
+class EspClass {
+public:
+    void restart();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getHeapSize();
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return getCpuFrequencyMhz(); }
+    const char* getSdkVersion() { return "host"; }
+};
+
+extern EspClass ESP;
+
+#endif // HOST_ARDUINO_H
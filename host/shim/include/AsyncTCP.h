@@ -0,0 +1,25 @@
+/**
+ * @file AsyncTCP.h
+ * @brief Conexão TCP vista pelo servidor assíncrono (só o endereço remoto).
+ */
+
+#ifndef HOST_ASYNC_TCP_H
+#define HOST_ASYNC_TCP_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class AsyncClient {
+public:
+    explicit AsyncClient(const IPAddress& remoteIP, uint16_t remotePort)
+        : m_remoteIP(remoteIP), m_remotePort(remotePort) {}
+
+    IPAddress remoteIP() const { return m_remoteIP; }
+    uint16_t remotePort() const { return m_remotePort; }
+
+private:
+    IPAddress m_remoteIP;
+    uint16_t m_remotePort;
+};
+
+#endif // HOST_ASYNC_TCP_H
@@ -0,0 +1,35 @@
+/**
+ * @file DHT.h
+ * @brief Sensor DHT virtual: devolve os valores definidos em HostDevice.
+ */
+
+#ifndef HOST_DHT_H
+#define HOST_DHT_H
+
+#include "Arduino.h"
+
+#define DHT11 11
+#define DHT22 22
+
+class DHT {
+public:
+    DHT(uint8_t pin, uint8_t type, uint8_t count = 6) : m_pin(pin), m_type(type) { (void)count; }
+
+    void begin(uint8_t usecPullup = 55) { (void)usecPullup; }
+
+    /**
+     * @return Temperatura em °C (ou °F), NAN quando a falha do sensor está simulada.
+     */
+    float readTemperature(bool fahrenheit = false, bool force = false);
+
+    /**
+     * @return Umidade relativa em %, NAN quando a falha do sensor está simulada.
+     */
+    float readHumidity(bool force = false);
+
+private:
+    uint8_t m_pin;
+    uint8_t m_type;
+};
+
+#endif // HOST_DHT_H
@@ -0,0 +1,302 @@
+/**
+ * @file ESPAsyncWebServer.h
+ * @brief AsyncWebServer/AsyncWebSocket sobre sockets do host.
+ *
+ * Reproduz o subconjunto da ESPAsyncWebServer usado pelo firmware. Como na
+ * biblioteca, uma única tarefa ("async_tcp") aceita conexões, executa os
+ * handlers e os callbacks do WebSocket e preenche as respostas em partes;
+ * textAll() pode ser chamado de qualquer tarefa e só enfileira a mensagem.
+ * Cada resposta HTTP fecha a conexão (Connection: close), como na original.
+ */
+
+#ifndef HOST_ESP_ASYNC_WEB_SERVER_H
+#define HOST_ESP_ASYNC_WEB_SERVER_H
+
+#include "Arduino.h"
+#include "AsyncTCP.h"
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Mesmos limites da biblioteca
+#define DEFAULT_MAX_WS_CLIENTS 8
+#define WS_MAX_QUEUED_MESSAGES 32
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+
+typedef enum {
+    HTTP_GET     = 0b00000001,
+    HTTP_POST    = 0b00000010,
+    HTTP_DELETE  = 0b00000100,
+    HTTP_PUT     = 0b00001000,
+    HTTP_PATCH   = 0b00010000,
+    HTTP_HEAD    = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY     = 0b01111111
+} WebRequestMethod;
+
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+class AsyncWebSocket;
+class AsyncWebSocketClient;
+struct AsyncHostConnection;
+
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+typedef std::function<void(void)> ArDisconnectHandler;
+typedef std::function<size_t(uint8_t* buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+
+/**
+ * @class AsyncWebParameter
+ * @brief Parâmetro da query string, já decodificado.
+ */
+class AsyncWebParameter {
+public:
+    AsyncWebParameter(const String& name, const String& value) : m_name(name), m_value(value) {}
+
+    const String& name() const { return m_name; }
+    const String& value() const { return m_value; }
+
+private:
+    String m_name;
+    String m_value;
+};
+
+/**
+ * @class AsyncWebServerResponse
+ * @brief Resposta com corpo fixo ou preenchida em partes (chunked).
+ */
+class AsyncWebServerResponse {
+public:
+    AsyncWebServerResponse(int code, const String& contentType) : m_code(code), m_contentType(contentType) {}
+
+    void addHeader(const String& name, const String& value);
+    int code() const { return m_code; }
+
+private:
+    friend class AsyncWebServer;
+    friend class AsyncWebServerRequest;
+
+    int m_code;
+    String m_contentType;
+    std::string m_headers;
+    std::string m_body;
+    AwsResponseFiller m_filler;
+};
+
+/**
+ * @class AsyncWebServerRequest
+ * @brief Requisição HTTP recebida; vive até a conexão ser fechada.
+ */
+class AsyncWebServerRequest {
+public:
+    AsyncWebServerRequest(AsyncHostConnection* connection, AsyncClient* client)
+        : m_connection(connection), m_client(client), m_method(HTTP_GET), m_response(nullptr) {}
+    ~AsyncWebServerRequest();
+
+    AsyncClient* client() { return m_client; }
+    const String& url() const { return m_url; }
+    WebRequestMethodComposite method() const { return m_method; }
+
+    bool hasParam(const String& name, bool post = false, bool file = false) const;
+    AsyncWebParameter* getParam(const String& name, bool post = false, bool file = false) const;
+    size_t params() const { return m_params.size(); }
+    AsyncWebParameter* getParam(size_t index) const;
+
+    bool hasHeader(const String& name) const;
+    String header(const String& name) const;
+
+    void onDisconnect(ArDisconnectHandler handler) { m_onDisconnect = handler; }
+
+    void send(AsyncWebServerResponse* response);
+    void send(int code, const String& contentType = String(), const String& content = String());
+
+    AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(),
+                                          const String& content = String());
+    AsyncWebServerResponse* beginResponse_P(int code, const String& contentType,
+                                            const uint8_t* content, size_t length);
+    AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller filler);
+
+private:
+    friend class AsyncWebServer;
+    friend class AsyncWebSocket;
+
+    AsyncHostConnection* m_connection;
+    AsyncClient* m_client;
+    WebRequestMethodComposite m_method;
+    String m_url;
+    std::vector<AsyncWebParameter*> m_params;
+    std::vector<std::pair<String, String>> m_headers;
+    AsyncWebServerResponse* m_response;
+    ArDisconnectHandler m_onDisconnect;
+};
+
+/**
+ * @class AsyncWebHandler
+ * @brief Base dos handlers registrados com AsyncWebServer::addHandler().
+ */
+class AsyncWebHandler {
+public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest* request) = 0;
+    virtual void handleRequest(AsyncWebServerRequest* request) = 0;
+};
+
+/**
+ * @class AsyncCallbackWebHandler
+ * @brief Rota criada por AsyncWebServer::on(): URI exata ou prefixo seguido de '/'.
+ */
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+public:
+    AsyncCallbackWebHandler(const String& uri, WebRequestMethodComposite method, ArRequestHandlerFunction handler)
+        : m_uri(uri), m_method(method), m_handler(handler) {}
+
+    bool canHandle(AsyncWebServerRequest* request) override;
+    void handleRequest(AsyncWebServerRequest* request) override { m_handler(request); }
+
+private:
+    String m_uri;
+    WebRequestMethodComposite m_method;
+    ArRequestHandlerFunction m_handler;
+};
+
+typedef enum {
+    WS_EVT_CONNECT,
+    WS_EVT_DISCONNECT,
+    WS_EVT_PING,
+    WS_EVT_PONG,
+    WS_EVT_ERROR,
+    WS_EVT_DATA
+} AwsEventType;
+
+typedef enum {
+    WS_DISCONNECTED,
+    WS_CONNECTED,
+    WS_DISCONNECTING
+} AwsClientStatus;
+
+typedef enum {
+    WS_CONTINUATION = 0x00,
+    WS_TEXT = 0x01,
+    WS_BINARY = 0x02,
+    WS_DISCONNECT = 0x08,
+    WS_PING = 0x09,
+    WS_PONG = 0x0A
+} AwsFrameType;
+
+typedef struct {
+    uint8_t message_opcode;
+    uint32_t num;
+    uint8_t final;
+    uint8_t masked;
+    uint8_t opcode;
+    uint64_t len;
+    uint8_t mask[4];
+    uint64_t index;
+} AwsFrameInfo;
+
+typedef std::function<void(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                           void* arg, uint8_t* data, size_t len)> AwsEventHandler;
+
+/**
+ * @class AsyncWebSocketClient
+ * @brief Cliente WebSocket; as mensagens aguardam em fila até a tarefa de rede enviá-las.
+ */
+class AsyncWebSocketClient {
+public:
+    AsyncWebSocketClient(AsyncWebSocket* server, AsyncHostConnection* connection, AsyncClient* client, uint32_t id)
+        : m_server(server), m_connection(connection), m_client(client), m_id(id), m_status(WS_CONNECTED) {}
+
+    uint32_t id() const { return m_id; }
+    AwsClientStatus status() const { return m_status; }
+    AsyncClient* client() { return m_client; }
+    IPAddress remoteIP() const { return m_client->remoteIP(); }
+    AsyncWebSocket* server() { return m_server; }
+
+    void text(const char* message, size_t length);
+    void text(const char* message) { text(message, strlen(message)); }
+    void text(const String& message) { text(message.c_str(), message.length()); }
+    void close(uint16_t code = 1000);
+
+private:
+    friend class AsyncWebSocket;
+    friend class AsyncWebServer;
+
+    AsyncWebSocket* m_server;
+    AsyncHostConnection* m_connection;
+    AsyncClient* m_client;
+    uint32_t m_id;
+    AwsClientStatus m_status;
+    std::deque<std::string> m_queue;  // Quadros prontos para envio (protegidos pelo lock do servidor)
+};
+
+/**
+ * @class AsyncWebSocket
+ * @brief Endpoint WebSocket; aceita o upgrade das requisições para a sua URL.
+ */
+class AsyncWebSocket : public AsyncWebHandler {
+public:
+    explicit AsyncWebSocket(const String& url) : m_url(url), m_nextId(1) {}
+
+    const char* url() const { return m_url.c_str(); }
+    void onEvent(AwsEventHandler handler) { m_eventHandler = handler; }
+
+    void textAll(const char* message, size_t length);
+    void textAll(const char* message) { textAll(message, strlen(message)); }
+    void textAll(const String& message) { textAll(message.c_str(), message.length()); }
+
+    size_t count() const;
+    void cleanupClients(uint16_t maxClients = DEFAULT_MAX_WS_CLIENTS);
+
+    bool canHandle(AsyncWebServerRequest* request) override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+
+private:
+    friend class AsyncWebServer;
+    friend class AsyncWebSocketClient;
+
+    void queueFrame(AsyncWebSocketClient* client, const std::string& frame);
+
+    String m_url;
+    uint32_t m_nextId;
+    AwsEventHandler m_eventHandler;
+    std::vector<AsyncWebSocketClient*> m_clients;
+};
+
+/**
+ * @class AsyncWebServer
+ * @brief Servidor HTTP; begin() abre a porta e inicia a tarefa de rede.
+ */
+class AsyncWebServer {
+public:
+    explicit AsyncWebServer(uint16_t port) : m_port(port), m_listenFd(-1) {}
+    ~AsyncWebServer();
+
+    void begin();
+
+    AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction handler);
+    AsyncWebHandler& addHandler(AsyncWebHandler* handler);
+    void onNotFound(ArRequestHandlerFunction handler) { m_notFound = handler; }
+
+private:
+    static void taskFunc(void* parameter);
+    void run();
+    void accept();
+    void process(AsyncHostConnection* connection);
+    bool parseRequest(AsyncHostConnection* connection);
+    void dispatch(AsyncHostConnection* connection);
+    void startWebSocket(AsyncHostConnection* connection, AsyncWebSocket* websocket);
+    void processFrames(AsyncHostConnection* connection);
+    void pumpResponse(AsyncHostConnection* connection);
+    void close(AsyncHostConnection* connection);
+
+    uint16_t m_port;
+    int m_listenFd;
+    std::vector<AsyncWebHandler*> m_handlers;
+    std::vector<AsyncCallbackWebHandler*> m_ownedHandlers;
+    ArRequestHandlerFunction m_notFound;
+    std::vector<AsyncHostConnection*> m_connections;
+};
+
+#endif // HOST_ESP_ASYNC_WEB_SERVER_H
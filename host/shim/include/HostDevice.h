@@ -0,0 +1,93 @@
+/**
+ * @file HostDevice.h
+ * @brief Entradas e saídas do dispositivo virtual, controladas pelo host.
+ *
+ * É por aqui que o cenário do virtual_device alimenta o ADC, os botões, o
+ * DHT22 e o enlace WiFi, e lê as saídas (relé, LED) escritas pelo firmware.
+ * A simulação de eventos discretos (host/sim) também troca aqui o relógio
+ * real por um virtual e conduz a estação WiFi sem a tarefa de eventos.
+ */
+
+#ifndef HOST_DEVICE_H
+#define HOST_DEVICE_H
+
+#include <stdint.h>
+
+namespace HostDevice {
+
+/**
+ * @brief Define o valor lido por analogRead() no pino (0-4095).
+ */
+void setAnalog(uint8_t pin, uint16_t value);
+
+/**
+ * @brief Força o nível de um pino de entrada; prevalece sobre o pull-up.
+ */
+void setDigitalInput(uint8_t pin, uint8_t level);
+
+/**
+ * @brief Nível atual do pino (saídas escritas pelo firmware ou entradas forçadas).
+ */
+uint8_t getPinLevel(uint8_t pin);
+
+/**
+ * @brief Valores devolvidos pelo DHT virtual.
+ */
+void setDht(float temperature, float humidity);
+
+/**
+ * @brief Simula falha de leitura do DHT (as leituras devolvem NAN).
+ */
+void setDhtFailure(bool failing);
+
+/**
+ * @brief Liga ou derruba o enlace com o ponto de acesso virtual.
+ */
+void setWiFiLink(bool up);
+
+/**
+ * @brief RSSI informado por WiFi.RSSI() enquanto conectado.
+ */
+void setWiFiRssi(int8_t rssi);
+
+/**
+ * @brief Quantas vezes o firmware chamou WiFi.begin() ou WiFi.reconnect().
+ */
+uint32_t getWiFiAttempts();
+
+/**
+ * @brief Aplica as transições devidas da estação WiFi no lugar da tarefa de eventos.
+ *
+ * Usado com o relógio virtual, em que a tarefa "arduino_events" não é criada.
+ *
+ * @param nextDeadline Recebe o millis() da próxima transição pendente.
+ * @return true se há uma transição pendente.
+ */
+bool pollWiFi(uint32_t& nextDeadline);
+
+/**
+ * @brief Passa millis(), micros(), delay() e vTaskDelay() para um relógio virtual.
+ *
+ * O relógio parte de zero, como após um boot, e só avança por advanceClockTo() e pelas
+ * esperas, que retornam na hora. Pensado para um processo de uma só thread.
+ */
+void useVirtualClock();
+
+/**
+ * @brief Indica se o relógio virtual está em uso.
+ */
+bool isVirtualClock();
+
+/**
+ * @brief Avança o relógio virtual até o instante dado (em µs); nunca retrocede.
+ */
+void advanceClockTo(int64_t micros);
+
+/**
+ * @brief Porta TCP usada pelo AsyncWebServer no lugar da pedida pelo firmware (0 = a do firmware).
+ */
+void setHttpPort(uint16_t port);
+
+} // namespace HostDevice
+
+#endif // HOST_DEVICE_H
@@ -0,0 +1,31 @@
+/**
+ * @file IPAddress.h
+ * @brief Endereço IPv4 do core Arduino.
+ */
+
+#ifndef HOST_IP_ADDRESS_H
+#define HOST_IP_ADDRESS_H
+
+#include "Arduino.h"
+
+class IPAddress {
+public:
+    IPAddress() : m_octets{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : m_octets{a, b, c, d} {}
+
+    uint8_t operator[](int index) const { return m_octets[index & 3]; }
+    uint8_t& operator[](int index) { return m_octets[index & 3]; }
+    bool operator==(const IPAddress& other) const { return memcmp(m_octets, other.m_octets, 4) == 0; }
+    bool operator!=(const IPAddress& other) const { return !(*this == other); }
+
+    String toString() const {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", m_octets[0], m_octets[1], m_octets[2], m_octets[3]);
+        return String(text);
+    }
+
+private:
+    uint8_t m_octets[4];
+};
+
+#endif // HOST_IP_ADDRESS_H
@@ -0,0 +1,81 @@
+/**
+ * @file WiFi.h
+ * @brief Estação WiFi virtual com a API e os eventos do core Arduino-ESP32.
+ *
+ * A conexão é concluída por uma tarefa de eventos ("arduino_events") quando
+ * o enlace virtual está ativo (HostDevice::setWiFiLink). A queda do enlace
+ * gera ARDUINO_EVENT_WIFI_STA_DISCONNECTED e, como no ESP-IDF sem
+ * autoReconnect, a reconexão fica a cargo do firmware.
+ */
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include <functional>
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6,
+    WL_NO_SHIELD = 255
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_READY = 0,
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_STOP = 3,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP = 9,
+    ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+
+typedef struct {
+    struct {
+        uint8_t reason;
+    } wifi_sta_disconnected;
+    struct {
+        uint8_t ip[4];
+    } got_ip;
+} arduino_event_info_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef arduino_event_info_t WiFiEventInfo_t;
+typedef std::function<void(arduino_event_id_t event, arduino_event_info_t info)> WiFiEventFuncCb;
+typedef uint16_t wifi_event_id_t;
+
+class WiFiClass {
+public:
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0);
+    bool reconnect();
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+
+    bool mode(wifi_mode_t mode);
+    bool setSleep(bool enabled) { (void)enabled; return true; }
+    void persistent(bool persistent) { (void)persistent; }
+
+    wl_status_t status();
+    IPAddress localIP();
+    int8_t RSSI();
+    int32_t channel();
+
+    wifi_event_id_t onEvent(WiFiEventFuncCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFI_H
@@ -0,0 +1,13 @@
+/**
+ * @file crc.h
+ * @brief CRC32 da ROM do ESP32 (mesmo resultado do crc32 do zlib).
+ */
+
+#ifndef HOST_ESP32_ROM_CRC_H
+#define HOST_ESP32_ROM_CRC_H
+
+#include <stdint.h>
+
+uint32_t crc32_le(uint32_t crc, const uint8_t* buffer, uint32_t length);
+
+#endif // HOST_ESP32_ROM_CRC_H
@@ -0,0 +1,26 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief Consultas de heap do ESP-IDF, respondidas com o heap nominal do host.
+ */
+
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+// A glibc já aborta em corrupção detectada; as verificações sempre passam
+inline bool heap_caps_check_integrity_all(bool) { return true; }
+inline bool heap_caps_check_integrity_addr(intptr_t, bool) { return true; }
+
+inline void* heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+
+#endif // HOST_ESP_HEAP_CAPS_H
@@ -0,0 +1,20 @@
+/**
+ * @file esp_log.h
+ * @brief Níveis de log do ESP-IDF; no host não há logs do IDF para silenciar.
+ */
+
+#ifndef HOST_ESP_LOG_H
+#define HOST_ESP_LOG_H
+
+typedef enum {
+    ESP_LOG_NONE,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+inline void esp_log_level_set(const char*, esp_log_level_t) {}
+
+#endif // HOST_ESP_LOG_H
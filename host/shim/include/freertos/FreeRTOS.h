@@ -0,0 +1,62 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Tipos e seções críticas do FreeRTOS (SMP do ESP-IDF) sobre pthreads.
+ *
+ * Ticks valem 1 ms, como no core Arduino do ESP32 (CONFIG_FREERTOS_HZ=1000).
+ * portMUX_TYPE é um spinlock recursivo; no host ele não desliga interrupções
+ * nem o escalonador, só exclui as outras threads.
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+
+#define configTICK_RATE_HZ       1000
+#define configMAX_TASK_NAME_LEN  16
+#define configMAX_PRIORITIES     25
+#define portTICK_PERIOD_MS       (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY            ((TickType_t)0xffffffffUL)
+#define portNUM_PROCESSORS       2
+#define pdMS_TO_TICKS(ms)        ((TickType_t)(((TickType_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+/**
+ * Spinlock recursivo; agregado simples para aceitar o inicializador estático.
+ */
+typedef struct {
+    uint32_t owner;     ///< Identificador da thread dona (0 = livre)
+    uint32_t count;     ///< Profundidade de aninhamento
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+
+void vPortEnterCritical(portMUX_TYPE* mux);
+void vPortExitCritical(portMUX_TYPE* mux);
+
+#define portENTER_CRITICAL(mux)       vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)        vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)   vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)    vPortExitCritical(mux)
+#define portENTER_CRITICAL_SAFE(mux)  vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_SAFE(mux)   vPortExitCritical(mux)
+
+/**
+ * @brief Core da tarefa atual (o informado na criação; 0 para a thread principal).
+ */
+BaseType_t xPortGetCoreID();
+
+/**
+ * @brief No host não há interrupções.
+ */
+inline BaseType_t xPortInIsrContext() { return pdFALSE; }
+
+#endif // HOST_FREERTOS_H
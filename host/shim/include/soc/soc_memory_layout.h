@@ -0,0 +1,23 @@
+/**
+ * @file soc_memory_layout.h
+ * @brief Mapa de regiões de memória do SoC: vazio no host.
+ */
+
+#ifndef HOST_SOC_MEMORY_LAYOUT_H
+#define HOST_SOC_MEMORY_LAYOUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    intptr_t start;
+    size_t size;
+    size_t type;
+    intptr_t iram_address;
+    bool startup_stack;
+} soc_memory_region_t;
+
+extern const soc_memory_region_t soc_memory_regions[];
+extern const size_t soc_memory_region_count;
+
+#endif // HOST_SOC_MEMORY_LAYOUT_H
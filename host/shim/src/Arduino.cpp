@@ -0,0 +1,312 @@
+/**
+ * @file Arduino.cpp
+ * @brief Tempo, GPIO em memória, Serial e ESP do framework no host.
+ */
+
+#include "Arduino.h"
+#include "HostDevice.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp32/rom/crc.h"
+#include "soc/soc_memory_layout.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// Heap nominal informado ao firmware (o do processo não tem limite útil)
+static const uint32_t HOST_HEAP_SIZE = 320 * 1024;
+
+static const uint8_t PIN_COUNT = 40;
+
+struct PinState {
+    uint8_t mode;
+    uint8_t level;
+    uint16_t analog;
+    bool driven;    // Nível definido pelo host (HostDevice), não pelo pull-up
+};
+
+static PinState s_pins[PIN_COUNT] = {};
+static std::mutex s_pinMutex;
+
+static std::chrono::steady_clock::time_point epoch() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+// Relógio virtual: só avança por HostDevice::advanceClockTo() e pelas esperas
+static std::atomic<bool> s_virtualClock(false);
+static std::atomic<int64_t> s_virtualMicros(0);
+
+static void advanceVirtualClock(int64_t micros) {
+    s_virtualMicros.fetch_add(micros);
+}
+
+int64_t esp_timer_get_time() {
+    if (s_virtualClock.load(std::memory_order_relaxed)) {
+        return s_virtualMicros.load(std::memory_order_relaxed);
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - epoch()).count();
+}
+
+unsigned long millis() {
+    return static_cast<unsigned long>(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(esp_timer_get_time());
+}
+
+void delay(uint32_t ms) {
+    if (s_virtualClock) {
+        advanceVirtualClock(static_cast<int64_t>(ms) * 1000);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    if (s_virtualClock) {
+        advanceVirtualClock(us);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void HostDevice::useVirtualClock() {
+    s_virtualMicros = 0;
+    s_virtualClock = true;
+}
+
+bool HostDevice::isVirtualClock() {
+    return s_virtualClock;
+}
+
+void HostDevice::advanceClockTo(int64_t micros) {
+    // Nunca volta: um delay() dentro do evento anterior pode ter passado do prazo
+    int64_t current = s_virtualMicros.load();
+    while (micros > current && !s_virtualMicros.compare_exchange_weak(current, micros)) {
+    }
+}
+
+uint32_t getCpuFrequencyMhz() {
+    // CycleCounter::now() conta nanossegundos no host: 1000 "ciclos" por µs
+    return 1000;
+}
+
+bool setCpuFrequencyMhz(uint32_t) {
+    // A frequência do host não muda; getCpuFrequencyMhz() continua em 1000
+    return true;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin >= PIN_COUNT) return;
+    std::lock_guard<std::mutex> lock(s_pinMutex);
+    s_pins[pin].mode = mode;
+    if (mode == INPUT_PULLUP && !s_pins[pin].driven) {
+        s_pins[pin].level = HIGH;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin >= PIN_COUNT) return;
+    std::lock_guard<std::mutex> lock(s_pinMutex);
+    s_pins[pin].level = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    if (pin >= PIN_COUNT) return LOW;
+    std::lock_guard<std::mutex> lock(s_pinMutex);
+    return s_pins[pin].level;
+}
+
+uint16_t analogRead(uint8_t pin) {
+    if (pin >= PIN_COUNT) return 0;
+    std::lock_guard<std::mutex> lock(s_pinMutex);
+    return s_pins[pin].analog;
+}
+
+void HostDevice::setAnalog(uint8_t pin, uint16_t value) {
+    if (pin >= PIN_COUNT) return;
+    std::lock_guard<std::mutex> lock(s_pinMutex);
+    s_pins[pin].analog = value > 4095 ? 4095 : value;
+}
+
+void HostDevice::setDigitalInput(uint8_t pin, uint8_t level) {
+    if (pin >= PIN_COUNT) return;
+    std::lock_guard<std::mutex> lock(s_pinMutex);
+    s_pins[pin].level = level ? HIGH : LOW;
+    s_pins[pin].driven = true;
+}
+
+uint8_t HostDevice::getPinLevel(uint8_t pin) {
+    if (pin >= PIN_COUNT) return LOW;
+    std::lock_guard<std::mutex> lock(s_pinMutex);
+    return s_pins[pin].level;
+}
+
+std::string String::format(double value, unsigned int decimals) {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), value);
+    return buffer;
+}
+
+void String::trim() {
+    size_t begin = m_text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        m_text.clear();
+        return;
+    }
+    size_t end = m_text.find_last_not_of(" \t\r\n");
+    m_text = m_text.substr(begin, end - begin + 1);
+}
+
+void HardwareSerial::begin(unsigned long) {
+    // Saída sem buffer de linha, como a UART
+    setvbuf(stdout, nullptr, _IONBF, 0);
+}
+
+size_t HardwareSerial::setTxBufferSize(size_t size) {
+    return size;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t length) {
+    if (!m_muted) {
+        fwrite(data, 1, length, stdout);
+    }
+    return length;
+}
+
+int HardwareSerial::availableForWrite() {
+    // stdout não tem FIFO limitada; a escrita nunca precisa esperar
+    return 4096;
+}
+
+size_t HardwareSerial::printf(const char* fmt, ...) {
+    char buffer[512];
+    va_list args;
+    va_start(args, fmt);
+    int length = vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+
+    if (length <= 0) {
+        return 0;
+    }
+    size_t size = static_cast<size_t>(length) < sizeof(buffer) ? length : sizeof(buffer) - 1;
+    return write(reinterpret_cast<const uint8_t*>(buffer), size);
+}
+
+// Um byte lido por peek() e ainda não consumido por read()
+static int s_peeked = -1;
+
+int HardwareSerial::available() {
+    if (s_peeked >= 0) {
+        return 1;
+    }
+
+    struct pollfd input = {STDIN_FILENO, POLLIN, 0};
+    if (poll(&input, 1, 0) <= 0 || !(input.revents & POLLIN)) {
+        return 0;
+    }
+
+    unsigned char c;
+    if (::read(STDIN_FILENO, &c, 1) != 1) {
+        return 0;
+    }
+    s_peeked = c;
+    return 1;
+}
+
+int HardwareSerial::read() {
+    if (!available()) {
+        return -1;
+    }
+    int c = s_peeked;
+    s_peeked = -1;
+    return c;
+}
+
+int HardwareSerial::peek() {
+    return available() ? s_peeked : -1;
+}
+
+void EspClass::restart() {
+    esp_restart();
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return esp_get_free_heap_size();
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    return esp_get_minimum_free_heap_size();
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return HOST_HEAP_SIZE / 2;
+}
+
+uint32_t EspClass::getHeapSize() {
+    return HOST_HEAP_SIZE;
+}
+
+uint32_t EspClass::getCycleCount() {
+    return static_cast<uint32_t>(esp_timer_get_time() * getCpuFrequencyMhz());
+}
+
+size_t heap_caps_get_free_size(uint32_t) {
+    return HOST_HEAP_SIZE;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t) {
+    return HOST_HEAP_SIZE / 2;
+}
+
+// Sem regiões: o HeapIntegrityChecker só executa a verificação global
+const soc_memory_region_t soc_memory_regions[1] = {};
+const size_t soc_memory_region_count = 0;
+
+uint32_t esp_get_free_heap_size() {
+    return HOST_HEAP_SIZE;
+}
+
+uint32_t esp_get_minimum_free_heap_size() {
+    return HOST_HEAP_SIZE;
+}
+
+void esp_restart() {
+    fflush(stdout);
+    exit(0);
+}
+
+uint32_t crc32_le(uint32_t crc, const uint8_t* buffer, uint32_t length) {
+    static uint32_t table[256];
+    static std::once_flag built;
+    std::call_once(built, []() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++) {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+            }
+            table[i] = value;
+        }
+    });
+
+    crc = ~crc;
+    for (uint32_t i = 0; i < length; i++) {
+        crc = table[(crc ^ buffer[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
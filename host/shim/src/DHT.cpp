@@ -0,0 +1,38 @@
+/**
+ * @file DHT.cpp
+ * @brief DHT22 virtual alimentado por HostDevice::setDht().
+ */
+
+#include "DHT.h"
+#include "HostDevice.h"
+
+#include <mutex>
+
+static std::mutex s_dhtMutex;
+static float s_temperature = 25.0f;
+static float s_humidity = 50.0f;
+static bool s_failing = false;
+
+void HostDevice::setDht(float temperature, float humidity) {
+    std::lock_guard<std::mutex> lock(s_dhtMutex);
+    s_temperature = temperature;
+    s_humidity = humidity;
+}
+
+void HostDevice::setDhtFailure(bool failing) {
+    std::lock_guard<std::mutex> lock(s_dhtMutex);
+    s_failing = failing;
+}
+
+float DHT::readTemperature(bool fahrenheit, bool) {
+    std::lock_guard<std::mutex> lock(s_dhtMutex);
+    if (s_failing) {
+        return NAN;
+    }
+    return fahrenheit ? s_temperature * 1.8f + 32.0f : s_temperature;
+}
+
+float DHT::readHumidity(bool) {
+    std::lock_guard<std::mutex> lock(s_dhtMutex);
+    return s_failing ? NAN : s_humidity;
+}
@@ -0,0 +1,865 @@
+/**
+ * @file ESPAsyncWebServer.cpp
+ * @brief Servidor HTTP/WebSocket do host: poll() em uma tarefa de rede.
+ */
+
+#include "ESPAsyncWebServer.h"
+#include "HostDevice.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Maior cabeçalho HTTP aceito antes de recusar a requisição
+static const size_t MAX_REQUEST_HEADER = 8192;
+
+// Maior quadro WebSocket recebido
+static const size_t MAX_WS_FRAME = 64 * 1024;
+
+// Bytes pedidos ao filler por vez, próximo do MSS usado pelo AsyncTCP
+static const size_t FILL_CHUNK_SIZE = 1436;
+
+// Saída pendente a partir da qual o filler deixa de ser chamado
+static const size_t OUTPUT_HIGH_WATER = 8192;
+
+static uint16_t s_httpPortOverride = 0;
+
+// Protege listas e filas de clientes WebSocket, acessadas por outras tarefas
+static std::mutex s_lock;
+
+// Acorda o poll() quando outra tarefa enfileira mensagens
+static int s_wakePipe[2] = {-1, -1};
+
+struct AsyncHostConnection {
+    int fd;
+    AsyncClient client;
+    std::string input;
+    std::string output;
+    AsyncWebServerRequest* request;
+    AsyncWebSocketClient* websocket;
+    AsyncWebSocket* websocketServer;
+    size_t fillIndex;
+    bool filling;
+    bool retryFill;
+    bool closeAfterFlush;
+    bool broken;
+    uint8_t fragmentOpcode;
+    uint64_t fragmentIndex;
+
+    AsyncHostConnection(int socket, const IPAddress& ip, uint16_t port)
+        : fd(socket), client(ip, port), request(nullptr), websocket(nullptr), websocketServer(nullptr),
+          fillIndex(0), filling(false), retryFill(false), closeAfterFlush(false), broken(false),
+          fragmentOpcode(0), fragmentIndex(0) {}
+};
+
+void HostDevice::setHttpPort(uint16_t port) {
+    s_httpPortOverride = port;
+}
+
+static void wake() {
+    if (s_wakePipe[1] >= 0) {
+        char byte = 0;
+        ssize_t ignored = ::write(s_wakePipe[1], &byte, 1);
+        (void)ignored;
+    }
+}
+
+static const char* reasonPhrase(int code) {
+    switch (code) {
+        case 101: return "Switching Protocols";
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "";
+    }
+}
+
+static std::string lower(const char* text) {
+    std::string result(text);
+    for (char& c : result) {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+    return result;
+}
+
+static String urlDecode(const std::string& text) {
+    std::string result;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '+') {
+            result += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size() &&
+                   isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+                   isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+            result += static_cast<char>(strtol(text.substr(i + 1, 2).c_str(), nullptr, 16));
+            i += 2;
+        } else {
+            result += text[i];
+        }
+    }
+    return String(result);
+}
+
+// SHA-1 e base64 só para o Sec-WebSocket-Accept do handshake
+static void sha1(const uint8_t* data, size_t length, uint8_t digest[20]) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::string message(reinterpret_cast<const char*>(data), length);
+    message += static_cast<char>(0x80);
+    while (message.size() % 64 != 56) {
+        message += '\0';
+    }
+    uint64_t bits = static_cast<uint64_t>(length) * 8;
+    for (int i = 7; i >= 0; i--) {
+        message += static_cast<char>((bits >> (i * 8)) & 0xFF);
+    }
+
+    auto rotl = [](uint32_t value, int shift) { return (value << shift) | (value >> (32 - shift)); };
+    for (size_t block = 0; block < message.size(); block += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) {
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(message.data() + block + i * 4);
+            w[i] = (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+        }
+        for (int i = 16; i < 80; i++) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else { f = b ^ c ^ d; k = 0xCA62C1D6; }
+            uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d; d = c; c = rotl(b, 30); b = a; a = temp;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+    }
+
+    for (int i = 0; i < 5; i++) {
+        digest[i * 4] = h[i] >> 24;
+        digest[i * 4 + 1] = h[i] >> 16;
+        digest[i * 4 + 2] = h[i] >> 8;
+        digest[i * 4 + 3] = h[i];
+    }
+}
+
+static std::string base64(const uint8_t* data, size_t length) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t value = data[i] << 16;
+        if (i + 1 < length) value |= data[i + 1] << 8;
+        if (i + 2 < length) value |= data[i + 2];
+        result += alphabet[(value >> 18) & 0x3F];
+        result += alphabet[(value >> 12) & 0x3F];
+        result += i + 1 < length ? alphabet[(value >> 6) & 0x3F] : '=';
+        result += i + 2 < length ? alphabet[value & 0x3F] : '=';
+    }
+    return result;
+}
+
+static std::string buildFrame(uint8_t opcode, const char* payload, size_t length) {
+    std::string frame;
+    frame += static_cast<char>(0x80 | opcode);
+    if (length < 126) {
+        frame += static_cast<char>(length);
+    } else if (length <= 0xFFFF) {
+        frame += static_cast<char>(126);
+        frame += static_cast<char>((length >> 8) & 0xFF);
+        frame += static_cast<char>(length & 0xFF);
+    } else {
+        frame += static_cast<char>(127);
+        for (int i = 7; i >= 0; i--) {
+            frame += static_cast<char>((static_cast<uint64_t>(length) >> (i * 8)) & 0xFF);
+        }
+    }
+    frame.append(payload, length);
+    return frame;
+}
+
+void AsyncWebServerResponse::addHeader(const String& name, const String& value) {
+    m_headers += name.c_str();
+    m_headers += ": ";
+    m_headers += value.c_str();
+    m_headers += "\r\n";
+}
+
+AsyncWebServerRequest::~AsyncWebServerRequest() {
+    for (AsyncWebParameter* parameter : m_params) {
+        delete parameter;
+    }
+    delete m_response;
+}
+
+bool AsyncWebServerRequest::hasParam(const String& name, bool post, bool file) const {
+    return getParam(name, post, file) != nullptr;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam(const String& name, bool, bool) const {
+    for (AsyncWebParameter* parameter : m_params) {
+        if (parameter->name() == name) {
+            return parameter;
+        }
+    }
+    return nullptr;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam(size_t index) const {
+    return index < m_params.size() ? m_params[index] : nullptr;
+}
+
+bool AsyncWebServerRequest::hasHeader(const String& name) const {
+    std::string key = lower(name.c_str());
+    for (const auto& header : m_headers) {
+        if (key == header.first.c_str()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+String AsyncWebServerRequest::header(const String& name) const {
+    std::string key = lower(name.c_str());
+    for (const auto& header : m_headers) {
+        if (key == header.first.c_str()) {
+            return header.second;
+        }
+    }
+    return String();
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response) {
+    if (m_response) {
+        // Só a primeira resposta é enviada, como na biblioteca
+        delete response;
+        return;
+    }
+    m_response = response;
+}
+
+void AsyncWebServerRequest::send(int code, const String& contentType, const String& content) {
+    send(beginResponse(code, contentType, content));
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const String& contentType,
+                                                             const String& content) {
+    AsyncWebServerResponse* response = new AsyncWebServerResponse(code, contentType);
+    response->m_body.assign(content.c_str(), content.length());
+    return response;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse_P(int code, const String& contentType,
+                                                               const uint8_t* content, size_t length) {
+    // O corpo é copiado aqui; quem o forneceu só o libera no onDisconnect
+    AsyncWebServerResponse* response = new AsyncWebServerResponse(code, contentType);
+    response->m_body.assign(reinterpret_cast<const char*>(content), length);
+    return response;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse(const String& contentType,
+                                                                    AwsResponseFiller filler) {
+    AsyncWebServerResponse* response = new AsyncWebServerResponse(200, contentType);
+    response->m_filler = filler;
+    return response;
+}
+
+bool AsyncCallbackWebHandler::canHandle(AsyncWebServerRequest* request) {
+    if (!(m_method & request->method())) {
+        return false;
+    }
+    // Mesma regra da biblioteca: URI exata ou prefixo seguido de '/'
+    return request->url() == m_uri || request->url().startsWith(m_uri + "/");
+}
+
+void AsyncWebSocketClient::text(const char* message, size_t length) {
+    m_server->queueFrame(this, buildFrame(WS_TEXT, message, length));
+}
+
+void AsyncWebSocketClient::close(uint16_t code) {
+    char payload[2] = {static_cast<char>(code >> 8), static_cast<char>(code & 0xFF)};
+    std::string frame = buildFrame(WS_DISCONNECT, payload, sizeof(payload));
+    {
+        std::lock_guard<std::mutex> lock(s_lock);
+        if (m_status != WS_CONNECTED) {
+            return;
+        }
+        m_status = WS_DISCONNECTING;
+        m_queue.push_back(frame);
+    }
+    wake();
+}
+
+void AsyncWebSocket::queueFrame(AsyncWebSocketClient* client, const std::string& frame) {
+    {
+        std::lock_guard<std::mutex> lock(s_lock);
+        if (client->m_status != WS_CONNECTED || client->m_queue.size() >= WS_MAX_QUEUED_MESSAGES) {
+            // Fila cheia: a biblioteca também descarta a mensagem
+            return;
+        }
+        client->m_queue.push_back(frame);
+    }
+    wake();
+}
+
+void AsyncWebSocket::textAll(const char* message, size_t length) {
+    std::string frame = buildFrame(WS_TEXT, message, length);
+    {
+        std::lock_guard<std::mutex> lock(s_lock);
+        for (AsyncWebSocketClient* client : m_clients) {
+            if (client->m_status == WS_CONNECTED && client->m_queue.size() < WS_MAX_QUEUED_MESSAGES) {
+                client->m_queue.push_back(frame);
+            }
+        }
+    }
+    wake();
+}
+
+size_t AsyncWebSocket::count() const {
+    std::lock_guard<std::mutex> lock(s_lock);
+    size_t connected = 0;
+    for (const AsyncWebSocketClient* client : m_clients) {
+        connected += client->m_status == WS_CONNECTED ? 1 : 0;
+    }
+    return connected;
+}
+
+void AsyncWebSocket::cleanupClients(uint16_t maxClients) {
+    // Como na biblioteca: acima do limite, fecha o cliente mais antigo
+    AsyncWebSocketClient* oldest = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(s_lock);
+        size_t connected = 0;
+        for (AsyncWebSocketClient* client : m_clients) {
+            if (client->m_status == WS_CONNECTED) {
+                connected++;
+                oldest = oldest ? oldest : client;
+            }
+        }
+        if (connected <= maxClients) {
+            return;
+        }
+    }
+    oldest->close();
+}
+
+bool AsyncWebSocket::canHandle(AsyncWebServerRequest* request) {
+    return request->method() == HTTP_GET && request->url() == m_url &&
+           request->hasHeader("Sec-WebSocket-Key") &&
+           lower(request->header("Upgrade").c_str()) == "websocket";
+}
+
+void AsyncWebSocket::handleRequest(AsyncWebServerRequest* request) {
+    // O upgrade é concluído pelo servidor depois que o handler retorna
+    request->m_connection->websocketServer = this;
+}
+
+AsyncWebServer::~AsyncWebServer() {
+    for (AsyncCallbackWebHandler* handler : m_ownedHandlers) {
+        delete handler;
+    }
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction handler) {
+    AsyncCallbackWebHandler* callback = new AsyncCallbackWebHandler(uri, method, handler);
+    m_ownedHandlers.push_back(callback);
+    m_handlers.push_back(callback);
+    return *callback;
+}
+
+AsyncWebHandler& AsyncWebServer::addHandler(AsyncWebHandler* handler) {
+    m_handlers.push_back(handler);
+    return *handler;
+}
+
+void AsyncWebServer::begin() {
+    uint16_t port = s_httpPortOverride ? s_httpPortOverride : m_port;
+
+    m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int enable = 1;
+    setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(m_listenFd, 64) != 0) {
+        fprintf(stderr, "AsyncWebServer: não foi possível escutar na porta %u: %s\n", port, strerror(errno));
+        exit(1);
+    }
+    fcntl(m_listenFd, F_SETFL, O_NONBLOCK);
+
+    if (s_wakePipe[0] < 0 && pipe(s_wakePipe) == 0) {
+        fcntl(s_wakePipe[0], F_SETFL, O_NONBLOCK);
+        fcntl(s_wakePipe[1], F_SETFL, O_NONBLOCK);
+    }
+
+    fprintf(stderr, "AsyncWebServer: http://127.0.0.1:%u (ws://127.0.0.1:%u/ws)\n", port, port);
+    xTaskCreatePinnedToCore(taskFunc, "async_tcp", 8192, this, 3, nullptr, tskNO_AFFINITY);
+}
+
+void AsyncWebServer::taskFunc(void* parameter) {
+    static_cast<AsyncWebServer*>(parameter)->run();
+}
+
+void AsyncWebServer::run() {
+    std::vector<pollfd> descriptors;
+
+    while (true) {
+        bool retry = false;
+        descriptors.clear();
+        descriptors.push_back({m_listenFd, POLLIN, 0});
+        descriptors.push_back({s_wakePipe[0], POLLIN, 0});
+        {
+            std::lock_guard<std::mutex> lock(s_lock);
+            for (AsyncHostConnection* connection : m_connections) {
+                bool queued = connection->websocket && !connection->websocket->m_queue.empty();
+                short events = connection->closeAfterFlush ? 0 : POLLIN;
+                // Uma resposta chunked ainda gerando também espera por escrita
+                if (!connection->output.empty() || queued || connection->filling) {
+                    events |= POLLOUT;
+                }
+                descriptors.push_back({connection->fd, events, 0});
+                retry = retry || connection->retryFill;
+            }
+        }
+
+        // Um filler que pediu nova tentativa é chamado de novo em breve
+        poll(descriptors.data(), descriptors.size(), retry ? 5 : 100);
+
+        if (descriptors[1].revents & POLLIN) {
+            char drain[64];
+            while (::read(s_wakePipe[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        if (descriptors[0].revents & POLLIN) {
+            accept();
+        }
+
+        // process() pode fechar a conexão e removê-la da lista
+        std::vector<AsyncHostConnection*> connections = m_connections;
+        for (AsyncHostConnection* connection : connections) {
+            process(connection);
+        }
+    }
+}
+
+void AsyncWebServer::accept() {
+    while (true) {
+        sockaddr_in address = {};
+        socklen_t length = sizeof(address);
+        int fd = ::accept(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+        if (fd < 0) {
+            return;
+        }
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        uint32_t ip = ntohl(address.sin_addr.s_addr);
+        AsyncHostConnection* connection = new AsyncHostConnection(
+            fd, IPAddress(ip >> 24, ip >> 16, ip >> 8, ip), ntohs(address.sin_port));
+
+        std::lock_guard<std::mutex> lock(s_lock);
+        m_connections.push_back(connection);
+    }
+}
+
+void AsyncWebServer::process(AsyncHostConnection* connection) {
+    // Entrada
+    char buffer[4096];
+    while (!connection->closeAfterFlush) {
+        ssize_t received = recv(connection->fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection->input.append(buffer, received);
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            close(connection);
+            return;
+        }
+        break;
+    }
+
+    if (connection->websocket) {
+        processFrames(connection);
+        if (connection->broken) {
+            close(connection);
+            return;
+        }
+    } else if (!connection->request && !connection->closeAfterFlush) {
+        if (parseRequest(connection)) {
+            dispatch(connection);
+        }
+    }
+
+    if (connection->filling) {
+        pumpResponse(connection);
+    }
+
+    // Mensagens enfileiradas por outras tarefas
+    if (connection->websocket) {
+        std::lock_guard<std::mutex> lock(s_lock);
+        AsyncWebSocketClient* client = connection->websocket;
+        while (!client->m_queue.empty() && connection->output.size() < OUTPUT_HIGH_WATER) {
+            connection->output += client->m_queue.front();
+            client->m_queue.pop_front();
+        }
+        if (client->m_status == WS_DISCONNECTING && client->m_queue.empty()) {
+            connection->closeAfterFlush = true;
+        }
+    }
+
+    // Saída
+    while (!connection->output.empty()) {
+        ssize_t sent = send(connection->fd, connection->output.data(), connection->output.size(), MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection->output.erase(0, sent);
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        close(connection);
+        return;
+    }
+
+    if (connection->closeAfterFlush && connection->output.empty() && !connection->filling) {
+        close(connection);
+    }
+}
+
+bool AsyncWebServer::parseRequest(AsyncHostConnection* connection) {
+    size_t end = connection->input.find("\r\n\r\n");
+    if (end == std::string::npos) {
+        if (connection->input.size() > MAX_REQUEST_HEADER) {
+            connection->output = "HTTP/1.1 431 Request Header Fields Too Large\r\nConnection: close\r\n\r\n";
+            connection->closeAfterFlush = true;
+        }
+        return false;
+    }
+
+    std::string head = connection->input.substr(0, end);
+    connection->input.erase(0, end + 4);
+
+    AsyncWebServerRequest* request = new AsyncWebServerRequest(connection, &connection->client);
+    connection->request = request;
+
+    size_t lineEnd = head.find("\r\n");
+    std::string requestLine = head.substr(0, lineEnd);
+    char method[16] = {0};
+    char target[2048] = {0};
+    if (sscanf(requestLine.c_str(), "%15s %2047s", method, target) != 2) {
+        connection->output = "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n";
+        connection->closeAfterFlush = true;
+        return false;
+    }
+
+    static const struct { const char* name; WebRequestMethod method; } methods[] = {
+        {"GET", HTTP_GET}, {"POST", HTTP_POST}, {"DELETE", HTTP_DELETE}, {"PUT", HTTP_PUT},
+        {"PATCH", HTTP_PATCH}, {"HEAD", HTTP_HEAD}, {"OPTIONS", HTTP_OPTIONS},
+    };
+    for (const auto& entry : methods) {
+        if (strcmp(method, entry.name) == 0) {
+            request->m_method = entry.method;
+        }
+    }
+
+    std::string path = target;
+    size_t query = path.find('?');
+    if (query != std::string::npos) {
+        std::string parameters = path.substr(query + 1);
+        path.erase(query);
+        size_t start = 0;
+        while (start <= parameters.size()) {
+            size_t next = parameters.find('&', start);
+            std::string pair = parameters.substr(start, next == std::string::npos ? std::string::npos : next - start);
+            if (!pair.empty()) {
+                size_t equals = pair.find('=');
+                request->m_params.push_back(new AsyncWebParameter(
+                    urlDecode(pair.substr(0, equals)),
+                    equals == std::string::npos ? String() : urlDecode(pair.substr(equals + 1))));
+            }
+            if (next == std::string::npos) break;
+            start = next + 1;
+        }
+    }
+    request->m_url = urlDecode(path);
+
+    size_t position = lineEnd;
+    while (position != std::string::npos && position < head.size()) {
+        size_t next = head.find("\r\n", position + 2);
+        std::string line = head.substr(position + 2, next == std::string::npos ? std::string::npos : next - position - 2);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            size_t valueStart = line.find_first_not_of(' ', colon + 1);
+            request->m_headers.push_back({String(lower(line.substr(0, colon).c_str())),
+                                          String(valueStart == std::string::npos ? "" : line.substr(valueStart))});
+        }
+        position = next;
+    }
+    return true;
+}
+
+void AsyncWebServer::dispatch(AsyncHostConnection* connection) {
+    AsyncWebServerRequest* request = connection->request;
+
+    AsyncWebHandler* selected = nullptr;
+    for (AsyncWebHandler* handler : m_handlers) {
+        if (handler->canHandle(request)) {
+            selected = handler;
+            break;
+        }
+    }
+
+    if (selected) {
+        selected->handleRequest(request);
+    } else if (m_notFound) {
+        m_notFound(request);
+    } else {
+        request->send(404);
+    }
+
+    if (connection->websocketServer) {
+        startWebSocket(connection, connection->websocketServer);
+        return;
+    }
+
+    AsyncWebServerResponse* response = request->m_response;
+    if (!response) {
+        // O firmware sempre responde dentro do handler
+        request->send(500, "text/plain", "Sem resposta");
+        response = request->m_response;
+    }
+
+    char head[256];
+    snprintf(head, sizeof(head), "HTTP/1.1 %d %s\r\n", response->m_code, reasonPhrase(response->m_code));
+    connection->output += head;
+    if (response->m_contentType.length() > 0) {
+        connection->output += "Content-Type: ";
+        connection->output += response->m_contentType.c_str();
+        connection->output += "\r\n";
+    }
+    if (response->m_filler) {
+        connection->output += "Transfer-Encoding: chunked\r\n";
+        connection->filling = true;
+    } else {
+        snprintf(head, sizeof(head), "Content-Length: %zu\r\n", response->m_body.size());
+        connection->output += head;
+    }
+    connection->output += response->m_headers;
+    connection->output += "Connection: close\r\n\r\n";
+
+    if (!response->m_filler && request->m_method != HTTP_HEAD) {
+        connection->output += response->m_body;
+    }
+    connection->closeAfterFlush = true;
+}
+
+void AsyncWebServer::pumpResponse(AsyncHostConnection* connection) {
+    AsyncWebServerResponse* response = connection->request->m_response;
+    uint8_t buffer[FILL_CHUNK_SIZE];
+    connection->retryFill = false;
+
+    while (connection->output.size() < OUTPUT_HIGH_WATER) {
+        size_t length = response->m_filler(buffer, sizeof(buffer), connection->fillIndex);
+        if (length == RESPONSE_TRY_AGAIN) {
+            connection->retryFill = true;
+            return;
+        }
+        if (length == 0) {
+            connection->output += "0\r\n\r\n";
+            connection->filling = false;
+            return;
+        }
+
+        // Dois dígitos hexadecimais por byte de size_t, CRLF e o terminador
+        char size[sizeof(size_t) * 2 + 3];
+        snprintf(size, sizeof(size), "%zx\r\n", length);
+        connection->output += size;
+        connection->output.append(reinterpret_cast<char*>(buffer), length);
+        connection->output += "\r\n";
+        connection->fillIndex += length;
+    }
+}
+
+void AsyncWebServer::startWebSocket(AsyncHostConnection* connection, AsyncWebSocket* websocket) {
+    AsyncWebServerRequest* request = connection->request;
+
+    std::string key = std::string(request->header("Sec-WebSocket-Key").c_str()) +
+                      "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    uint8_t digest[20];
+    sha1(reinterpret_cast<const uint8_t*>(key.data()), key.size(), digest);
+
+    connection->output += "HTTP/1.1 101 Switching Protocols\r\n"
+                          "Upgrade: websocket\r\n"
+                          "Connection: Upgrade\r\n"
+                          "Sec-WebSocket-Accept: ";
+    connection->output += base64(digest, sizeof(digest));
+    connection->output += "\r\n\r\n";
+
+    // A requisição do upgrade não é mais necessária
+    connection->request = nullptr;
+    delete request;
+
+    AsyncWebSocketClient* client;
+    {
+        std::lock_guard<std::mutex> lock(s_lock);
+        client = new AsyncWebSocketClient(websocket, connection, &connection->client, websocket->m_nextId++);
+        websocket->m_clients.push_back(client);
+        connection->websocket = client;
+    }
+
+    if (websocket->m_eventHandler) {
+        websocket->m_eventHandler(websocket, client, WS_EVT_CONNECT, nullptr, nullptr, 0);
+    }
+}
+
+void AsyncWebServer::processFrames(AsyncHostConnection* connection) {
+    AsyncWebSocketClient* client = connection->websocket;
+    AsyncWebSocket* websocket = client->m_server;
+    std::string& input = connection->input;
+
+    while (input.size() >= 2 && !connection->closeAfterFlush) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(input.data());
+        bool final = bytes[0] & 0x80;
+        uint8_t opcode = bytes[0] & 0x0F;
+        bool masked = bytes[1] & 0x80;
+        uint64_t length = bytes[1] & 0x7F;
+        size_t header = 2;
+
+        if (length == 126) {
+            if (input.size() < 4) return;
+            length = (bytes[2] << 8) | bytes[3];
+            header = 4;
+        } else if (length == 127) {
+            if (input.size() < 10) return;
+            length = 0;
+            for (int i = 0; i < 8; i++) {
+                length = (length << 8) | bytes[2 + i];
+            }
+            header = 10;
+        }
+        if (length > MAX_WS_FRAME) {
+            connection->broken = true;
+            return;
+        }
+
+        uint8_t mask[4] = {0, 0, 0, 0};
+        if (masked) {
+            if (input.size() < header + 4) return;
+            memcpy(mask, bytes + header, 4);
+            header += 4;
+        }
+        if (input.size() < header + length) return;
+
+        // Um byte extra: mensagens de texto chegam terminadas em '\0'
+        std::string payload = input.substr(header, length);
+        input.erase(0, header + length);
+        for (size_t i = 0; i < payload.size(); i++) {
+            payload[i] ^= mask[i & 3];
+        }
+        payload.push_back('\0');
+
+        AwsFrameInfo info = {};
+        info.final = final;
+        info.masked = masked;
+        info.opcode = opcode;
+        info.len = length;
+        memcpy(info.mask, mask, sizeof(mask));
+        uint8_t* data = reinterpret_cast<uint8_t*>(&payload[0]);
+
+        switch (opcode) {
+            case WS_TEXT:
+            case WS_BINARY:
+            case WS_CONTINUATION:
+                if (opcode != WS_CONTINUATION) {
+                    connection->fragmentOpcode = opcode;
+                    connection->fragmentIndex = 0;
+                }
+                info.message_opcode = connection->fragmentOpcode;
+                info.index = connection->fragmentIndex;
+                if (!final || info.index > 0) {
+                    // Fragmentos: len é o tamanho acumulado conhecido até aqui
+                    info.len = info.index + length;
+                }
+                connection->fragmentIndex += length;
+                if (websocket->m_eventHandler) {
+                    websocket->m_eventHandler(websocket, client, WS_EVT_DATA, &info, data, length);
+                }
+                break;
+
+            case WS_PING:
+                connection->output += buildFrame(WS_PONG, payload.data(), length);
+                if (websocket->m_eventHandler) {
+                    websocket->m_eventHandler(websocket, client, WS_EVT_PING, nullptr, data, length);
+                }
+                break;
+
+            case WS_PONG:
+                if (websocket->m_eventHandler) {
+                    websocket->m_eventHandler(websocket, client, WS_EVT_PONG, nullptr, data, length);
+                }
+                break;
+
+            case WS_DISCONNECT:
+                connection->output += buildFrame(WS_DISCONNECT, payload.data(), length >= 2 ? 2 : 0);
+                {
+                    std::lock_guard<std::mutex> lock(s_lock);
+                    client->m_status = WS_DISCONNECTING;
+                    client->m_queue.clear();
+                }
+                connection->closeAfterFlush = true;
+                break;
+
+            default:
+                connection->broken = true;
+                return;
+        }
+    }
+}
+
+void AsyncWebServer::close(AsyncHostConnection* connection) {
+    AsyncWebSocketClient* client = connection->websocket;
+    {
+        std::lock_guard<std::mutex> lock(s_lock);
+        m_connections.erase(std::remove(m_connections.begin(), m_connections.end(), connection),
+                            m_connections.end());
+        if (client) {
+            std::vector<AsyncWebSocketClient*>& clients = client->m_server->m_clients;
+            clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+            client->m_status = WS_DISCONNECTED;
+        }
+    }
+    ::close(connection->fd);
+
+    if (client) {
+        AsyncWebSocket* websocket = client->m_server;
+        if (websocket->m_eventHandler) {
+            websocket->m_eventHandler(websocket, client, WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+        }
+        delete client;
+    }
+
+    if (connection->request) {
+        if (connection->request->m_onDisconnect) {
+            connection->request->m_onDisconnect();
+        }
+        delete connection->request;
+    }
+    delete connection;
+}
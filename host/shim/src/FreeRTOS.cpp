@@ -0,0 +1,291 @@
+/**
+ * @file FreeRTOS.cpp
+ * @brief Tarefas, semáforos, notificações e seções críticas sobre pthreads.
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "Arduino.h"
+#include "HostDevice.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <string.h>
+
+struct HostTask {
+    char name[configMAX_TASK_NAME_LEN];
+    BaseType_t core;
+    uint32_t stackDepth;
+    TaskFunction_t function;
+    void* parameter;
+
+    std::mutex notifyMutex;
+    std::condition_variable notifyCondition;
+    uint32_t notifyCount;
+};
+
+struct QueueDefinition {
+    std::mutex mutex;
+    std::condition_variable condition;
+    UBaseType_t count;
+    UBaseType_t maxCount;
+    bool isMutex;
+    TaskHandle_t holder;
+};
+
+// Lançada por vTaskDelete(nullptr) e capturada na base da thread
+struct TaskExit {};
+
+static thread_local HostTask* t_currentTask = nullptr;
+static std::atomic<UBaseType_t> s_taskCount{1};
+
+// Inicializado durante a carga, ainda na thread principal
+static const std::thread::id s_mainThread = std::this_thread::get_id();
+
+static HostTask* newTask(const char* name, BaseType_t core, uint32_t stackDepth) {
+    HostTask* task = new HostTask();
+    strncpy(task->name, name ? name : "", sizeof(task->name) - 1);
+    task->name[sizeof(task->name) - 1] = '\0';
+    task->core = core;
+    task->stackDepth = stackDepth;
+    task->function = nullptr;
+    task->parameter = nullptr;
+    task->notifyCount = 0;
+    return task;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    if (!t_currentTask) {
+        // Threads que não foram criadas como tarefas recebem uma na primeira consulta
+        bool isMain = std::this_thread::get_id() == s_mainThread;
+        t_currentTask = newTask(isMain ? "loopTask" : "host", isMain ? 1 : 0, 0);
+        if (!isMain) {
+            s_taskCount++;
+        }
+    }
+    return t_currentTask;
+}
+
+char* pcTaskGetName(TaskHandle_t task) {
+    return (task ? task : xTaskGetCurrentTaskHandle())->name;
+}
+
+BaseType_t xPortGetCoreID() {
+    BaseType_t core = xTaskGetCurrentTaskHandle()->core;
+    return core == tskNO_AFFINITY ? 0 : core;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                                   void* parameter, UBaseType_t, TaskHandle_t* created,
+                                   BaseType_t core) {
+    HostTask* task = newTask(name, core, stackDepth);
+    task->function = function;
+    task->parameter = parameter;
+
+    std::thread([task]() {
+        t_currentTask = task;
+        try {
+            task->function(task->parameter);
+        } catch (const TaskExit&) {
+        }
+        s_taskCount--;
+    }).detach();
+
+    s_taskCount++;
+    if (created) {
+        *created = task;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                       void* parameter, UBaseType_t priority, TaskHandle_t* created) {
+    return xTaskCreatePinnedToCore(function, name, stackDepth, parameter, priority, created,
+                                   tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    // Só a própria tarefa pode encerrar sua thread; o HostTask é mantido
+    // porque outras tarefas podem ainda ter o handle
+    if (task == nullptr || task == xTaskGetCurrentTaskHandle()) {
+        throw TaskExit();
+    }
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(esp_timer_get_time() / (1000 * portTICK_PERIOD_MS));
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (HostDevice::isVirtualClock()) {
+        delay(ticks * portTICK_PERIOD_MS);
+        return;
+    }
+    if (ticks == 0) {
+        std::this_thread::yield();
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period) {
+    *previousWake += period;
+
+    // Como no FreeRTOS, um prazo já vencido retorna imediatamente
+    TickType_t remaining = *previousWake - xTaskGetTickCount();
+    if (remaining != 0 && remaining <= period) {
+        vTaskDelay(remaining);
+    }
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    // Pilhas do host não são medidas; informa o tamanho pedido
+    return (task ? task : xTaskGetCurrentTaskHandle())->stackDepth;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks() {
+    return s_taskCount;
+}
+
+void xTaskNotifyGive(TaskHandle_t task) {
+    if (!task) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(task->notifyMutex);
+        task->notifyCount++;
+    }
+    task->notifyCondition.notify_one();
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    HostTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->notifyMutex);
+
+    auto pending = [task]() { return task->notifyCount > 0; };
+    if (ticks == portMAX_DELAY) {
+        task->notifyCondition.wait(lock, pending);
+    } else {
+        task->notifyCondition.wait_for(lock, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), pending);
+    }
+
+    uint32_t value = task->notifyCount;
+    if (value > 0) {
+        task->notifyCount = clearOnExit ? 0 : value - 1;
+    }
+    return value;
+}
+
+static uint32_t threadToken() {
+    static std::atomic<uint32_t> next{1};
+    static thread_local uint32_t token = next++;
+    return token;
+}
+
+void vPortEnterCritical(portMUX_TYPE* mux) {
+    uint32_t self = threadToken();
+    if (__atomic_load_n(&mux->owner, __ATOMIC_ACQUIRE) == self) {
+        mux->count++;
+        return;
+    }
+
+    uint32_t expected = 0;
+    while (!__atomic_compare_exchange_n(&mux->owner, &expected, self, false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        expected = 0;
+        std::this_thread::yield();
+    }
+    mux->count = 1;
+}
+
+void vPortExitCritical(portMUX_TYPE* mux) {
+    if (--mux->count == 0) {
+        __atomic_store_n(&mux->owner, 0, __ATOMIC_RELEASE);
+    }
+}
+
+static SemaphoreHandle_t newSemaphore(UBaseType_t maxCount, UBaseType_t initialCount, bool isMutex) {
+    QueueDefinition* semaphore = new QueueDefinition();
+    semaphore->count = initialCount;
+    semaphore->maxCount = maxCount;
+    semaphore->isMutex = isMutex;
+    semaphore->holder = nullptr;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return newSemaphore(1, 1, true);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return newSemaphore(1, 0, false);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    return newSemaphore(maxCount, initialCount, false);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    if (!semaphore) {
+        return pdFALSE;
+    }
+
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    auto available = [semaphore]() { return semaphore->count > 0; };
+    if (ticks == portMAX_DELAY) {
+        semaphore->condition.wait(lock, available);
+    } else if (!semaphore->condition.wait_for(lock, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS),
+                                              available)) {
+        return pdFALSE;
+    }
+
+    semaphore->count--;
+    if (semaphore->isMutex) {
+        semaphore->holder = xTaskGetCurrentTaskHandle();
+    }
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return pdFALSE;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(semaphore->mutex);
+        if (semaphore->isMutex && semaphore->holder != xTaskGetCurrentTaskHandle()) {
+            return pdFALSE;
+        }
+        if (semaphore->count >= semaphore->maxCount) {
+            return pdFALSE;
+        }
+        semaphore->count++;
+        semaphore->holder = nullptr;
+    }
+    semaphore->condition.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken) {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+    return xSemaphoreGive(semaphore);
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    return semaphore->holder;
+}
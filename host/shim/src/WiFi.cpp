@@ -0,0 +1,179 @@
+/**
+ * @file WiFi.cpp
+ * @brief Estação WiFi virtual: estado da conexão e tarefa de eventos.
+ */
+
+#include "WiFi.h"
+#include "HostDevice.h"
+
+#include <mutex>
+#include <vector>
+
+WiFiClass WiFi;
+
+// Tempo entre WiFi.begin() e o GOT_IP com o enlace ativo
+static const uint32_t CONNECT_DELAY_MS = 300;
+
+// Motivos de desconexão do ESP-IDF usados nos eventos
+static const uint8_t REASON_BEACON_TIMEOUT = 200;
+static const uint8_t REASON_ASSOC_LEAVE = 8;
+
+struct EventHandler {
+    WiFiEventFuncCb callback;
+    arduino_event_id_t event;
+};
+
+static std::mutex s_wifiMutex;
+static std::vector<EventHandler> s_handlers;
+static bool s_linkUp = true;
+static int8_t s_rssi = -55;
+static wl_status_t s_status = WL_IDLE_STATUS;
+static bool s_connecting = false;
+static uint32_t s_connectAt = 0;
+static TaskHandle_t s_eventTask = nullptr;
+static uint32_t s_attempts = 0;
+
+static void dispatch(arduino_event_id_t event, uint8_t reason) {
+    arduino_event_info_t info = {};
+    info.wifi_sta_disconnected.reason = reason;
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        info.got_ip.ip[0] = 127;
+        info.got_ip.ip[3] = 1;
+    }
+
+    // Cópia: um handler pode registrar outro durante o despacho
+    std::vector<EventHandler> handlers;
+    {
+        std::lock_guard<std::mutex> lock(s_wifiMutex);
+        handlers = s_handlers;
+    }
+    for (const EventHandler& handler : handlers) {
+        if (handler.event == ARDUINO_EVENT_MAX || handler.event == event) {
+            handler.callback(event, info);
+        }
+    }
+}
+
+static void processEvents() {
+    arduino_event_id_t pending = ARDUINO_EVENT_MAX;
+    {
+        std::lock_guard<std::mutex> lock(s_wifiMutex);
+        if (s_status == WL_CONNECTED && !s_linkUp) {
+            s_status = WL_CONNECTION_LOST;
+            pending = ARDUINO_EVENT_WIFI_STA_DISCONNECTED;
+        } else if (s_connecting && s_linkUp && s_status != WL_CONNECTED &&
+                   static_cast<int32_t>(millis() - s_connectAt) >= 0) {
+            s_connecting = false;
+            s_status = WL_CONNECTED;
+            pending = ARDUINO_EVENT_WIFI_STA_GOT_IP;
+        }
+    }
+
+    if (pending == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        dispatch(ARDUINO_EVENT_WIFI_STA_CONNECTED, 0);
+        dispatch(ARDUINO_EVENT_WIFI_STA_GOT_IP, 0);
+    } else if (pending == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, REASON_BEACON_TIMEOUT);
+    }
+}
+
+static void eventTaskFunc(void*) {
+    while (true) {
+        processEvents();
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+static void startConnecting() {
+    // Chamado com s_wifiMutex travado
+    s_attempts++;
+    s_connecting = true;
+    s_connectAt = millis() + CONNECT_DELAY_MS;
+    if (s_status != WL_CONNECTED) {
+        s_status = WL_DISCONNECTED;
+    }
+    // Com o relógio virtual, quem chama HostDevice::pollWiFi() faz o papel da tarefa
+    if (!s_eventTask && !HostDevice::isVirtualClock()) {
+        xTaskCreatePinnedToCore(eventTaskFunc, "arduino_events", 4096, nullptr, 19, &s_eventTask, 1);
+    }
+}
+
+wl_status_t WiFiClass::begin(const char*, const char*, int32_t) {
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    startConnecting();
+    return s_status;
+}
+
+bool WiFiClass::reconnect() {
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    startConnecting();
+    return true;
+}
+
+bool WiFiClass::disconnect(bool, bool) {
+    bool wasConnected;
+    {
+        std::lock_guard<std::mutex> lock(s_wifiMutex);
+        wasConnected = s_status == WL_CONNECTED;
+        s_connecting = false;
+        s_status = WL_DISCONNECTED;
+    }
+    if (wasConnected) {
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED, REASON_ASSOC_LEAVE);
+    }
+    return true;
+}
+
+bool WiFiClass::mode(wifi_mode_t) {
+    return true;
+}
+
+wl_status_t WiFiClass::status() {
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    return s_status;
+}
+
+IPAddress WiFiClass::localIP() {
+    // O servidor escuta no loopback do host
+    return status() == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+int8_t WiFiClass::RSSI() {
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    return s_status == WL_CONNECTED ? s_rssi : 0;
+}
+
+int32_t WiFiClass::channel() {
+    return 6;
+}
+
+wifi_event_id_t WiFiClass::onEvent(WiFiEventFuncCb callback, arduino_event_id_t event) {
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    s_handlers.push_back({callback, event});
+    return static_cast<wifi_event_id_t>(s_handlers.size());
+}
+
+void HostDevice::setWiFiLink(bool up) {
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    s_linkUp = up;
+}
+
+void HostDevice::setWiFiRssi(int8_t rssi) {
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    s_rssi = rssi;
+}
+
+uint32_t HostDevice::getWiFiAttempts() {
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    return s_attempts;
+}
+
+bool HostDevice::pollWiFi(uint32_t& nextDeadline) {
+    processEvents();
+
+    std::lock_guard<std::mutex> lock(s_wifiMutex);
+    bool pending = (s_status == WL_CONNECTED && !s_linkUp) ||
+                   (s_connecting && s_linkUp && s_status != WL_CONNECTED);
+    nextDeadline = (s_status == WL_CONNECTED) ? millis() : s_connectAt;
+    return pending;
+}
@@ -0,0 +1,397 @@
+/**
+ * @file IrrigationSim.cpp
+ * @brief Simulação de eventos discretos do IrrigationController e do WiFiManager.
+ *
+ * Os dois módulos rodam sem alterações sobre o relógio virtual do shim. Em vez
+ * de dormir, o laço salta direto para o próximo prazo: ciclo da tarefa de
+ * sensores, verificação do WiFi da tarefa web, transição da estação WiFi ou
+ * queda/retorno do enlace. Dias de operação rodam em segundos e, para a mesma
+ * semente, sempre com o mesmo resultado.
+ *
+ * Uso:
+ *   irrigation_sim [--days 7] [--dry 1.5] [--wet 10] [--outage-every-h 6]
+ *                  [--outage-min 10] [--seed 1] [--min-duty 0.1] [--max-duty 10]
+ *                  [--verbose]
+ *
+ * Termina com código 1 se alguma verificação falhar.
+ */
+
+#include <Arduino.h>
+#include "Config.h"
+#include "ConsoleWriter.h"
+#include "DataTypes.h"
+#include "Hardware.h"
+#include "HostDevice.h"
+#include "IrrigationController.h"
+#include "WiFiManager.h"
+
+#include <esp_timer.h>
+#include <chrono>
+#include <vector>
+
+// Definidos em src/WifiPerformance.cpp, que não faz parte da simulação
+volatile bool g_wifiEarlyInitDone = false;
+volatile bool g_wifiEarlyInitSuccess = false;
+
+namespace {
+
+const uint64_t MS_PER_HOUR = 3600000ULL;
+const uint64_t MS_PER_DAY = 24 * MS_PER_HOUR;
+
+// Atrasos iniciais das tarefas em src/Main.cpp
+const uint32_t SENSOR_TASK_START_MS = 200;
+const uint32_t WEB_TASK_START_MS = 500;
+
+// Maior intervalo do backoff de WiFiManager::update()
+const uint32_t WIFI_MAX_BACKOFF_MS = WIFI_RECONNECT_INTERVAL << 8;
+
+struct Options {
+    double days = 7.0;
+    float dryRate = 1.5f;        // %/h com a bomba desligada (média do dia)
+    float wetRate = 10.0f;       // %/min com a bomba ligada
+    float outageEveryHours = 6.0f;
+    float outageMinutes = 10.0f; // 0 = sem quedas
+    uint32_t seed = 1;
+    float minDuty = 0.1f;        // %
+    float maxDuty = 10.0f;       // %
+    bool verbose = false;
+};
+
+struct Run {
+    uint64_t start;
+    uint64_t end;
+};
+
+struct Outage {
+    uint64_t start;
+    uint64_t end;
+    uint64_t reconnectedAt;      // 0 = não reconectou
+};
+
+/**
+ * Gerador congruencial: as quedas dependem só da semente.
+ */
+class Random {
+public:
+    explicit Random(uint32_t seed) : m_state(seed ? seed : 1) {}
+
+    // Valor uniforme em [low, high)
+    double uniform(double low, double high) {
+        m_state = m_state * 1664525u + 1013904223u;
+        return low + (high - low) * (m_state >> 8) / 16777216.0;
+    }
+
+private:
+    uint32_t m_state;
+};
+
+/**
+ * Umidade do solo: seca mais rápido à tarde e sobe enquanto a bomba rega.
+ */
+class SoilModel {
+public:
+    SoilModel(float dryRate, float wetRate) : m_dryRate(dryRate), m_wetRate(wetRate),
+                                              m_humidity(45.0f), m_lastMs(0) {}
+
+    float advance(uint64_t nowMs, bool pumpOn) {
+        float elapsedMin = (nowMs - m_lastMs) / 60000.0f;
+        m_lastMs = nowMs;
+
+        if (pumpOn) {
+            m_humidity += m_wetRate * elapsedMin;
+        } else {
+            float dayPhase = static_cast<float>(nowMs % MS_PER_DAY) / MS_PER_DAY;
+            float evaporation = 1.0f + 0.6f * sinf(2.0f * static_cast<float>(PI) * (dayPhase - 0.25f));
+            m_humidity -= m_dryRate * evaporation * elapsedMin / 60.0f;
+        }
+        m_humidity = constrain(m_humidity, 0.0f, 100.0f);
+        return m_humidity;
+    }
+
+private:
+    float m_dryRate;
+    float m_wetRate;
+    float m_humidity;
+    uint64_t m_lastMs;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--verbose") == 0) {
+            options.verbose = true;
+            continue;
+        }
+        if (!value) {
+            fprintf(stderr, "Argumento inválido ou sem valor: %s\n", arg);
+            return false;
+        }
+
+        if (strcmp(arg, "--days") == 0) {
+            options.days = atof(value);
+        } else if (strcmp(arg, "--dry") == 0) {
+            options.dryRate = static_cast<float>(atof(value));
+        } else if (strcmp(arg, "--wet") == 0) {
+            options.wetRate = static_cast<float>(atof(value));
+        } else if (strcmp(arg, "--outage-every-h") == 0) {
+            options.outageEveryHours = static_cast<float>(atof(value));
+        } else if (strcmp(arg, "--outage-min") == 0) {
+            options.outageMinutes = static_cast<float>(atof(value));
+        } else if (strcmp(arg, "--seed") == 0) {
+            options.seed = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--min-duty") == 0) {
+            options.minDuty = static_cast<float>(atof(value));
+        } else if (strcmp(arg, "--max-duty") == 0) {
+            options.maxDuty = static_cast<float>(atof(value));
+        } else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+
+    if (options.days <= 0.0 || options.outageEveryHours <= 0.0f || options.outageMinutes < 0.0f) {
+        fprintf(stderr, "Valores inválidos para --days/--outage-every-h/--outage-min\n");
+        return false;
+    }
+    return true;
+}
+
+int g_failures = 0;
+
+void check(bool ok, const char* description, const char* detail) {
+    printf("  [%s] %s (%s)\n", ok ? " OK " : "FALHA", description, detail);
+    if (!ok) {
+        g_failures++;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    HostDevice::useVirtualClock();
+    Serial.setMuted(!options.verbose);
+    ConsoleWriter::begin(SERIAL_BAUD_RATE);
+
+    // Mesma ordem do setup(): pinos, WiFi e controlador
+    Hardware::setupPins();
+    WiFiManager& wifi = WiFiManager::getInstance();
+    wifi.connect(WIFI_SSID, WIFI_PASSWORD);
+    IrrigationController& irrigation = IrrigationController::getInstance();
+    if (!irrigation.init()) {
+        fprintf(stderr, "Falha ao inicializar o IrrigationController\n");
+        return 1;
+    }
+
+    const uint64_t endMs = static_cast<uint64_t>(options.days * MS_PER_DAY);
+    SoilModel soil(options.dryRate, options.wetRate);
+    Random random(options.seed);
+
+    // Próximos prazos de cada fonte de eventos
+    uint64_t nextSensorMs = SENSOR_TASK_START_MS;
+    uint64_t nextWiFiCheckMs = WEB_TASK_START_MS;
+    uint64_t lastReadMs = 0;
+    bool outageActive = false;
+    uint64_t nextOutageMs = options.outageMinutes > 0.0f
+        ? static_cast<uint64_t>(random.uniform(0.5, 1.5) * options.outageEveryHours * MS_PER_HOUR)
+        : UINT64_MAX;
+
+    // Medições
+    std::vector<Run> runs;
+    std::vector<Outage> outages;
+    std::vector<uint64_t> attemptTimes;
+    bool relayOn = false;
+    uint64_t disconnectedMs = 0;
+    uint8_t lastDailyActivations = 0;
+    uint32_t staleDailyCounts = 0;
+    uint8_t maxDailyActivations = 0;
+    uint32_t lastAttempts = HostDevice::getWiFiAttempts();
+    uint64_t events = 0;
+
+    auto started = std::chrono::steady_clock::now();
+    uint64_t nowMs = 0;
+
+    while (nowMs < endMs) {
+        // Próximo prazo entre todas as fontes
+        uint32_t stationDeadline;
+        uint64_t nextMs = std::min(nextSensorMs, nextWiFiCheckMs);
+        nextMs = std::min(nextMs, nextOutageMs);
+        if (HostDevice::pollWiFi(stationDeadline)) {
+            nextMs = std::min<uint64_t>(nextMs, std::max<uint64_t>(stationDeadline, nowMs));
+        }
+        nextMs = std::min(nextMs, endMs);
+
+        // Um delay() do evento anterior pode já ter passado do prazo
+        bool wasConnected = wifi.isConnected();
+        HostDevice::advanceClockTo(static_cast<int64_t>(nextMs) * 1000);
+        nextMs = esp_timer_get_time() / 1000;
+        if (!wasConnected) {
+            disconnectedMs += nextMs - nowMs;
+        }
+        nowMs = nextMs;
+        events++;
+
+        if (nowMs >= nextOutageMs) {
+            outageActive = !outageActive;
+            HostDevice::setWiFiLink(!outageActive);
+            if (outageActive) {
+                double minutes = random.uniform(0.5, 1.5) * options.outageMinutes;
+                outages.push_back({nowMs, 0, 0});
+                nextOutageMs = nowMs + static_cast<uint64_t>(minutes * 60000.0);
+            } else {
+                outages.back().end = nowMs;
+                nextOutageMs = nowMs + static_cast<uint64_t>(
+                    random.uniform(0.5, 1.5) * options.outageEveryHours * MS_PER_HOUR);
+            }
+        }
+
+        // Transições da estação WiFi (o que a tarefa "arduino_events" faria)
+        HostDevice::pollWiFi(stationDeadline);
+
+        if (nowMs >= nextSensorMs) {
+            // Mesmo caminho de SensorManager::update(): decisão só a cada SENSOR_CHECK_INTERVAL
+            if (nowMs - lastReadMs >= SENSOR_CHECK_INTERVAL) {
+                lastReadMs = nowMs;
+                SensorData data;
+                data.humidityPercent = soil.advance(nowMs, relayOn);
+                data.temperature = 25.0f;
+                data.timestamp = static_cast<uint32_t>(nowMs);
+                irrigation.updateDecision(data);
+            }
+            irrigation.update();
+
+            // Com a bomba desligada, nada muda entre leituras: salta direto para a próxima
+            nextSensorMs = nowMs + (irrigation.isActive() ? TASK_LOOP_PERIOD_MS : SENSOR_CHECK_INTERVAL);
+        }
+
+        if (nowMs >= nextWiFiCheckMs) {
+            wifi.update();
+            nextWiFiCheckMs = nowMs + WIFI_CHECK_INTERVAL_MS;
+        }
+
+        // O delay() da ativação pode ter avançado o relógio dentro do evento
+        nowMs = esp_timer_get_time() / 1000;
+
+        // Relé, contadores diários e tentativas de reconexão
+        bool relay = Hardware::getRelayState();
+        if (relay != relayOn) {
+            soil.advance(nowMs, relayOn);
+            relayOn = relay;
+            if (relayOn) {
+                runs.push_back({nowMs, 0});
+            } else {
+                runs.back().end = nowMs;
+            }
+        }
+
+        // Sem o reset diário, o contador passaria das ativações das últimas 24 h
+        uint8_t dailyActivations = irrigation.getData().dailyActivations;
+        if (dailyActivations > lastDailyActivations) {
+            size_t recent = 0;
+            for (const Run& run : runs) {
+                recent += run.start + MS_PER_DAY + SENSOR_CHECK_INTERVAL >= nowMs;
+            }
+            if (dailyActivations > recent) {
+                staleDailyCounts++;
+            }
+        }
+        lastDailyActivations = dailyActivations;
+        maxDailyActivations = std::max(maxDailyActivations, dailyActivations);
+
+        uint32_t attempts = HostDevice::getWiFiAttempts();
+        for (; lastAttempts < attempts; lastAttempts++) {
+            attemptTimes.push_back(nowMs);
+        }
+
+        if (!outages.empty() && outages.back().end != 0 && outages.back().reconnectedAt == 0 &&
+            wifi.isConnected()) {
+            outages.back().reconnectedAt = nowMs;
+        }
+    }
+
+    if (relayOn) {
+        runs.back().end = endMs;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    // Resumo da bomba
+    uint64_t pumpMs = 0;
+    uint64_t longestRunMs = 0;
+    uint64_t shortestGapMs = UINT64_MAX;
+    for (size_t i = 0; i < runs.size(); i++) {
+        pumpMs += runs[i].end - runs[i].start;
+        longestRunMs = std::max(longestRunMs, runs[i].end - runs[i].start);
+        if (i > 0) {
+            shortestGapMs = std::min(shortestGapMs, runs[i].start - runs[i - 1].end);
+        }
+    }
+    double duty = 100.0 * pumpMs / endMs;
+
+    // Resumo do WiFi: maior espera entre tentativas durante cada queda
+    uint64_t longestBackoffMs = 0;
+    size_t recovered = 0;
+    for (const Outage& outage : outages) {
+        uint64_t previous = outage.start;
+        for (uint64_t attempt : attemptTimes) {
+            if (attempt > outage.start && (outage.end == 0 || attempt <= outage.end)) {
+                longestBackoffMs = std::max(longestBackoffMs, attempt - previous);
+                previous = attempt;
+            }
+        }
+        if (outage.reconnectedAt != 0 || outage.end == 0) {
+            recovered++;
+        }
+    }
+
+    printf("Simulação: %.1f dia(s) virtuais em %.2f s (%llu eventos)\n", options.days, elapsed,
+           static_cast<unsigned long long>(events));
+    printf("Bomba: %zu ativações, %.1f min ligada, ciclo de trabalho %.2f%%, maior sessão %.1f s\n",
+           runs.size(), pumpMs / 60000.0, duty, longestRunMs / 1000.0);
+    printf("Contador diário: máximo %u ativação(ões)\n", maxDailyActivations);
+    printf("WiFi: %zu queda(s), %zu tentativa(s) de conexão, %.1f min desconectado, maior espera %.1f s\n",
+           outages.size(), attemptTimes.size(), disconnectedMs / 60000.0, longestBackoffMs / 1000.0);
+
+    char detail[96];
+    printf("Verificações:\n");
+
+    snprintf(detail, sizeof(detail), "%.2f%% em [%.2f%%, %.2f%%]", duty, options.minDuty, options.maxDuty);
+    check(duty >= options.minDuty && duty <= options.maxDuty, "ciclo de trabalho da bomba", detail);
+
+    snprintf(detail, sizeof(detail), "maior %.1f s, limite %u ms", longestRunMs / 1000.0, IRRIGATION_MAX_RUNTIME);
+    check(longestRunMs <= IRRIGATION_MAX_RUNTIME, "sessão limitada a IRRIGATION_MAX_RUNTIME", detail);
+
+    snprintf(detail, sizeof(detail), "menor %.1f s, mínimo %u ms",
+             runs.size() > 1 ? shortestGapMs / 1000.0 : 0.0, IRRIGATION_MIN_INTERVAL);
+    check(runs.size() < 2 || shortestGapMs >= IRRIGATION_MIN_INTERVAL,
+          "intervalo mínimo entre ativações", detail);
+
+    snprintf(detail, sizeof(detail), "%u ativação(ões) contada(s) além de 24 h", staleDailyCounts);
+    check(staleDailyCounts == 0, "contador diário zerado a cada 24 h", detail);
+
+    // O runtime é contado em segundos inteiros por sessão, incluindo o atraso de ativação
+    double runtimeErrorS = fabs(static_cast<double>(irrigation.getTotalRuntime()) - pumpMs / 1000.0);
+    double runtimeToleranceS = runs.size() * (1.0 + IRRIGATION_ACTIVATION_DELAY / 1000.0);
+    snprintf(detail, sizeof(detail), "%u s contados, %.1f s medidos no relé",
+             irrigation.getTotalRuntime(), pumpMs / 1000.0);
+    check(runtimeErrorS <= runtimeToleranceS, "tempo total acumulado confere com o relé", detail);
+
+    snprintf(detail, sizeof(detail), "máximo %u por dia, limite %u", maxDailyActivations,
+             IRRIGATION_MAX_DAILY_ACTIVATIONS);
+    check(maxDailyActivations <= IRRIGATION_MAX_DAILY_ACTIVATIONS, "limite diário de ativações", detail);
+
+    snprintf(detail, sizeof(detail), "maior %.1f s, limite %u ms", longestBackoffMs / 1000.0,
+             WIFI_MAX_BACKOFF_MS + WIFI_CHECK_INTERVAL_MS);
+    check(longestBackoffMs <= WIFI_MAX_BACKOFF_MS + WIFI_CHECK_INTERVAL_MS, "backoff de reconexão limitado", detail);
+
+    snprintf(detail, sizeof(detail), "%zu de %zu", recovered, outages.size());
+    check(recovered == outages.size(), "reconexão após cada queda do enlace", detail);
+
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+/**
+ * @file SensorReplay.cpp
+ * @brief Reprodução de leituras de campo no SensorManager, de 1x a 1000x.
+ *
+ * Lê um arquivo exportado em /sensors/trace (ambiente esp32dev_sensor_trace
+ * ou virtual_device) e devolve cada registro aos pinos virtuais no instante
+ * em que foi gravado: ADC do pH, DHT22 (falhas incluídas) e níveis dos
+ * botões. O SensorManager, o IrrigationController e o TelemetryBuffer rodam
+ * sem alterações sobre o relógio virtual, no ciclo da tarefa de sensores;
+ * a telemetria é serializada como no broadcast do WebSocket.
+ *
+ * Com --speed N o relógio virtual anda N vezes mais rápido que o real; com
+ * --speed 0 não há espera e o resultado mede só o processamento.
+ *
+ * Uso:
+ *   sensor_replay campo.strc [--speed 100] [--loop 1] [--csv saida.csv] [--verbose]
+ */
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "Config.h"
+#include "ConsoleWriter.h"
+#include "DataTypes.h"
+#include "Hardware.h"
+#include "HostDevice.h"
+#include "IrrigationController.h"
+#include "SensorManager.h"
+#include "SensorTraceRecorder.h"
+#include "TelemetryBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Definidos em src/WifiPerformance.cpp, que não faz parte da reprodução
+volatile bool g_wifiEarlyInitDone = false;
+volatile bool g_wifiEarlyInitSuccess = false;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Record = SensorTraceRecorder::Record;
+
+const double MAX_SPEED = 1000.0;
+
+struct Options {
+    const char* path = nullptr;
+    double speed = 1.0;           // 0 = sem espera
+    uint32_t loops = 1;
+    const char* csvPath = nullptr;
+    bool verbose = false;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--verbose") == 0) {
+            options.verbose = true;
+            continue;
+        }
+        if (strncmp(arg, "--", 2) != 0) {
+            options.path = arg;
+            continue;
+        }
+        if (!value) {
+            fprintf(stderr, "Argumento inválido ou sem valor: %s\n", arg);
+            return false;
+        }
+
+        if (strcmp(arg, "--speed") == 0) {
+            options.speed = atof(value);
+        } else if (strcmp(arg, "--loop") == 0) {
+            options.loops = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(arg, "--csv") == 0) {
+            options.csvPath = value;
+        } else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", arg);
+            return false;
+        }
+        i++;
+    }
+
+    if (!options.path) {
+        fprintf(stderr, "Uso: sensor_replay <arquivo> [--speed 1] [--loop 1] [--csv saida.csv] [--verbose]\n");
+        return false;
+    }
+    if (options.speed < 0.0 || options.speed > MAX_SPEED || options.loops == 0) {
+        fprintf(stderr, "Valores inválidos para --speed (0 a %.0f) ou --loop\n", MAX_SPEED);
+        return false;
+    }
+    return true;
+}
+
+uint32_t readU32(const uint8_t* bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+/**
+ * Carrega os registros do arquivo. Registros zerados (sobrescritos durante
+ * o download) e fora de ordem são descartados. Arquivos da versão 1, sem a
+ * posição final, também são aceitos (endPosition = 0).
+ */
+bool loadTrace(const char* path, std::vector<Record>& records, uint32_t& dropped, uint32_t& endPosition) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Não foi possível abrir %s\n", path);
+        return false;
+    }
+
+    // Os 16 primeiros bytes são comuns às versões 1 e 2
+    uint8_t header[SensorTraceRecorder::HEADER_SIZE];
+    bool valid = fread(header, 1, 16, file) == 16 &&
+                 memcmp(header, "STR1", 4) == 0 &&
+                 header[4] >= 1 && header[4] <= SensorTraceRecorder::FORMAT_VERSION &&
+                 header[5] == sizeof(Record);
+    if (valid && header[4] >= 2) {
+        valid = fread(&header[16], 1, SensorTraceRecorder::HEADER_SIZE - 16, file) ==
+                SensorTraceRecorder::HEADER_SIZE - 16;
+    }
+    if (!valid) {
+        fprintf(stderr, "%s não é um trace de sensores (STR1 v%u)\n", path, SensorTraceRecorder::FORMAT_VERSION);
+        fclose(file);
+        return false;
+    }
+
+    uint32_t count = readU32(&header[8]);
+    dropped = readU32(&header[12]);
+    endPosition = header[4] >= 2 ? readU32(&header[16]) : 0;
+
+    Record record;
+    for (uint32_t i = 0; i < count && fread(&record, sizeof(record), 1, file) == 1; i++) {
+        if (record.timestamp == 0 ||
+            (!records.empty() && record.timestamp < records.back().timestamp)) {
+            continue;
+        }
+        records.push_back(record);
+    }
+    fclose(file);
+
+    if (records.empty()) {
+        fprintf(stderr, "%s não contém registros\n", path);
+        return false;
+    }
+    return true;
+}
+
+void applyRecord(const Record& record) {
+    HostDevice::setAnalog(Hardware::PIN_PH_SENSOR, record.phRaw);
+
+    float temperature = SensorTraceRecorder::decodeTemperature(record);
+    float humidity = SensorTraceRecorder::decodeHumidity(record);
+    if (isnan(temperature) || isnan(humidity)) {
+        HostDevice::setDhtFailure(true);
+    } else {
+        HostDevice::setDhtFailure(false);
+        HostDevice::setDht(temperature, humidity);
+    }
+
+    HostDevice::setDigitalInput(Hardware::PIN_PHOSPHORUS_BTN,
+        (record.pins & SensorTraceRecorder::PHOSPHORUS_PIN_HIGH) ? HIGH : LOW);
+    HostDevice::setDigitalInput(Hardware::PIN_POTASSIUM_BTN,
+        (record.pins & SensorTraceRecorder::POTASSIUM_PIN_HIGH) ? HIGH : LOW);
+}
+
+uint64_t percentile(std::vector<uint32_t>& samples, double fraction) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+uint32_t elapsedNs(Clock::time_point start) {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    std::vector<Record> records;
+    uint32_t dropped = 0;
+    uint32_t endPosition = 0;
+    if (!loadTrace(options.path, records, dropped, endPosition)) {
+        return 1;
+    }
+
+    FILE* csv = nullptr;
+    if (options.csvPath) {
+        csv = fopen(options.csvPath, "w");
+        if (!csv) {
+            fprintf(stderr, "Não foi possível criar %s\n", options.csvPath);
+            return 1;
+        }
+        fprintf(csv, "timestamp_ms,ph_adc,ph_adc_filtered,ph,temperature,humidity,phosphorus,potassium,irrigation\n");
+    }
+
+    HostDevice::useVirtualClock();
+    Serial.setMuted(!options.verbose);
+    ConsoleWriter::begin(SERIAL_BAUD_RATE);
+
+    // Mesma ordem do setup(): pinos e sensores (que iniciam o controlador)
+    Hardware::setupPins();
+    applyRecord(records.front());
+    SensorManager sensorManager;
+    if (!sensorManager.init()) {
+        fprintf(stderr, "Falha ao inicializar o SensorManager\n");
+        return 1;
+    }
+    IrrigationController& irrigation = IrrigationController::getInstance();
+
+    // O trace começa no próximo ciclo; cada volta continua de onde a anterior parou
+    const uint32_t traceSpan = records.back().timestamp - records.front().timestamp;
+    const uint64_t startMs = millis() + TASK_LOOP_PERIOD_MS;
+    const uint64_t endMs = startMs + static_cast<uint64_t>(traceSpan + TASK_LOOP_PERIOD_MS) * options.loops;
+
+    std::vector<uint32_t> updateNs;
+    std::vector<uint32_t> telemetryNs;
+    updateNs.reserve(static_cast<size_t>((endMs - startMs) / TASK_LOOP_PERIOD_MS) + 1);
+    telemetryNs.reserve(static_cast<size_t>((endMs - startMs) / TELEMETRY_UPDATE_INTERVAL) + 1);
+
+    size_t next = 0;
+    uint32_t loop = 0;
+    uint64_t loopStartMs = startMs;
+    uint64_t nextTelemetryMs = startMs;
+    uint32_t lastReading = sensorManager.getRawData().timestamp;
+    uint32_t readings = 0;
+    uint32_t activations = 0;
+    uint64_t telemetryBytes = 0;
+    bool wasActive = irrigation.isActive();
+    char message[WS_MESSAGE_BUFFER_SIZE];
+
+    Clock::time_point wallStart = Clock::now();
+
+    for (uint64_t nowMs = startMs; nowMs < endMs; nowMs += TASK_LOOP_PERIOD_MS) {
+        if (options.speed > 0.0) {
+            auto target = wallStart + std::chrono::microseconds(
+                static_cast<int64_t>((nowMs - startMs) * 1000.0 / options.speed));
+            std::this_thread::sleep_until(target);
+        }
+        HostDevice::advanceClockTo(static_cast<int64_t>(nowMs) * 1000);
+
+        // Aplica os registros vencidos; o último de cada ciclo prevalece
+        while (loop < options.loops &&
+               loopStartMs + (records[next].timestamp - records.front().timestamp) <= nowMs) {
+            applyRecord(records[next]);
+            if (++next == records.size()) {
+                next = 0;
+                loop++;
+                loopStartMs += traceSpan + TASK_LOOP_PERIOD_MS;
+            }
+        }
+
+        Clock::time_point start = Clock::now();
+        sensorManager.update();
+        updateNs.push_back(elapsedNs(start));
+
+        const SensorRawData& raw = sensorManager.getRawData();
+        if (raw.timestamp != lastReading) {
+            lastReading = raw.timestamp;
+            readings++;
+            if (csv) {
+                const SensorData& data = sensorManager.getData();
+                fprintf(csv, "%u,%u,%u,%.2f,%.2f,%.2f,%d,%d,%d\n", raw.timestamp,
+                        analogRead(Hardware::PIN_PH_SENSOR), raw.phRaw, data.ph, data.temperature,
+                        data.humidityPercent, data.phosphorusPresent, data.potassiumPresent,
+                        irrigation.isActive());
+            }
+        }
+
+        bool active = irrigation.isActive();
+        if (active && !wasActive) {
+            activations++;
+        }
+        wasActive = active;
+
+        // Mesma serialização do broadcast do WebSocket
+        if (nowMs >= nextTelemetryMs) {
+            nextTelemetryMs += TELEMETRY_UPDATE_INTERVAL;
+            start = Clock::now();
+            TelemetryBuffer telemetry = sensorManager.prepareTelemetry();
+            StaticJsonDocument<640> doc;
+            JsonObject root = doc.to<JsonObject>();
+            telemetry.toJson(root);
+            telemetryBytes += serializeJson(doc, message, sizeof(message));
+            telemetryNs.push_back(elapsedNs(start));
+        }
+    }
+
+    double wallSeconds = std::chrono::duration<double>(Clock::now() - wallStart).count();
+    double virtualSeconds = (endMs - startMs) / 1000.0;
+    size_t cycles = updateNs.size();
+    size_t messages = telemetryNs.size();
+
+    uint64_t updateTotal = 0;
+    for (uint32_t ns : updateNs) {
+        updateTotal += ns;
+    }
+    uint64_t telemetryTotal = 0;
+    for (uint32_t ns : telemetryNs) {
+        telemetryTotal += ns;
+    }
+    double busySeconds = (updateTotal + telemetryTotal) / 1e9;
+
+    printf("Trace: %zu registro(s), %.1f s gravados, %u perdido(s) no dispositivo\n",
+           records.size(), traceSpan / 1000.0, dropped);
+    if (endPosition > 0) {
+        printf("Posição final do dump: %u (libera o anel com /sensors/trace?reset=%u)\n",
+               endPosition, endPosition);
+    }
+    char requested[16] = "sem espera";
+    if (options.speed > 0.0) {
+        snprintf(requested, sizeof(requested), "%.0fx", options.speed);
+    }
+    printf("Reprodução: %.1f s virtuais em %.2f s (%.0fx; pedido: %s)\n", virtualSeconds, wallSeconds,
+           wallSeconds > 0.0 ? virtualSeconds / wallSeconds : 0.0, requested);
+    printf("SensorManager::update: %zu ciclo(s), %u leitura(s), média %.0f ns, p99 %llu ns, máx %llu ns\n",
+           cycles, readings, cycles ? static_cast<double>(updateTotal) / cycles : 0.0,
+           static_cast<unsigned long long>(percentile(updateNs, 0.99)),
+           static_cast<unsigned long long>(percentile(updateNs, 1.0)));
+    printf("Telemetria: %zu mensagem(ns), %.0f bytes/mensagem, média %.0f ns, p99 %llu ns\n",
+           messages, messages ? static_cast<double>(telemetryBytes) / messages : 0.0,
+           messages ? static_cast<double>(telemetryTotal) / messages : 0.0,
+           static_cast<unsigned long long>(percentile(telemetryNs, 0.99)));
+    printf("Capacidade: %.0f mensagens/s e %.0fx o tempo real só com processamento\n",
+           telemetryTotal ? messages / (telemetryTotal / 1e9) : 0.0,
+           busySeconds > 0.0 ? virtualSeconds / busySeconds : 0.0);
+    printf("Irrigação: %u ativação(ões), %u s de bomba\n", activations, irrigation.getTotalRuntime());
+
+    if (csv) {
+        fclose(csv);
+    }
+    return 0;
+}
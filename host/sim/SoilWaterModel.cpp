@@ -0,0 +1,88 @@
+/**
+ * @file SoilWaterModel.cpp
+ * @brief Implementação do balanço hídrico do solo.
+ */
+
+#include "SoilWaterModel.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace {
+
+const uint64_t MS_PER_DAY = 86400000ULL;
+
+// Maior passo de integração
+const float MAX_STEP_MINUTES = 1.0f;
+
+} // namespace
+
+SoilWaterModel::SoilWaterModel(const SoilParameters& parameters)
+    : m_parameters(parameters),
+      m_capacityMm(parameters.rootDepthMm * parameters.porosity),
+      m_waterMm(parameters.initialMoisture / 100.0f * m_capacityMm),
+      m_surfaceMm(0.0f),
+      m_pumpedLiters(0.0f),
+      m_runoffMm(0.0f),
+      m_drainedMm(0.0f),
+      m_lastMs(0) {
+}
+
+float SoilWaterModel::advance(uint64_t nowMs, bool pumpOn) {
+    while (nowMs > m_lastMs) {
+        uint64_t stepMs = std::min<uint64_t>(nowMs - m_lastMs, static_cast<uint64_t>(MAX_STEP_MINUTES * 60000.0f));
+        float dayFraction = static_cast<float>(m_lastMs % MS_PER_DAY) / MS_PER_DAY;
+        step(stepMs / 60000.0f, dayFraction, pumpOn);
+        m_lastMs += stepMs;
+    }
+    return moisture();
+}
+
+float SoilWaterModel::moisture() const {
+    return 100.0f * m_waterMm / m_capacityMm;
+}
+
+void SoilWaterModel::step(float minutes, float dayFraction, bool pumpOn) {
+    const SoilParameters& p = m_parameters;
+
+    // Bomba: a água chega à superfície
+    if (pumpOn) {
+        float liters = p.pumpLitersPerMin * minutes;
+        m_pumpedLiters += liters;
+        m_surfaceMm += liters / p.areaM2;
+    }
+
+    // Infiltração limitada pela vazão do solo e pelo espaço livre nos poros
+    float infiltration = std::min(m_surfaceMm, p.infiltrationMmPerMin * minutes);
+    infiltration = std::min(infiltration, m_capacityMm - m_waterMm);
+    m_surfaceMm -= infiltration;
+    m_waterMm += infiltration;
+
+    // O que não cabe na lâmina de superfície escorre
+    if (m_surfaceMm > p.pondingMm) {
+        m_runoffMm += m_surfaceMm - p.pondingMm;
+        m_surfaceMm = p.pondingMm;
+    }
+
+    // Evapotranspiração: meia senoide entre 6 h e 18 h, cuja área é a ET0 diária
+    float hour = dayFraction * 24.0f;
+    float et0PerMinute = 0.0f;
+    if (hour > 6.0f && hour < 18.0f) {
+        et0PerMinute = p.et0MmPerDay * static_cast<float>(M_PI) / 24.0f *
+                       sinf(static_cast<float>(M_PI) * (hour - 6.0f) / 12.0f) / 60.0f;
+    }
+    float stress = (moisture() - p.wiltingPoint) / (p.stressPoint - p.wiltingPoint);
+    stress = std::max(0.0f, std::min(1.0f, stress));
+    m_waterMm -= std::min(m_waterMm, et0PerMinute * p.cropCoefficient * stress * minutes);
+
+    // A lâmina de superfície também evapora
+    m_surfaceMm -= std::min(m_surfaceMm, et0PerMinute * minutes);
+
+    // Drenagem profunda acima da capacidade de campo
+    float excessMm = (moisture() - p.fieldCapacity) / 100.0f * m_capacityMm;
+    if (excessMm > 0.0f) {
+        float drained = excessMm * p.drainagePerHour * minutes / 60.0f;
+        m_waterMm -= drained;
+        m_drainedMm += drained;
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * @file SoilWaterModel.h
+ * @brief Balanço hídrico do solo para a simulação em malha fechada.
+ *
+ * A água da bomba cai na superfície, infiltra com vazão limitada (o excesso
+ * escorre) e entra na zona das raízes. A evapotranspiração segue o sol ao
+ * longo do dia e cai quando o solo seca; acima da capacidade de campo a
+ * água drena para baixo. A umidade lida pelo sensor é a da zona das raízes,
+ * em % da saturação.
+ */
+
+#ifndef SOIL_WATER_MODEL_H
+#define SOIL_WATER_MODEL_H
+
+#include <stdint.h>
+
+/**
+ * @struct SoilParameters
+ * @brief Solo, cultura e bomba; os padrões descrevem um canteiro pequeno.
+ */
+struct SoilParameters {
+    float rootDepthMm = 300.0f;        ///< Profundidade da zona das raízes
+    float porosity = 0.45f;            ///< Fração de poros (água na saturação)
+    float fieldCapacity = 70.0f;       ///< Umidade acima da qual há drenagem (%)
+    float wiltingPoint = 20.0f;        ///< Umidade em que a planta para de transpirar (%)
+    float stressPoint = 45.0f;         ///< Abaixo disso a transpiração cai linearmente (%)
+    float drainagePerHour = 0.05f;     ///< Fração do excesso sobre a capacidade de campo drenada por hora
+    float et0MmPerDay = 5.0f;          ///< Evapotranspiração de referência
+    float cropCoefficient = 1.0f;      ///< Kc da cultura
+    float infiltrationMmPerMin = 1.5f; ///< Vazão máxima de infiltração
+    float pondingMm = 3.0f;            ///< Lâmina retida na superfície antes de escorrer
+    float pumpLitersPerMin = 4.0f;     ///< Vazão da bomba
+    float areaM2 = 2.0f;               ///< Área irrigada (1 L/m² = 1 mm)
+    float initialMoisture = 45.0f;     ///< Umidade inicial (%)
+};
+
+/**
+ * @class SoilWaterModel
+ * @brief Integra o balanço hídrico em passos de até um minuto.
+ */
+class SoilWaterModel {
+public:
+    explicit SoilWaterModel(const SoilParameters& parameters);
+
+    /**
+     * @brief Avança o modelo até o instante dado.
+     *
+     * @param nowMs Tempo de simulação (ms); instantes anteriores são ignorados.
+     * @param pumpOn Estado da bomba desde o último avanço.
+     * @return Umidade da zona das raízes (%).
+     */
+    float advance(uint64_t nowMs, bool pumpOn);
+
+    float moisture() const;
+    float pumpedLiters() const { return m_pumpedLiters; }
+    float runoffLiters() const { return m_runoffMm * m_parameters.areaM2; }
+    float drainedLiters() const { return m_drainedMm * m_parameters.areaM2; }
+
+private:
+    void step(float minutes, float dayFraction, bool pumpOn);
+
+    SoilParameters m_parameters;
+    float m_capacityMm;     // Água na saturação
+    float m_waterMm;        // Água na zona das raízes
+    float m_surfaceMm;      // Lâmina ainda não infiltrada
+    float m_pumpedLiters;
+    float m_runoffMm;
+    float m_drainedMm;
+    uint64_t m_lastMs;
+};
+
+#endif // SOIL_WATER_MODEL_H
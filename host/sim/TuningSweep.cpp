@@ -0,0 +1,416 @@
+/**
+ * @file TuningSweep.cpp
+ * @brief Varredura paralela dos parâmetros do IrrigationController em malha fechada.
+ *
+ * Cada combinação de limiares, intervalo mínimo e duração máxima roda num
+ * processo próprio (fork), com o IrrigationController real decidindo sobre o
+ * SoilWaterModel no relógio virtual. Processos isolam os singletons do
+ * firmware e usam todos os núcleos. O resultado é ordenado por uma soma
+ * ponderada de água usada, tempo fora da faixa alvo e ciclos do relé, cada
+ * um normalizado pelo pior valor; '*' marca as combinações não dominadas.
+ *
+ * Uso:
+ *   tuning_sweep [--low 20:40:2.5] [--high 50:80:5] [--interval-min 1:31:10]
+ *                [--runtime-s 60:300:60] [--days 14] [--band 35:65]
+ *                [--weights 1,1,1] [--et0 5] [--pump-lpm 4] [--jobs N]
+ *                [--top 20] [--csv arquivo]
+ */
+
+#include <Arduino.h>
+#include "Config.h"
+#include "ConsoleWriter.h"
+#include "DataTypes.h"
+#include "Hardware.h"
+#include "HostDevice.h"
+#include "IrrigationController.h"
+#include "SoilWaterModel.h"
+
+#include <esp_timer.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+const uint64_t MS_PER_DAY = 86400000ULL;
+
+// Com a bomba desligada só a decisão importa, e ela só ocorre a cada 5 s
+const uint32_t IDLE_STEP_MS = 5000;
+
+struct Range {
+    float start;
+    float end;
+    float step;
+};
+
+struct SweepOptions {
+    Range low = {20.0f, 40.0f, 2.5f};
+    Range high = {50.0f, 80.0f, 5.0f};
+    Range intervalMinutes = {1.0f, 31.0f, 10.0f};
+    Range runtimeSeconds = {60.0f, 300.0f, 60.0f};
+    double days = 14.0;
+    float bandLow = 35.0f;
+    float bandHigh = 65.0f;
+    float weights[3] = {1.0f, 1.0f, 1.0f};
+    SoilParameters soil;
+    long jobs = 0;               // 0 = todos os núcleos
+    size_t top = 20;
+    const char* csv = nullptr;
+};
+
+struct Combination {
+    IrrigationTuning tuning;
+};
+
+struct Result {
+    bool valid;
+    float waterLiters;
+    float outOfBandHours;
+    uint32_t cycles;
+    float lostLiters;            // Escoamento e drenagem profunda
+    float minMoisture;
+    float maxMoisture;
+    float score;
+    bool pareto;
+};
+
+bool parseRange(const char* text, Range& range) {
+    int fields = sscanf(text, "%f:%f:%f", &range.start, &range.end, &range.step);
+    if (fields == 1) {
+        range.end = range.start;
+        range.step = 1.0f;
+    }
+    return (fields == 1 || fields == 3) && range.step > 0.0f && range.end >= range.start;
+}
+
+bool parseOptions(int argc, char** argv, SweepOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            fprintf(stderr, "Argumento inválido ou sem valor: %s\n", arg);
+            return false;
+        }
+
+        bool ok = true;
+        if (strcmp(arg, "--low") == 0) {
+            ok = parseRange(value, options.low);
+        } else if (strcmp(arg, "--high") == 0) {
+            ok = parseRange(value, options.high);
+        } else if (strcmp(arg, "--interval-min") == 0) {
+            ok = parseRange(value, options.intervalMinutes);
+        } else if (strcmp(arg, "--runtime-s") == 0) {
+            ok = parseRange(value, options.runtimeSeconds);
+        } else if (strcmp(arg, "--days") == 0) {
+            options.days = atof(value);
+            ok = options.days > 0.0;
+        } else if (strcmp(arg, "--band") == 0) {
+            ok = sscanf(value, "%f:%f", &options.bandLow, &options.bandHigh) == 2 &&
+                 options.bandLow < options.bandHigh;
+        } else if (strcmp(arg, "--weights") == 0) {
+            ok = sscanf(value, "%f,%f,%f", &options.weights[0], &options.weights[1], &options.weights[2]) == 3;
+        } else if (strcmp(arg, "--et0") == 0) {
+            options.soil.et0MmPerDay = static_cast<float>(atof(value));
+        } else if (strcmp(arg, "--pump-lpm") == 0) {
+            options.soil.pumpLitersPerMin = static_cast<float>(atof(value));
+            ok = options.soil.pumpLitersPerMin > 0.0f;
+        } else if (strcmp(arg, "--jobs") == 0) {
+            options.jobs = strtol(value, nullptr, 10);
+            ok = options.jobs > 0;
+        } else if (strcmp(arg, "--top") == 0) {
+            options.top = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--csv") == 0) {
+            options.csv = value;
+        } else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", arg);
+            return false;
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Valor inválido para %s: %s\n", arg, value);
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+std::vector<float> expand(const Range& range) {
+    std::vector<float> values;
+    // Meio passo de folga para o último valor não se perder no arredondamento
+    for (float value = range.start; value <= range.end + range.step / 2; value += range.step) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+std::vector<Combination> buildCombinations(const SweepOptions& options) {
+    std::vector<Combination> combinations;
+    for (float low : expand(options.low)) {
+        for (float high : expand(options.high)) {
+            if (low >= high) {
+                continue;
+            }
+            for (float interval : expand(options.intervalMinutes)) {
+                for (float runtime : expand(options.runtimeSeconds)) {
+                    Combination combination;
+                    combination.tuning.thresholdLow = low;
+                    combination.tuning.thresholdHigh = high;
+                    combination.tuning.minInterval = static_cast<uint32_t>(interval * 60000.0f);
+                    combination.tuning.maxRuntime = static_cast<uint32_t>(runtime * 1000.0f);
+                    combinations.push_back(combination);
+                }
+            }
+        }
+    }
+    return combinations;
+}
+
+/**
+ * Roda uma combinação; chamado num processo filho recém-criado.
+ */
+Result simulate(const Combination& combination, const SweepOptions& options) {
+    Result result = {};
+
+    HostDevice::useVirtualClock();
+    Hardware::setupPins();
+    IrrigationController& irrigation = IrrigationController::getInstance();
+    if (!irrigation.init() || !irrigation.setTuning(combination.tuning)) {
+        return result;
+    }
+
+    SoilWaterModel soil(options.soil);
+    const uint64_t endMs = static_cast<uint64_t>(options.days * MS_PER_DAY);
+    uint64_t nowMs = SENSOR_CHECK_INTERVAL;
+    uint64_t lastMs = 0;
+    bool pumpOn = false;
+    float moisture = soil.moisture();
+    double outOfBandMs = 0.0;
+
+    result.minMoisture = moisture;
+    result.maxMoisture = moisture;
+
+    while (nowMs < endMs) {
+        HostDevice::advanceClockTo(static_cast<int64_t>(nowMs) * 1000);
+        moisture = soil.advance(nowMs, pumpOn);
+        if (moisture < options.bandLow || moisture > options.bandHigh) {
+            outOfBandMs += static_cast<double>(nowMs - lastMs);
+        }
+        result.minMoisture = std::min(result.minMoisture, moisture);
+        result.maxMoisture = std::max(result.maxMoisture, moisture);
+        lastMs = nowMs;
+
+        SensorData data;
+        data.humidityPercent = moisture;
+        data.temperature = 25.0f;
+        data.timestamp = static_cast<uint32_t>(nowMs);
+        irrigation.updateDecision(data);
+        irrigation.update();
+
+        // O delay() da ativação avança o relógio dentro da decisão
+        nowMs = static_cast<uint64_t>(esp_timer_get_time() / 1000);
+        if (nowMs > lastMs) {
+            soil.advance(nowMs, pumpOn);
+        }
+
+        bool relay = Hardware::getRelayState();
+        if (relay && !pumpOn) {
+            result.cycles++;
+        }
+        pumpOn = relay;
+
+        nowMs += pumpOn ? SENSOR_CHECK_INTERVAL : IDLE_STEP_MS;
+    }
+
+    result.valid = true;
+    result.waterLiters = soil.pumpedLiters();
+    result.outOfBandHours = static_cast<float>(outOfBandMs / 3600000.0);
+    result.lostLiters = soil.runoffLiters() + soil.drainedLiters();
+    return result;
+}
+
+/**
+ * Um processo por combinação, no máximo "jobs" ao mesmo tempo. O resultado
+ * cabe num write() atômico de pipe e é lido quando o filho termina.
+ */
+void runAll(const std::vector<Combination>& combinations, const SweepOptions& options,
+            long jobs, std::vector<Result>& results) {
+    struct Child {
+        size_t index;
+        int fd;
+    };
+    std::map<pid_t, Child> running;
+    size_t next = 0;
+
+    results.assign(combinations.size(), Result());
+
+    while (next < combinations.size() || !running.empty()) {
+        while (next < combinations.size() && static_cast<long>(running.size()) < jobs) {
+            int fds[2];
+            if (pipe(fds) != 0) {
+                perror("pipe");
+                exit(1);
+            }
+            fflush(stdout);
+            pid_t pid = fork();
+            if (pid < 0) {
+                perror("fork");
+                exit(1);
+            }
+            if (pid == 0) {
+                close(fds[0]);
+                Result result = simulate(combinations[next], options);
+                ssize_t written = write(fds[1], &result, sizeof(result));
+                _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+            }
+            close(fds[1]);
+            running[pid] = {next++, fds[0]};
+        }
+
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        auto child = running.find(pid);
+        if (child == running.end()) {
+            continue;
+        }
+        Result result = {};
+        if (read(child->second.fd, &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result))) {
+            result.valid = false;
+        }
+        close(child->second.fd);
+        results[child->second.index] = result;
+        running.erase(child);
+    }
+}
+
+bool dominates(const Result& a, const Result& b) {
+    bool noWorse = a.waterLiters <= b.waterLiters && a.outOfBandHours <= b.outOfBandHours &&
+                   a.cycles <= b.cycles;
+    bool better = a.waterLiters < b.waterLiters || a.outOfBandHours < b.outOfBandHours ||
+                  a.cycles < b.cycles;
+    return noWorse && better;
+}
+
+void rank(std::vector<Result>& results, const float weights[3]) {
+    float worst[3] = {0.0f, 0.0f, 0.0f};
+    for (const Result& result : results) {
+        if (result.valid) {
+            worst[0] = std::max(worst[0], result.waterLiters);
+            worst[1] = std::max(worst[1], result.outOfBandHours);
+            worst[2] = std::max(worst[2], static_cast<float>(result.cycles));
+        }
+    }
+    for (float& value : worst) {
+        value = value > 0.0f ? value : 1.0f;
+    }
+
+    for (Result& result : results) {
+        if (!result.valid) {
+            continue;
+        }
+        result.score = weights[0] * result.waterLiters / worst[0] +
+                       weights[1] * result.outOfBandHours / worst[1] +
+                       weights[2] * result.cycles / worst[2];
+        result.pareto = true;
+        for (const Result& other : results) {
+            if (other.valid && dominates(other, result)) {
+                result.pareto = false;
+                break;
+            }
+        }
+    }
+}
+
+bool writeCsv(const char* path, const std::vector<Combination>& combinations,
+              const std::vector<Result>& results) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "low,high,interval_ms,runtime_ms,valid,water_l,out_of_band_h,cycles,lost_l,"
+                  "min_moisture,max_moisture,score,pareto\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const IrrigationTuning& tuning = combinations[i].tuning;
+        const Result& result = results[i];
+        fprintf(file, "%.2f,%.2f,%u,%u,%d,%.2f,%.3f,%u,%.2f,%.2f,%.2f,%.4f,%d\n",
+                tuning.thresholdLow, tuning.thresholdHigh, tuning.minInterval, tuning.maxRuntime,
+                result.valid, result.waterLiters, result.outOfBandHours, result.cycles,
+                result.lostLiters, result.minMoisture, result.maxMoisture, result.score, result.pareto);
+    }
+    fclose(file);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SweepOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+
+    // Os filhos herdam o console mudo: só o relatório do pai é impresso
+    Serial.setMuted(true);
+    ConsoleWriter::begin(SERIAL_BAUD_RATE);
+
+    std::vector<Combination> combinations = buildCombinations(options);
+    if (combinations.empty()) {
+        fprintf(stderr, "Nenhuma combinação válida (limiar baixo deve ser menor que o alto)\n");
+        return 2;
+    }
+
+    long jobs = options.jobs > 0 ? options.jobs : sysconf(_SC_NPROCESSORS_ONLN);
+    jobs = std::max(1L, jobs);
+
+    auto started = std::chrono::steady_clock::now();
+    std::vector<Result> results;
+    runAll(combinations, options, jobs, results);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    rank(results, options.weights);
+
+    std::vector<size_t> order;
+    size_t failed = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i].valid) {
+            order.push_back(i);
+        } else {
+            failed++;
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return results[a].score < results[b].score; });
+
+    printf("%zu combinação(ões) x %.1f dia(s) em %.1f s com %ld processo(s)", combinations.size(),
+           options.days, elapsed, jobs);
+    if (failed > 0) {
+        printf(", %zu falharam", failed);
+    }
+    printf("\nFaixa alvo %.1f%%-%.1f%%, pesos água/fora da faixa/ciclos %.2f/%.2f/%.2f\n\n",
+           options.bandLow, options.bandHigh, options.weights[0], options.weights[1], options.weights[2]);
+
+    printf("%4s %6s %6s %9s %8s %9s %9s %7s %9s %11s %7s\n", "#", "baixo", "alto", "interv.s",
+           "dur.s", "água L", "fora h", "ciclos", "perda L", "umidade %", "nota");
+    for (size_t n = 0; n < order.size() && n < options.top; n++) {
+        const IrrigationTuning& tuning = combinations[order[n]].tuning;
+        const Result& result = results[order[n]];
+        printf("%4zu %6.1f %6.1f %9u %8u %9.1f %9.2f %7u %9.1f %5.1f-%-5.1f %6.3f%s\n", n + 1,
+               tuning.thresholdLow, tuning.thresholdHigh, tuning.minInterval / 1000,
+               tuning.maxRuntime / 1000, result.waterLiters, result.outOfBandHours, result.cycles,
+               result.lostLiters, result.minMoisture, result.maxMoisture, result.score,
+               result.pareto ? "*" : "");
+    }
+
+    if (options.csv) {
+        if (!writeCsv(options.csv, combinations, results)) {
+            fprintf(stderr, "Falha ao gravar %s\n", options.csv);
+            return 1;
+        }
+        printf("\nResultados completos em %s\n", options.csv);
+    }
+
+    return failed == 0 ? 0 : 1;
+}
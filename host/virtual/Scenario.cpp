@@ -0,0 +1,255 @@
+/**
+ * @file Scenario.cpp
+ * @brief Leitura do roteiro e tarefa que alimenta as entradas virtuais.
+ */
+
+#include "Scenario.h"
+
+#include "Hardware.h"
+#include "HostDevice.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+namespace Scenario {
+
+namespace {
+
+// Período da tarefa do roteiro e do modelo do solo
+const uint32_t TICK_MS = 100;
+
+enum class Command { ADC, INPUT_LEVEL, DHT, DHT_FAIL, DHT_OK, WIFI_UP, WIFI_DOWN, RSSI, SOIL, REPEAT };
+
+struct Event {
+    uint32_t time;
+    Command command;
+    int pin;
+    float first;
+    float second;
+};
+
+std::vector<Event> s_events;
+
+// Primeiro evento ainda não aplicado quando a tarefa começa
+size_t s_firstPending = 0;
+
+// Estado do modelo do solo
+float s_temperature = 25.0f;
+float s_humidity = 50.0f;
+float s_dryRate = 0.0f;
+float s_wetRate = 0.0f;
+
+// Roteiro padrão: solo secando até a rega, sensores estáveis
+const char* const DEFAULT_SCENARIO[] = {
+    "0 adc ph 2048",
+    "0 input phosphorus 1",
+    "0 input potassium 1",
+    "0 dht 25.0 45.0",
+    "0 soil 20 120",
+};
+
+int parsePin(const char* name) {
+    if (strcmp(name, "ph") == 0) return Hardware::PIN_PH_SENSOR;
+    if (strcmp(name, "phosphorus") == 0) return Hardware::PIN_PHOSPHORUS_BTN;
+    if (strcmp(name, "potassium") == 0) return Hardware::PIN_POTASSIUM_BTN;
+
+    char* end;
+    long pin = strtol(name, &end, 10);
+    return (*end == '\0' && pin >= 0 && pin < 40) ? static_cast<int>(pin) : -1;
+}
+
+bool parseLine(const char* line, Event& event) {
+    char command[16] = {0};
+    char first[16] = {0};
+    char second[16] = {0};
+    unsigned long time;
+    int fields = sscanf(line, "%lu %15s %15s %15s", &time, command, first, second);
+    if (fields < 2) {
+        return false;
+    }
+
+    event.time = static_cast<uint32_t>(time);
+    event.pin = -1;
+    event.first = static_cast<float>(atof(first));
+    event.second = static_cast<float>(atof(second));
+
+    if (strcmp(command, "adc") == 0 && fields == 4) {
+        event.command = Command::ADC;
+        event.pin = parsePin(first);
+        event.first = event.second;
+        return event.pin >= 0;
+    }
+    if (strcmp(command, "input") == 0 && fields == 4) {
+        event.command = Command::INPUT_LEVEL;
+        event.pin = parsePin(first);
+        event.first = event.second;
+        return event.pin >= 0;
+    }
+    if (strcmp(command, "dht") == 0 && fields == 3) {
+        if (strcmp(first, "fail") == 0) { event.command = Command::DHT_FAIL; return true; }
+        if (strcmp(first, "ok") == 0) { event.command = Command::DHT_OK; return true; }
+        return false;
+    }
+    if (strcmp(command, "dht") == 0 && fields == 4) {
+        event.command = Command::DHT;
+        return true;
+    }
+    if (strcmp(command, "wifi") == 0 && fields == 3) {
+        if (strcmp(first, "up") == 0) { event.command = Command::WIFI_UP; return true; }
+        if (strcmp(first, "down") == 0) { event.command = Command::WIFI_DOWN; return true; }
+        return false;
+    }
+    if (strcmp(command, "rssi") == 0 && fields == 3) {
+        event.command = Command::RSSI;
+        return true;
+    }
+    if (strcmp(command, "soil") == 0 && fields == 4) {
+        event.command = Command::SOIL;
+        return true;
+    }
+    if (strcmp(command, "repeat") == 0 && fields == 2 && event.time > 0) {
+        event.command = Command::REPEAT;
+        return true;
+    }
+    return false;
+}
+
+void apply(const Event& event) {
+    switch (event.command) {
+        case Command::ADC:
+            HostDevice::setAnalog(event.pin, static_cast<uint16_t>(event.first));
+            break;
+        case Command::INPUT_LEVEL:
+            HostDevice::setDigitalInput(event.pin, event.first != 0.0f ? HIGH : LOW);
+            break;
+        case Command::DHT:
+            s_temperature = event.first;
+            s_humidity = event.second;
+            HostDevice::setDht(s_temperature, s_humidity);
+            break;
+        case Command::DHT_FAIL:
+            HostDevice::setDhtFailure(true);
+            break;
+        case Command::DHT_OK:
+            HostDevice::setDhtFailure(false);
+            break;
+        case Command::WIFI_UP:
+            HostDevice::setWiFiLink(true);
+            break;
+        case Command::WIFI_DOWN:
+            HostDevice::setWiFiLink(false);
+            break;
+        case Command::RSSI:
+            HostDevice::setWiFiRssi(static_cast<int8_t>(event.first));
+            break;
+        case Command::SOIL:
+            s_dryRate = event.first;
+            s_wetRate = event.second;
+            break;
+        case Command::REPEAT:
+            break;
+    }
+}
+
+void stepSoil(bool relayOn) {
+    if (s_dryRate == 0.0f && s_wetRate == 0.0f) {
+        return;
+    }
+    float rate = relayOn ? s_wetRate : -s_dryRate;
+    s_humidity = constrain(s_humidity + rate * TICK_MS / 60000.0f, 0.0f, 100.0f);
+    HostDevice::setDht(s_temperature, s_humidity);
+}
+
+void taskFunc(void*) {
+    size_t next = s_firstPending;
+    uint32_t base = millis();
+    bool relayOn = false;
+    TickType_t lastWake = xTaskGetTickCount();
+
+    while (true) {
+        uint32_t elapsed = millis() - base;
+        while (next < s_events.size() && s_events[next].time <= elapsed) {
+            const Event& event = s_events[next++];
+            if (event.command == Command::REPEAT) {
+                base += event.time;
+                elapsed -= event.time;
+                next = 0;
+                continue;
+            }
+            apply(event);
+        }
+
+        bool relay = HostDevice::getPinLevel(Hardware::PIN_IRRIGATION_RELAY) == HIGH;
+        if (relay != relayOn) {
+            relayOn = relay;
+            fprintf(stderr, "[virtual] %.1fs relé %s (umidade %.1f%%)\n",
+                    millis() / 1000.0f, relayOn ? "LIGADO" : "desligado", s_humidity);
+        }
+        stepSoil(relayOn);
+
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(TICK_MS));
+    }
+}
+
+} // namespace
+
+bool load(const char* path) {
+    s_events.clear();
+    Event event;
+
+    if (!path) {
+        for (const char* line : DEFAULT_SCENARIO) {
+            parseLine(line, event);
+            s_events.push_back(event);
+        }
+        return true;
+    }
+
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cenário não encontrado: %s\n", path);
+        return false;
+    }
+
+    char line[256];
+    int number = 0;
+    bool valid = true;
+    while (fgets(line, sizeof(line), file)) {
+        number++;
+        char* comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        if (strspn(line, " \t\r\n") == strlen(line)) {
+            continue;
+        }
+        if (!parseLine(line, event)) {
+            fprintf(stderr, "%s:%d: linha inválida\n", path, number);
+            valid = false;
+            continue;
+        }
+        s_events.push_back(event);
+    }
+    fclose(file);
+
+    // Eventos fora de ordem são aplicados no seu tempo, mantendo a ordem do arquivo entre iguais
+    std::stable_sort(s_events.begin(), s_events.end(),
+                     [](const Event& a, const Event& b) { return a.time < b.time; });
+    return valid;
+}
+
+void start() {
+    // Os valores iniciais já valem durante o setup() do firmware
+    size_t applied = 0;
+    while (applied < s_events.size() && s_events[applied].time == 0 &&
+           s_events[applied].command != Command::REPEAT) {
+        apply(s_events[applied++]);
+    }
+    s_firstPending = applied;
+
+    xTaskCreatePinnedToCore(taskFunc, "scenario", 4096, nullptr, 1, nullptr, tskNO_AFFINITY);
+}
+
+} // namespace Scenario
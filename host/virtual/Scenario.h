@@ -0,0 +1,38 @@
+/**
+ * @file Scenario.h
+ * @brief Roteiro de entradas do dispositivo virtual, lido de um arquivo texto.
+ *
+ * Cada linha é "tempo_ms comando argumentos"; '#' inicia um comentário.
+ *
+ *   adc <pino|ph> <0-4095>          valor lido por analogRead()
+ *   input <pino|phosphorus|potassium> <0|1>
+ *   dht <temperatura> <umidade>     leitura do DHT22
+ *   dht fail | dht ok               falha de leitura do DHT22
+ *   wifi up | wifi down             enlace com o ponto de acesso
+ *   rssi <dBm>                      RSSI enquanto conectado
+ *   soil <secagem> <rega>           modelo do solo em %/min: a umidade cai
+ *                                   com o relé desligado e sobe com ele ligado
+ *   repeat                          recomeça o roteiro a partir deste tempo
+ *
+ * As linhas com o mesmo tempo são aplicadas na ordem do arquivo.
+ */
+
+#ifndef HOST_VIRTUAL_SCENARIO_H
+#define HOST_VIRTUAL_SCENARIO_H
+
+namespace Scenario {
+
+/**
+ * @brief Carrega o roteiro; sem arquivo, usa um solo que seca e é regado.
+ * @return false se o arquivo não pôde ser lido ou tem linhas inválidas.
+ */
+bool load(const char* path);
+
+/**
+ * @brief Aplica os eventos de tempo 0 e inicia a tarefa que executa o restante.
+ */
+void start();
+
+} // namespace Scenario
+
+#endif // HOST_VIRTUAL_SCENARIO_H
@@ -0,0 +1,49 @@
+/**
+ * @file VirtualDevice.cpp
+ * @brief Firmware completo como processo Linux: setup() e loop() do Main.cpp.
+ *
+ * Uso:
+ *   virtual_device [--scenario arquivo] [--port 8888]
+ *
+ * O console serial é o terminal (comandos pela entrada padrão). As
+ * mensagens do dispositivo virtual e do servidor saem em stderr.
+ */
+
+#include <Arduino.h>
+#include "HostDevice.h"
+#include "Scenario.h"
+
+// Definidos em src/Main.cpp
+void setup();
+void loop();
+
+// Porta encaminhada pelo Wokwi para a 80 do dispositivo (platformio.ini)
+static const uint16_t DEFAULT_HTTP_PORT = 8888;
+
+int main(int argc, char** argv) {
+    const char* scenario = nullptr;
+    long port = DEFAULT_HTTP_PORT;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            scenario = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = strtol(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Uso: %s [--scenario arquivo] [--port %u]\n", argv[0], DEFAULT_HTTP_PORT);
+            return 2;
+        }
+    }
+
+    if (port <= 0 || port > 65535 || !Scenario::load(scenario)) {
+        return 2;
+    }
+    HostDevice::setHttpPort(static_cast<uint16_t>(port));
+    Scenario::start();
+
+    // Como a loopTask do core Arduino
+    setup();
+    while (true) {
+        loop();
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * @file AllocationGuard.h
+ * @brief Verificação de zero alocações no heap em regime permanente.
+ *
+ * Depois que setup() declara o boot concluído, toda alocação feita por uma
+ * tarefa dentro de um ALLOC_GUARD_SCOPE (ciclo de sensores, broadcast) é
+ * contada como violação e, com ALLOC_GUARD_BACKTRACE, tem seu backtrace
+ * impresso na serial. A contagem depende dos wrappers de HeapHooks.cpp e só
+ * existe no ambiente esp32dev_alloc_guard; nos demais as macros são vazias.
+ */
+
+#ifndef ALLOCATION_GUARD_H
+#define ALLOCATION_GUARD_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class AllocationGuard
+ * @brief Contadores de alocações após o boot.
+ */
+class AllocationGuard {
+public:
+    /**
+     * @brief Contadores acumulados desde markBootComplete().
+     */
+    struct Stats {
+        uint32_t hotPathAllocs;   ///< Alocações dentro de escopos protegidos
+        uint32_t hotPathBytes;    ///< Bytes solicitados nessas alocações
+        uint32_t steadyAllocs;    ///< Todas as alocações após o boot (inclui bibliotecas)
+        bool bootComplete;
+    };
+
+    /**
+     * @brief Marca o fim da inicialização; a partir daqui as alocações contam.
+     */
+    static void markBootComplete();
+
+    /**
+     * @brief Registra uma alocação. Chamado pelos wrappers de malloc.
+     * @param size Tamanho solicitado.
+     */
+    static void onAllocation(size_t size);
+
+    /**
+     * @brief Obtém os contadores.
+     * @return Cópia dos contadores.
+     */
+    static Stats getStats();
+
+    /**
+     * @brief Alocações dentro de escopos protegidos desde o boot.
+     * @return Número de violações (sempre 0 quando desativado).
+     */
+    static uint32_t getViolationCount();
+
+    /**
+     * @class Scope
+     * @brief Marca a tarefa atual como em caminho crítico enquanto existir.
+     */
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * @class Exempt
+     * @brief Suspende a verificação na tarefa atual (alocações inevitáveis
+     *        de bibliotecas, como o buffer de mensagem do AsyncWebSocket).
+     */
+    class Exempt {
+    public:
+        Exempt();
+        ~Exempt();
+        Exempt(const Exempt&) = delete;
+        Exempt& operator=(const Exempt&) = delete;
+
+    private:
+        uint8_t m_savedDepth;
+    };
+
+private:
+    AllocationGuard() = delete;
+};
+
+#if ALLOC_GUARD_ENABLED
+#define ALLOC_GUARD_SCOPE()  AllocationGuard::Scope allocGuardScope
+#define ALLOC_GUARD_EXEMPT() AllocationGuard::Exempt allocGuardExempt
+#else
+#define ALLOC_GUARD_SCOPE()  do {} while (0)
+#define ALLOC_GUARD_EXEMPT() do {} while (0)
+#endif
+
+#endif // ALLOCATION_GUARD_H
@@ -16,6 +16,8 @@
 #include "SystemMonitor.h"
 #include "WiFiManager.h"
 #include "MemoryManager.h"
+#include "RequestArena.h"
+#include "FixedString.h"
 
 /**
  * Classe para servidor web assíncrono com WebSockets
@@ -91,6 +93,74 @@ private:
      */
     void handleLogs(AsyncWebServerRequest *request);
 
+    /**
+     * Handler para os contadores do console serial.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleConsole(AsyncWebServerRequest *request);
+
+    /**
+     * Handler para a contenção dos mutexes instrumentados.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleLocks(AsyncWebServerRequest *request);
+
+    /**
+     * Handler para o tempo de execução e o atraso dos jobs periódicos.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleJobs(AsyncWebServerRequest *request);
+
+#if HEAP_PROFILE_ENABLED
+    /**
+     * Handler para as tabelas do HeapProfiler (ambiente esp32dev_heap_profile).
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleHeap(AsyncWebServerRequest *request);
+#endif
+
+#if FUNCTION_PROFILE_ENABLED
+    /**
+     * Handler para os totais do profiler de funções (ambiente esp32dev_profile).
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleFunctionProfile(AsyncWebServerRequest *request);
+#endif
+
+#if PROFILE_ZONES_ENABLED
+    /**
+     * Handler para os percentis das zonas de tempo.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleZoneProfile(AsyncWebServerRequest *request);
+#endif
+
+#if TRACE_ENABLED
+    /**
+     * Handler para o dump do trace de eventos (ambiente esp32dev_trace).
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleTrace(AsyncWebServerRequest *request);
+#endif
+
+#if SENSOR_TRACE_ENABLED
+    /**
+     * Handler para o dump das leituras brutas dos sensores
+     * (ambiente esp32dev_sensor_trace). ?reset=<posição> descarta os
+     * registros até a posição final informada no cabeçalho do dump.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     */
+    void handleSensorTrace(AsyncWebServerRequest *request);
+#endif
+
     /**
      * Handler para requisições não encontradas.
      *
@@ -99,13 +169,32 @@ private:
     void handleNotFound(AsyncWebServerRequest *request);
 
     /**
-     * Prepara mensagem JSON com dados dos sensores.
+     * Libera a arena quando a requisição terminar.
      *
-     * @param dataOnly Se true, inclui apenas dados dos sensores.
-     *                 Se false, inclui também estatísticas do sistema.
-     * @return Mensagem JSON formatada.
+     * @param request Ponteiro para a requisição HTTP.
+     * @param arena Arena cuja posse é transferida para a requisição.
      */
-    String prepareJsonMessage(bool dataOnly = false);
+    static void attachArena(AsyncWebServerRequest *request, RequestArena *arena);
+
+    /**
+     * Envia um corpo armazenado na arena, sem copiá-lo.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     * @param arena Arena que contém o corpo (posse transferida).
+     * @param contentType Tipo MIME da resposta.
+     * @param body Corpo da resposta.
+     * @param length Tamanho do corpo.
+     */
+    static void sendFromArena(AsyncWebServerRequest *request, RequestArena *arena,
+                              const char *contentType, const char *body, size_t length);
+
+    /**
+     * Serializa um documento JSON em uma arena e o envia.
+     *
+     * @param request Ponteiro para a requisição HTTP.
+     * @param doc Documento a ser enviado.
+     */
+    static void sendJson(AsyncWebServerRequest *request, const JsonDocument &doc);
 
 public:
     /**
@@ -144,7 +233,7 @@ public:
      * @param message Mensagem a ser enviada.
      * @return true se a mensagem foi enviada para pelo menos um cliente.
      */
-    bool broadcastMessage(const String &message);
+    bool broadcastMessage(StringView message);
 
     /**
      * Limpa clientes inativos.
@@ -152,6 +241,13 @@ public:
      * @return Número de clientes removidos.
      */
     uint16_t cleanClients();
+
+    /**
+     * Job "ws.cleanup": limpa clientes inativos a cada 5 segundos.
+     *
+     * @param context Instância do servidor.
+     */
+    static void cleanupJob(void *context);
 };
 
 #endif // ASYNC_SOIL_WEB_SERVER_H
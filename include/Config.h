@@ -31,13 +31,29 @@
 #define IRRIGATION_MAX_RUNTIME    300000  // Tempo máximo contínuo de irrigação (ms) - 5 minutos
 #define IRRIGATION_MIN_INTERVAL   60000   // Intervalo mínimo entre ativações (ms) - 1 minuto
 #define IRRIGATION_ACTIVATION_DELAY 500   // Delay antes de ativar relé (ms)
+#define IRRIGATION_MAX_DAILY_ACTIVATIONS 50 // Ativações permitidas em 24 h
 #define MOISTURE_THRESHOLD_LOW    30.0f   // Limiar inferior para ativação da irrigação (%)
 #define MOISTURE_THRESHOLD_HIGH   70.0f   // Limiar superior para desativação da irrigação (%)
 
 // Configurações de memória
 #define USE_STATIC_MEMORY         true   // Usar alocação estática onde possível
 #define JSON_BUFFER_SIZE          128    // Tamanho do buffer para JSON (bytes)
+#define JSON_BUFFER_POOL_SIZE     1      // Número de buffers JSON pré-alocados
+#define SENSOR_DATA_POOL_SIZE     10     // Número de objetos SensorData pré-alocados
 #define MAX_HTML_CLIENTS          5      // Número máximo de clientes HTML simultâneos
+// Arenas das requisições web. As respostas longas são geradas sob demanda,
+// então um slab só guarda o estado do gerador e a linha corrente; respostas
+// chunked seguram o slab até o disconnect, por isso há um por cliente
+#define REQUEST_ARENA_SLAB_SIZE   1024   // Memória de trabalho por requisição web (bytes)
+#define REQUEST_ARENA_SLAB_COUNT  (MAX_HTML_CLIENTS + 3)  // Clientes HTTP + mensagens WebSocket
+#define WS_MESSAGE_BUFFER_SIZE    640    // Mensagem de telemetria serializada na pilha (bytes)
+
+// Verificação incremental de integridade do heap (uma região por fatia)
+#define HEAP_CHECK_SLICE_INTERVAL_MS 500  // Intervalo entre fatias (uma região inteira cada, ms)
+#define HEAP_CHECK_MAX_REGIONS    24     // Regiões de heap rastreadas
+#define HEAP_CHECK_TASK_PRIORITY  0      // Mesma prioridade da idle: só usa tempo ocioso
+#define HEAP_CHECK_TASK_CORE      TASK_WEB_CORE
+#define HEAP_CHECK_STACK_SIZE     2560   // Pilha da tarefa de verificação (bytes)
 
 // Configurações de watchdog
 #define WATCHDOG_TIMEOUT          5000   // Tempo limite do watchdog (ms)
@@ -49,6 +65,25 @@
 #define TASK_STACK_SIZE           4096   // Tamanho da pilha para tarefas (bytes)
 #define TASK_PRIORITY_SENSOR      2      // Prioridade da tarefa de sensores
 #define TASK_PRIORITY_WEB         1      // Prioridade da tarefa web
+#define TASK_LOOP_PERIOD_MS       10     // Período da tarefa de sensores (100 Hz)
+#define WEB_TASK_IDLE_TIMEOUT_MS  50     // Espera máxima da tarefa web por dados novos (console e manutenção)
+#define WIFI_CHECK_INTERVAL_MS    1000   // Verificação do WiFi pela tarefa web
+#define MEMORY_STATS_INTERVAL_MS  30000  // Relatório de memória (DEBUG_MEMORY)
+
+// Jobs periódicos de manutenção (JobScheduler), expostos em /jobs e no comando "jobs"
+#define JOB_SCHEDULER_MAX_JOBS    16     // Jobs registrados (todos os cores)
+#define JOB_SCHEDULER_TICK_MS     10     // Resolução da roda de tempo
+#define JOB_SCHEDULER_WHEEL_BITS  6      // 64 posições por nível, 3 níveis (~7 h a 10 ms)
+
+// Pontualidade das tarefas periódicas (LoopTimingMonitor)
+#define LOOP_TIMING_MISS_US       1000   // Atraso de despertar que conta como prazo perdido (µs)
+
+// Contenção dos mutexes (InstrumentedMutex), exposta em /locks. Desligada,
+// take/give são só o semáforo: sem esp_timer nem contadores
+#ifndef LOCK_PROFILE_ENABLED
+#define LOCK_PROFILE_ENABLED      true
+#endif
+#define LOCK_PROFILE_MAX_LOCKS    12     // Mutexes instrumentados registrados
 
 // Debug
 #ifndef DEBUG_MODE
@@ -87,8 +122,13 @@ enum class LogLevel {
 // Nível mínimo para armazenamento em buffer circular
 #define LOG_LEVEL_MEMORY            LogLevel::WARN
 
-// Tamanho do buffer circular (número de mensagens)
-#define LOG_BUFFER_SIZE             50
+// Tamanho do anel de logs em memória (bytes). Registros têm tamanho
+// variável: 10 bytes de controle + texto da mensagem. Com a tabela de
+// módulos, ~14 KB: o mesmo que as 50 entradas fixas anteriores
+#define LOG_RING_BYTES              13824
+
+// Nomes de módulo distintos no anel de logs (o último agrupa os excedentes)
+#define LOG_MODULE_TABLE_SIZE       32
 
 // Tamanho máximo de uma mensagem de log (bytes)
 #define LOG_MAX_MESSAGE_SIZE        256
@@ -102,6 +142,117 @@ enum class LogLevel {
 // Tamanho máximo do nome de um módulo
 #define LOG_MODULE_NAME_MAX_SIZE    16
 
+// Linha de log formatada: prefixo de timestamp, nível e módulo + mensagem
+#define LOG_LINE_MAX_SIZE           (LOG_MAX_MESSAGE_SIZE + LOG_MODULE_NAME_MAX_SIZE + 32)
+
+// Nível mínimo de log compilado no firmware (valor numérico de LogLevel).
+// Chamadas abaixo dele são removidas em tempo de compilação, junto com a
+// avaliação de seus argumentos.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL           0
+#endif
+
+// Limitação de taxa por ponto de chamada (token bucket)
+#ifndef LOG_RATE_LIMIT_ENABLED
+#define LOG_RATE_LIMIT_ENABLED      true
+#endif
+#define LOG_RATE_LIMIT_BURST        5      // Mensagens em rajada por ponto de chamada
+#define LOG_RATE_LIMIT_REFILL_MS    1000   // Tempo para recuperar uma mensagem (ms)
+#define LOG_RATE_LIMIT_FLUSH_MS     5000   // Resumo das supressões pendentes (job "log.suppressed")
+#define LOG_RATE_LIMIT_PENDING      16     // Pontos de chamada com supressões aguardando resumo
+
+// Anel de transmissão do driver UART do console (bytes). Mensagens que não
+// cabem no espaço livre são descartadas em vez de bloquear quem escreve.
+#define CONSOLE_TX_BUFFER_SIZE      4096
+
+// Espera máxima pelo lock de escrita do console (ms)
+#define CONSOLE_WRITE_LOCK_MS       2
+
+// Espera máxima por espaço no anel para mensagens críticas (ms)
+#define CONSOLE_CRITICAL_WAIT_MS    50
+
+// Capacidade do autômato de filtragem do console (estados ≈ soma dos
+// tamanhos dos padrões bloqueados + 1; 8 bytes por estado)
+#define CONSOLE_FILTER_MAX_STATES   256
+
+// Perfil do heap (ambiente esp32dev_heap_profile): malloc/free são
+// interceptados e atribuídos à tarefa e ao ponto de chamada
+#ifndef HEAP_PROFILE_ENABLED
+#define HEAP_PROFILE_ENABLED        false
+#endif
+#define HEAP_PROFILE_MAX_LIVE       1024   // Blocos vivos rastreados (potência de 2)
+#define HEAP_PROFILE_MAX_MODULES    16     // Tarefas distintas
+#define HEAP_PROFILE_MAX_SITES      48     // Pontos de chamada distintos
+#define HEAP_PROFILE_SITE_DEPTH     3      // Endereços de retorno por ponto de chamada
+#define HEAP_PROFILE_TIMELINE_SIZE  288    // Amostras de fragmentação (24 h a cada 5 min)
+#define HEAP_PROFILE_SAMPLE_INTERVAL_MS 300000
+
+// Profiler de funções (ambiente esp32dev_profile, -finstrument-functions):
+// pilha de chamadas por tarefa e totais de ciclos por função
+#ifndef FUNCTION_PROFILE_ENABLED
+#define FUNCTION_PROFILE_ENABLED    false
+#endif
+#define PROFILE_MAX_FUNCTIONS       512    // Funções distintas (potência de 2)
+#define PROFILE_MAX_TASKS           8      // Tarefas com pilha própria (nunca liberadas)
+#define PROFILE_STACK_DEPTH         32     // Profundidade máxima rastreada por tarefa
+
+// Zonas de tempo (PROFILE_ZONE): histograma de latência em ciclos por zona,
+// consultado em /profile e pelo comando "profile" do console
+#ifndef PROFILE_ZONES_ENABLED
+#define PROFILE_ZONES_ENABLED       DEBUG_MODE
+#endif
+#define PROFILE_ZONE_SUB_BUCKET_BITS 2     // Sub-faixas por potência de 2 (erro ≤ 25%)
+
+// Trace de eventos em RAM (ambiente esp32dev_trace): um anel por core,
+// exportado em /trace e convertido por scripts/trace_to_chrome.py
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED               false
+#endif
+#define TRACE_RING_EVENTS           512    // Eventos por core (potência de 2, 16 bytes cada)
+#define TRACE_MAX_NAMES             64     // Nomes de eventos distintos
+#define TRACE_MAX_TASKS             16     // Tarefas distintas
+
+// Gravação das leituras brutas dos sensores (ambiente esp32dev_sensor_trace):
+// exportada em /sensors/trace e reproduzida no host pelo sensor_replay
+#ifndef SENSOR_TRACE_ENABLED
+#define SENSOR_TRACE_ENABLED        false
+#endif
+#ifndef SENSOR_TRACE_RECORDS
+#define SENSOR_TRACE_RECORDS        2048   // Leituras no anel (potência de 2, 12 bytes cada; ~6,8 min a 200 ms)
+#endif
+
+// Comandos de texto recebidos pela serial
+#define CONSOLE_COMMAND_MAX_LENGTH  64     // Tamanho máximo de uma linha de comando
+#define CONSOLE_MAX_COMMANDS        8      // Comandos registrados
+
+// Garantia de zero alocações em regime (ambiente esp32dev_alloc_guard):
+// após markBootComplete(), alocações dentro de ALLOC_GUARD_SCOPE são contadas
+#ifndef ALLOC_GUARD_ENABLED
+#define ALLOC_GUARD_ENABLED         false
+#endif
+#ifndef ALLOC_GUARD_BACKTRACE
+#define ALLOC_GUARD_BACKTRACE       DEBUG_MODE  // Imprime o backtrace de cada violação
+#endif
+#define ALLOC_GUARD_MAX_REPORTS     16     // Backtraces impressos por boot
+#define ALLOC_GUARD_BACKTRACE_DEPTH 8      // Quadros por backtrace
+
+// Log persistente em RTC RAM, recuperado após resets por software ou watchdog
+#define CRASH_LOG_RING_SIZE         2048   // Tamanho do anel em RTC RAM (bytes)
+#define CRASH_LOG_MAX_MESSAGE       96     // Tamanho máximo da mensagem por registro
+#define CRASH_LOG_LEVEL             LogLevel::INFO  // Nível mínimo gravado
+
+// Modo de formatação adiada: logs saem como quadros binários na serial
+// e são decodificados no host por scripts/deflog_decode.py
+#ifndef LOG_DEFERRED_MODE
+#define LOG_DEFERRED_MODE           false
+#endif
+
+// Tamanho do anel de quadros binários do modo diferido (bytes)
+#define DEFLOG_RING_SIZE            4096
+
+// Tamanho máximo de um argumento string no modo diferido (bytes)
+#define DEFLOG_MAX_STRING_ARG       32
+
 /**
  * Wrapper para impressão de depuração.
  *
@@ -0,0 +1,58 @@
+/**
+ * @file ConsoleCommands.h
+ * @brief Comandos de texto recebidos pela serial.
+ *
+ * poll() é chamado periodicamente por uma tarefa e lê, sem bloquear, os
+ * bytes disponíveis na serial. Cada linha completa é dividida em nome e
+ * argumentos e despachada ao comando registrado com aquele nome. O comando
+ * "help" lista os comandos registrados.
+ */
+
+#ifndef CONSOLE_COMMANDS_H
+#define CONSOLE_COMMANDS_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class ConsoleCommands
+ * @brief Tabela de comandos e leitor de linhas da serial.
+ */
+class ConsoleCommands {
+public:
+    /**
+     * @brief Função de um comando.
+     * @param args Texto após o nome do comando (vazio se não houver).
+     */
+    typedef void (*Handler)(const char* args);
+
+    /**
+     * @brief Registra um comando.
+     * @param name Nome do comando (literal, não é copiado).
+     * @param help Descrição exibida por "help".
+     * @param handler Função executada.
+     * @return false se a tabela está cheia.
+     */
+    static bool registerCommand(const char* name, const char* help, Handler handler);
+
+    /**
+     * @brief Lê os bytes disponíveis e executa as linhas completas.
+     */
+    static void poll();
+
+    /**
+     * @brief Escreve a resposta de um comando no console.
+     *
+     * Aguarda até CONSOLE_CRITICAL_WAIT_MS por espaço no anel, já que a
+     * saída foi pedida explicitamente.
+     */
+    static void printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+private:
+    ConsoleCommands() = delete;
+
+    static void execute(char* line);
+    static void printHelp(const char* args);
+};
+
+#endif // CONSOLE_COMMANDS_H
@@ -9,9 +9,11 @@
 #include <Arduino.h>
 #include <mutex>
 #include <esp_log.h>  // Para controle de logs do ESP-IDF
-#include <vector>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include "Config.h"
+#include "PatternMatcher.h"
+#include "InstrumentedMutex.h"
 
 /**
  * @enum MessagePriority
@@ -27,14 +29,19 @@ enum class MessagePriority {
 /**
  * @class ConsoleFilter
  * @brief Filtra e gerencia padrões de mensagens para controle de saída.
+ *
+ * Os padrões são compilados em um autômato Aho-Corasick pré-alocado, de modo
+ * que cada mensagem é verificada em uma única passada, sem uso de heap.
+ * Padrões devem ser registrados durante a inicialização.
  */
 class ConsoleFilter {
 public:
     /**
      * @brief Adiciona um padrão à lista de bloqueados.
      * @param pattern Padrão de texto a ser bloqueado.
+     * @return false se o autômato não tiver capacidade para o padrão.
      */
-    static void addBlockedPattern(const char* pattern);
+    static bool addBlockedPattern(const char* pattern);
 
     /**
      * @brief Verifica se uma mensagem deve ser filtrada.
@@ -44,10 +51,13 @@ public:
     static bool shouldFilter(const char* message);
 
     /**
-     * @brief Lista de padrões de texto a serem bloqueados.
-     * Tornado público para permitir acesso direto a partir do ConsoleManager.
+     * @brief Número de padrões bloqueados registrados.
+     * @return Quantidade de padrões distintos.
      */
-    static std::vector<String> s_blockedPatterns;
+    static size_t getPatternCount();
+
+private:
+    static PatternMatcher<CONSOLE_FILTER_MAX_STATES> s_matcher;
 };
 
 /**
@@ -195,12 +205,13 @@ private:
     };
 
     // Mutex para sincronização
-    SemaphoreHandle_t m_stateMutex;  ///< Protege o estado interno
-    SemaphoreHandle_t m_outputMutex; ///< Protege operações de saída
+    InstrumentedMutex m_stateMutex;  ///< Protege o estado interno
+    InstrumentedMutex m_outputMutex; ///< Protege operações de saída
 
     // Buffers e estado
     char m_lineBuffer[256];      ///< Buffer para formatação de mensagens
     char m_statusLineBuffer[256]; ///< Buffer dedicado para linha de status
+    char m_outputBuffer[384];    ///< Saída completa montada para uma única escrita
     LineState m_lineState;       ///< Estado atual da linha
     uint32_t m_lastOutputTime;   ///< Timestamp da última saída
     uint32_t m_activeReservation; ///< Token de reserva ativo (0 = nenhum)
@@ -233,13 +244,21 @@ private:
      * @param timeoutMs Timeout em milissegundos.
      * @return true se o mutex foi adquirido, false caso contrário.
      */
-    bool safeTakeMutex(SemaphoreHandle_t mutex, uint32_t timeoutMs = 100);
+    bool safeTakeMutex(InstrumentedMutex& mutex, uint32_t timeoutMs = 100);
 
     /**
      * @brief Libera mutex com verificação.
      * @param mutex Mutex a ser liberado.
      */
-    void safeGiveMutex(SemaphoreHandle_t mutex);
+    void safeGiveMutex(InstrumentedMutex& mutex);
+
+    /**
+     * @brief Envia m_outputBuffer ao console sem esperar a serial.
+     * @param length Tamanho retornado pelo snprintf que montou a saída.
+     * @param priority Prioridade da mensagem (críticas aguardam espaço).
+     * @return true se a saída foi enfileirada; false se foi descartada.
+     */
+    bool emit(int length, MessagePriority priority);
 
     /**
      * @brief Verifica se devemos mostrar uma linha em branco antes.
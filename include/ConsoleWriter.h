@@ -0,0 +1,84 @@
+/**
+ * @file ConsoleWriter.h
+ * @brief Escrita não bloqueante no console serial.
+ *
+ * O console usa o driver UART do ESP-IDF com um anel de transmissão grande,
+ * esvaziado por interrupção. Cada escrita apenas copia a mensagem para o
+ * anel: se não houver espaço, a mensagem inteira é descartada em vez de
+ * esperar a linha serial, e o descarte é contabilizado.
+ */
+
+#ifndef CONSOLE_WRITER_H
+#define CONSOLE_WRITER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class ConsoleWriter
+ * @brief Ponto único de saída para o console serial.
+ */
+class ConsoleWriter {
+public:
+    /**
+     * @brief Contadores de uso do console.
+     */
+    struct Stats {
+        uint32_t bytesQueued;       ///< Bytes aceitos no anel de transmissão
+        uint32_t bytesDropped;      ///< Bytes descartados por falta de espaço
+        uint32_t messagesDropped;   ///< Mensagens descartadas
+        uint32_t blockedMicros;     ///< Tempo total gasto dentro de write()
+        uint32_t maxBlockedMicros;  ///< Maior tempo de uma única chamada
+    };
+
+    /**
+     * @brief Instala o driver UART com o anel de transmissão e inicia a serial.
+     * @param baudRate Velocidade da serial.
+     */
+    static void begin(unsigned long baudRate);
+
+    /**
+     * @brief Enfileira uma mensagem inteira para transmissão.
+     *
+     * A mensagem é escrita por completo ou descartada, nunca parcialmente,
+     * para que a saída de tarefas diferentes não se misture.
+     *
+     * @param data Bytes a escrever.
+     * @param length Quantidade de bytes.
+     * @param timeoutMs Tempo máximo de espera por espaço (0 = descarta imediatamente).
+     * @return true se a mensagem foi enfileirada.
+     */
+    static bool write(const char* data, size_t length, uint32_t timeoutMs = 0);
+
+    /**
+     * @brief Enfileira uma string terminada em nulo.
+     * @param text Texto a escrever.
+     * @param timeoutMs Tempo máximo de espera por espaço.
+     * @return true se o texto foi enfileirado.
+     */
+    static bool write(const char* text, uint32_t timeoutMs = 0);
+
+    /**
+     * @brief Espaço livre no anel de transmissão.
+     * @return Bytes que podem ser enfileirados sem espera.
+     */
+    static size_t getFreeSpace();
+
+    /**
+     * @brief Aguarda a transmissão de todo o conteúdo enfileirado.
+     *
+     * Bloqueia até a linha serial esvaziar; uso restrito a reinicializações.
+     */
+    static void flush();
+
+    /**
+     * @brief Obtém uma cópia dos contadores.
+     * @return Contadores atuais.
+     */
+    static Stats getStats();
+
+private:
+    ConsoleWriter() = delete;
+};
+
+#endif // CONSOLE_WRITER_H
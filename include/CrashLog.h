@@ -0,0 +1,82 @@
+/**
+ * @file CrashLog.h
+ * @brief Anel de logs em RTC RAM que sobrevive a reinicializações.
+ *
+ * Os registros são gravados em memória RTC_NOINIT_ATTR, que não é zerada
+ * em resets por software, pânico ou watchdog. No boot seguinte o cabeçalho
+ * é validado por CRC e o conteúdo é copiado para RAM, ficando disponível
+ * em /logs?boot=previous. Após um power-on o CRC não confere e o anel é
+ * reiniciado.
+ */
+
+#ifndef CRASH_LOG_H
+#define CRASH_LOG_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class CrashLog
+ * @brief Log binário compacto para análise post-mortem.
+ *
+ * Cada registro ocupa: tamanho (1 byte), nível (1), timestamp (4),
+ * tamanho do módulo (1), módulo e mensagem sem terminador.
+ */
+class CrashLog {
+public:
+    /**
+     * @brief Recupera o anel do boot anterior e prepara o anel atual.
+     *
+     * Deve ser chamado no início do setup(), antes de qualquer log.
+     */
+    static void init();
+
+    /**
+     * @brief Grava um registro no anel em RTC RAM.
+     * @param level Nível de log.
+     * @param module Nome do módulo.
+     * @param message Mensagem já formatada.
+     */
+    static void append(LogLevel level, const char* module, const char* message);
+
+    /**
+     * @brief Formata a linha de cabeçalho do log do boot anterior,
+     *        seguida de uma linha vazia.
+     * @param buffer Buffer para o texto.
+     * @param maxSize Tamanho do buffer.
+     * @return Número de bytes escritos.
+     */
+    static size_t formatPreviousHeader(char* buffer, size_t maxSize);
+
+    /**
+     * @brief Formata um registro do boot anterior como uma linha de texto.
+     * @param index Posição do registro, do mais recente (0) ao mais antigo.
+     * @param buffer Buffer para o texto (LOG_LINE_MAX_SIZE nunca trunca).
+     * @param maxSize Tamanho do buffer.
+     * @return Número de bytes escritos, ou 0 se index não existe.
+     */
+    static size_t formatPreviousEntry(uint16_t index, char* buffer, size_t maxSize);
+
+    /**
+     * @brief Indica se registros do boot anterior foram recuperados.
+     * @return true se o anel anterior era válido.
+     */
+    static bool hasPreviousLog();
+
+    /**
+     * @brief Número de registros recuperados do boot anterior.
+     * @return Quantidade de registros.
+     */
+    static uint16_t getPreviousCount();
+
+    /**
+     * @brief Descreve o motivo do último reset.
+     * @return String estática com o motivo.
+     */
+    static const char* getResetReasonString();
+
+private:
+    CrashLog() = delete;
+};
+
+#endif // CRASH_LOG_H
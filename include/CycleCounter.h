@@ -0,0 +1,41 @@
+/**
+ * @file CycleCounter.h
+ * @brief Leitura do contador de ciclos do core (registrador CCOUNT do Xtensa).
+ *
+ * O contador é por core: intervalos medidos por tarefas que migram entre
+ * cores no meio da medição não são confiáveis. Quem mede em tarefas sem
+ * afinidade (como os handlers HTTP, na tarefa do AsyncTCP) precisa conferir
+ * xPortGetCoreID() no início e no fim, como faz ProfileZone::Scope.
+ */
+
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include <stdint.h>
+
+#if !defined(__XTENSA__)
+#include <chrono>
+#endif
+
+namespace CycleCounter {
+
+/**
+ * @brief Ciclos de clock do core atual (dá a volta a cada ~17 s a 240 MHz).
+ *
+ * Fora do ESP32 (ferramentas do host) retorna nanossegundos de um relógio
+ * monotônico, para que os mesmos cálculos de intervalo funcionem.
+ */
+static inline __attribute__((always_inline, no_instrument_function)) uint32_t now() {
+#if defined(__XTENSA__)
+    uint32_t count;
+    __asm__ __volatile__("rsr %0, ccount" : "=a"(count));
+    return count;
+#else
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+} // namespace CycleCounter
+
+#endif // CYCLE_COUNTER_H
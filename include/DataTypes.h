@@ -105,10 +105,20 @@ struct SystemStats {
     uint32_t uptime;            // Tempo de atividade em segundos
     uint16_t wifiRSSI;          // Força do sinal WiFi
     uint16_t sensorReadCount;   // Contagem de leituras de sensores
+    uint32_t hotPathAllocs;     // Alocações em caminhos críticos após o boot (AllocationGuard)
+    uint32_t sensorLoopLate;    // Maior atraso de despertar da tarefa de sensores na última janela (µs)
+    uint32_t sensorLoopMisses;  // Prazos perdidos pela tarefa de sensores desde o boot
+    uint16_t sensorLoopStreak;  // Maior sequência de prazos perdidos da tarefa de sensores
+    uint32_t webLoopLate;       // Maior atraso de despertar da tarefa web na última janela (µs)
+    uint32_t webLoopMisses;     // Prazos perdidos pela tarefa web desde o boot
+    uint16_t webLoopStreak;     // Maior sequência de prazos perdidos da tarefa web
 
     // Construtor com valores padrão
     SystemStats() : freeHeap(0), minFreeHeap(0), heapFragmentation(0),
-                cpuLoad(0), uptime(0), wifiRSSI(0), sensorReadCount(0) {}
+                cpuLoad(0), uptime(0), wifiRSSI(0), sensorReadCount(0),
+                hotPathAllocs(0), sensorLoopLate(0), sensorLoopMisses(0),
+                sensorLoopStreak(0), webLoopLate(0), webLoopMisses(0),
+                webLoopStreak(0) {}
 };
 
 #endif // DATA_TYPES_H
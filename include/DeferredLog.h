@@ -0,0 +1,250 @@
+/**
+ * @file DeferredLog.h
+ * @brief Logging com formatação adiada (estilo defmt/NanoLog).
+ *
+ * No modo diferido, cada chamada de log grava apenas o identificador da
+ * string de formato e os argumentos brutos em um anel binário, que é
+ * drenado para a serial como quadros compactos. O identificador é o
+ * endereço da string de formato no firmware (resolvido em tempo de link),
+ * e a ferramenta scripts/deflog_decode.py reconstrói o texto no host lendo
+ * as strings diretamente do firmware.elf.
+ *
+ * Formato do quadro na serial (little-endian):
+ *
+ *   [0]      DEFLOG_FRAME_SYNC
+ *   [1]      tamanho da carga (bytes entre [2] e o checksum)
+ *   [2]      nível de log (bit 7 = argumentos truncados)
+ *   [3..6]   timestamp em ms
+ *   [7..10]  endereço da string de formato
+ *   [11..14] endereço do nome do módulo
+ *   [15..]   argumentos brutos
+ *   [n]      checksum (XOR dos bytes da carga)
+ *
+ * Argumentos inteiros ocupam 4 bytes (8 para 64 bits), ponto flutuante é
+ * enviado como float de 4 bytes e strings como 1 byte de tamanho seguido
+ * de até DEFLOG_MAX_STRING_ARG bytes.
+ */
+
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <Arduino.h>
+#include <string.h>
+#include <type_traits>
+#include "Config.h"
+
+// Byte que inicia cada quadro binário na serial
+#define DEFLOG_FRAME_SYNC           0x1E
+
+// Bytes do cabeçalho do quadro (sync, tamanho, nível, timestamp, formato, módulo)
+#define DEFLOG_HEADER_SIZE          15
+
+// Espaço máximo para argumentos em um único quadro (bytes)
+#define DEFLOG_MAX_ARGS_SIZE        128
+
+// Tamanho máximo de um quadro completo, incluindo o checksum
+#define DEFLOG_MAX_FRAME_SIZE       (DEFLOG_HEADER_SIZE + DEFLOG_MAX_ARGS_SIZE + 1)
+
+// Flag no byte de nível indicando que os argumentos foram truncados
+#define DEFLOG_FLAG_TRUNCATED       0x80
+
+namespace DeferredLog {
+
+    /**
+     * Estatísticas do anel de registros diferidos.
+     */
+    struct Stats {
+        uint32_t framesWritten;   // Quadros aceitos no anel
+        uint32_t framesDropped;   // Quadros descartados por falta de espaço
+        uint32_t bytesWritten;    // Bytes entregues ao ConsoleWriter
+    };
+
+    /**
+     * Serializa argumentos brutos em um buffer de tamanho fixo.
+     *
+     * Ao faltar espaço, os argumentos restantes são descartados e o
+     * quadro é marcado como truncado.
+     */
+    class ArgEncoder {
+    public:
+        ArgEncoder(uint8_t* begin, uint8_t* end)
+            : m_pos(begin), m_end(end), m_truncated(false) {}
+
+        inline void putU32(uint32_t value) {
+            if (!reserve(sizeof(value))) return;
+            memcpy(m_pos, &value, sizeof(value));
+            m_pos += sizeof(value);
+        }
+
+        inline void putU64(uint64_t value) {
+            if (!reserve(sizeof(value))) return;
+            memcpy(m_pos, &value, sizeof(value));
+            m_pos += sizeof(value);
+        }
+
+        inline void putString(const char* value) {
+            if (!value) value = "(null)";
+
+            size_t len = strnlen(value, DEFLOG_MAX_STRING_ARG);
+            if (!reserve(len + 1)) return;
+
+            *m_pos++ = static_cast<uint8_t>(len);
+            memcpy(m_pos, value, len);
+            m_pos += len;
+        }
+
+        inline uint8_t* position() const { return m_pos; }
+        inline bool truncated() const { return m_truncated; }
+
+    private:
+        inline bool reserve(size_t size) {
+            if (m_truncated || m_pos + size > m_end) {
+                m_truncated = true;
+                return false;
+            }
+            return true;
+        }
+
+        uint8_t* m_pos;
+        uint8_t* m_end;
+        bool m_truncated;
+    };
+
+    // Inteiros de até 32 bits (inclui bool e char)
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && (sizeof(T) <= 4)>::type
+    encodeArg(ArgEncoder& enc, T value) {
+        enc.putU32(static_cast<uint32_t>(value));
+    }
+
+    // Inteiros de 64 bits (%lld / %llu)
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && (sizeof(T) > 4)>::type
+    encodeArg(ArgEncoder& enc, T value) {
+        enc.putU64(static_cast<uint64_t>(value));
+    }
+
+    // Enumerações são enviadas como inteiros
+    template <typename T>
+    inline typename std::enable_if<std::is_enum<T>::value>::type
+    encodeArg(ArgEncoder& enc, T value) {
+        enc.putU32(static_cast<uint32_t>(value));
+    }
+
+    // Ponto flutuante é reduzido para float (precisão suficiente para logs)
+    inline void encodeArg(ArgEncoder& enc, double value) {
+        float narrowed = static_cast<float>(value);
+        uint32_t bits;
+        memcpy(&bits, &narrowed, sizeof(bits));
+        enc.putU32(bits);
+    }
+
+    inline void encodeArg(ArgEncoder& enc, const char* value) {
+        enc.putString(value);
+    }
+
+    inline void encodeArg(ArgEncoder& enc, const void* value) {
+        enc.putU32(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value)));
+    }
+
+    inline void encodeArgs(ArgEncoder&) {}
+
+    template <typename T, typename... Rest>
+    inline void encodeArgs(ArgEncoder& enc, T first, Rest... rest) {
+        encodeArg(enc, first);
+        encodeArgs(enc, rest...);
+    }
+
+    /**
+     * Completa o cabeçalho de um quadro e o copia para o anel.
+     *
+     * @param level Nível de log.
+     * @param module Nome do módulo (o endereço é enviado).
+     * @param fmt String de formato (o endereço é enviado).
+     * @param frame Buffer do quadro com os argumentos já serializados.
+     * @param enc Codificador usado para os argumentos.
+     */
+    void commit(LogLevel level, const char* module, const char* fmt,
+                uint8_t* frame, const ArgEncoder& enc);
+
+    /**
+     * Registra uma mensagem sem formatá-la.
+     *
+     * @param level Nível de log.
+     * @param module Nome do módulo.
+     * @param fmt String de formato literal.
+     * @param args Argumentos brutos.
+     */
+    template <typename... Args>
+    inline void write(LogLevel level, const char* module, const char* fmt, Args... args) {
+        uint8_t frame[DEFLOG_MAX_FRAME_SIZE];
+        ArgEncoder enc(frame + DEFLOG_HEADER_SIZE, frame + DEFLOG_MAX_FRAME_SIZE - 1);
+        encodeArgs(enc, args...);
+        commit(level, module, fmt, frame, enc);
+    }
+
+    /**
+     * Formata uma mensagem para o buffer circular (via LogRouter).
+     *
+     * @param level Nível de log.
+     * @param module Nome do módulo.
+     * @param fmt String de formato.
+     * @param ... Argumentos já avaliados por emit().
+     */
+    void store(LogLevel level, const char* module, const char* fmt, ...);
+
+    /**
+     * Envia uma mensagem ao anel binário e, acima de LOG_LEVEL_MEMORY, ao
+     * buffer circular. Os argumentos da macro são avaliados uma única vez,
+     * na chamada, e as cópias seguem para os dois destinos.
+     *
+     * @param level Nível de log.
+     * @param module Nome do módulo.
+     * @param fmt String de formato literal.
+     * @param args Argumentos brutos.
+     */
+    template <typename... Args>
+    inline void emit(LogLevel level, const char* module, const char* fmt, Args... args) {
+        if (static_cast<int>(level) >= static_cast<int>(LOG_LEVEL_SERIAL)) {
+            write(level, module, fmt, args...);
+        }
+        if (static_cast<int>(level) >= static_cast<int>(LOG_LEVEL_MEMORY)) {
+            store(level, module, fmt, args...);
+        }
+    }
+
+    /**
+     * Cria a tarefa que drena o anel para a serial.
+     */
+    void begin();
+
+    /**
+     * Envia os quadros pendentes no anel pelo ConsoleWriter.
+     *
+     * @return Número de bytes enviados.
+     */
+    size_t drain();
+
+    /**
+     * Drena o anel completamente (usado antes de reiniciar).
+     */
+    void flush();
+
+    /**
+     * Obtém as estatísticas do anel.
+     *
+     * @return Cópia das estatísticas atuais.
+     */
+    Stats getStats();
+}
+
+/**
+ * Registra uma mensagem no modo diferido.
+ *
+ * Mensagens acima de LOG_LEVEL_MEMORY continuam sendo formatadas para o
+ * buffer circular, para que /logs funcione sem o decodificador.
+ */
+#define DEFLOG_WRITE(level, module, fmt, ...) \
+    DeferredLog::emit(level, module, fmt, ##__VA_ARGS__)
+
+#endif // DEFERRED_LOG_H
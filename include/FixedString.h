@@ -0,0 +1,167 @@
+/**
+ * @file FixedString.h
+ * @brief Strings de capacidade fixa para os caminhos críticos.
+ *
+ * Substitui a String do Arduino onde o texto é montado a cada ciclo: o
+ * armazenamento fica no próprio objeto (pilha ou membro), a capacidade é
+ * definida em compilação e o excesso é truncado e sinalizado em vez de
+ * realocar. Sem dependências do Arduino, para uso também no host.
+ */
+
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @class StringView
+ * @brief Referência não proprietária a um trecho de texto.
+ *
+ * Não copia nem garante terminação nula; quem a recebe usa data() e length().
+ */
+class StringView {
+public:
+    StringView() : m_data(""), m_length(0) {}
+    StringView(const char* text) : m_data(text ? text : ""), m_length(text ? strlen(text) : 0) {}
+    StringView(const char* data, size_t length) : m_data(data), m_length(length) {}
+
+    const char* data() const { return m_data; }
+    size_t length() const { return m_length; }
+    bool empty() const { return m_length == 0; }
+    char operator[](size_t index) const { return m_data[index]; }
+
+    bool operator==(StringView other) const {
+        return m_length == other.m_length && memcmp(m_data, other.m_data, m_length) == 0;
+    }
+    bool operator!=(StringView other) const { return !(*this == other); }
+
+private:
+    const char* m_data;
+    size_t m_length;
+};
+
+/**
+ * @class StringBuilder
+ * @brief Operações de escrita sobre um buffer de tamanho fixo.
+ *
+ * Base não template de FixedString: funções que montam texto recebem
+ * StringBuilder& e servem para qualquer capacidade. O conteúdo é sempre
+ * terminado em nulo; o que não couber é descartado e truncated() passa a
+ * retornar true.
+ */
+class StringBuilder {
+public:
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
+    const char* c_str() const { return m_buffer; }
+    size_t length() const { return m_length; }
+    size_t capacity() const { return m_capacity; }
+    size_t remaining() const { return m_capacity - m_length; }
+    bool empty() const { return m_length == 0; }
+    bool truncated() const { return m_truncated; }
+    StringView view() const { return StringView(m_buffer, m_length); }
+    operator StringView() const { return view(); }
+
+    void clear() {
+        m_length = 0;
+        m_truncated = false;
+        m_buffer[0] = '\0';
+    }
+
+    StringBuilder& append(const char* data, size_t length) {
+        if (length > remaining()) {
+            length = remaining();
+            m_truncated = true;
+        }
+        memcpy(&m_buffer[m_length], data, length);
+        m_length += length;
+        m_buffer[m_length] = '\0';
+        return *this;
+    }
+
+    StringBuilder& append(StringView text) { return append(text.data(), text.length()); }
+    StringBuilder& append(const char* text) { return append(StringView(text)); }
+    StringBuilder& append(char c) { return append(&c, 1); }
+
+    /**
+     * @brief Acrescenta texto formatado como printf.
+     * @return *this, para encadeamento.
+     */
+    StringBuilder& appendf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        appendv(fmt, args);
+        va_end(args);
+        return *this;
+    }
+
+    StringBuilder& appendv(const char* fmt, va_list args) {
+        int written = vsnprintf(&m_buffer[m_length], remaining() + 1, fmt, args);
+        if (written < 0) {
+            m_buffer[m_length] = '\0';
+            m_truncated = true;
+        } else if (static_cast<size_t>(written) > remaining()) {
+            m_length = m_capacity;
+            m_truncated = true;
+        } else {
+            m_length += written;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Interface de escrita do ArduinoJson: serializeJson(doc, str).
+     */
+    size_t write(uint8_t c) {
+        if (m_length == m_capacity) {
+            m_truncated = true;
+            return 0;
+        }
+        append(static_cast<char>(c));
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t length) {
+        size_t before = m_length;
+        append(reinterpret_cast<const char*>(data), length);
+        return m_length - before;
+    }
+
+protected:
+    StringBuilder(char* buffer, size_t capacity)
+        : m_buffer(buffer), m_capacity(capacity), m_length(0), m_truncated(false) {
+        m_buffer[0] = '\0';
+    }
+
+private:
+    char* m_buffer;
+    size_t m_capacity;   ///< Caracteres úteis, sem o terminador
+    size_t m_length;
+    bool m_truncated;
+};
+
+/**
+ * @class FixedString
+ * @brief String com até N caracteres armazenados no próprio objeto.
+ */
+template <size_t N>
+class FixedString : public StringBuilder {
+public:
+    static_assert(N > 0, "FixedString precisa de capacidade");
+
+    FixedString() : StringBuilder(m_storage, N) {}
+
+    explicit FixedString(StringView text) : StringBuilder(m_storage, N) {
+        append(text);
+    }
+
+private:
+    char m_storage[N + 1];
+};
+
+#endif // FIXED_STRING_H
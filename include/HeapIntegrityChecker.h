@@ -0,0 +1,73 @@
+/**
+ * @file HeapIntegrityChecker.h
+ * @brief Verificação incremental da integridade do heap em segundo plano.
+ *
+ * Em vez de percorrer o heap inteiro de uma vez, uma tarefa de baixa
+ * prioridade verifica uma região de heap por fatia, com um intervalo entre
+ * fatias. Cada fatia registra sua duração, de modo que o custo fica
+ * visível e nunca recai sobre o ciclo de sensores.
+ *
+ * A unidade de trabalho é a região inteira: heap_caps_check_integrity_addr
+ * percorre todos os blocos do heap que contém o endereço, e o IDF não
+ * oferece verificação de um trecho. Uma fatia custa, portanto, o mesmo que
+ * verificar a maior região (a DRAM principal, ~100-200 KB), não uma fração
+ * fixa do heap; maxSliceMicros e maxSliceBytes mostram esse pior caso.
+ */
+
+#ifndef HEAP_INTEGRITY_CHECKER_H
+#define HEAP_INTEGRITY_CHECKER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class HeapIntegrityChecker
+ * @brief Percorre as regiões de heap em rodízio, uma por fatia.
+ */
+class HeapIntegrityChecker {
+public:
+    /**
+     * @brief Progresso e custo das verificações.
+     */
+    struct Stats {
+        uint8_t regions;          ///< Regiões de heap verificadas em rodízio
+        uint8_t nextRegion;       ///< Próxima região a ser verificada
+        uint32_t slices;          ///< Fatias (regiões inteiras) verificadas
+        uint32_t passes;          ///< Passadas completas por todas as regiões
+        uint32_t failures;        ///< Fatias que encontraram corrupção
+        uint32_t lastSliceMicros; ///< Duração da verificação da última região
+        uint32_t maxSliceMicros;  ///< Maior duração da verificação de uma região
+        uint32_t maxSliceBytes;   ///< Tamanho da região que levou maxSliceMicros
+        uint32_t lastPassMicros;  ///< Soma das fatias da última passada completa
+        uint32_t lastPassTime;    ///< millis() ao fim da última passada
+    };
+
+    /**
+     * @brief Mapeia as regiões de heap e cria a tarefa de verificação.
+     *
+     * Faz uma verificação completa inicial: regiões que falham na sondagem
+     * com o heap íntegro não pertencem ao heap e são descartadas.
+     *
+     * @return true se a tarefa foi criada.
+     */
+    static bool begin();
+
+    /**
+     * @brief Obtém o progresso e o custo das verificações.
+     * @return Cópia dos contadores.
+     */
+    static Stats getStats();
+
+private:
+    HeapIntegrityChecker() = delete;
+
+    /**
+     * @brief Verifica a próxima região inteira e atualiza os contadores.
+     * @return false se a região está corrompida.
+     */
+    static bool runSlice();
+
+    static void taskFunc(void* parameters);
+};
+
+#endif // HEAP_INTEGRITY_CHECKER_H
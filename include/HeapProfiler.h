@@ -0,0 +1,104 @@
+/**
+ * @file HeapProfiler.h
+ * @brief Atribuição de alocações do heap e linha do tempo de fragmentação.
+ *
+ * Disponível apenas no ambiente esp32dev_heap_profile, que liga o firmware
+ * com -Wl,--wrap para malloc/calloc/realloc/free. Os wrappers (HeapHooks.cpp)
+ * registram cada bloco em tabelas de tamanho fixo, atribuindo-o à tarefa
+ * que o alocou e ao ponto de chamada (endereços de retorno). Nos demais
+ * ambientes nada disso é compilado.
+ */
+
+#ifndef HEAP_PROFILER_H
+#define HEAP_PROFILER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "Config.h"
+
+/**
+ * @class HeapProfiler
+ * @brief Contadores por tarefa e por ponto de chamada, em memória estática.
+ */
+class HeapProfiler {
+public:
+    /**
+     * @brief Contadores de uma tarefa (módulo de execução).
+     */
+    struct ModuleStats {
+        char name[configMAX_TASK_NAME_LEN];
+        uint32_t allocCount;
+        uint32_t freeCount;
+        uint32_t totalBytes;     ///< Bytes alocados desde o boot
+        uint32_t liveBytes;      ///< Bytes ainda não liberados
+        uint32_t peakLiveBytes;  ///< Maior valor de liveBytes
+    };
+
+    /**
+     * @brief Contadores de um ponto de chamada.
+     */
+    struct SiteStats {
+        uint32_t frames[HEAP_PROFILE_SITE_DEPTH];  ///< Endereços de retorno, do mais interno
+        uint32_t allocCount;
+        uint32_t freeCount;
+        uint32_t totalBytes;
+        uint32_t liveBytes;
+    };
+
+    /**
+     * @brief Amostra da linha do tempo de fragmentação.
+     */
+    struct TimelineSample {
+        uint32_t uptime;          ///< Segundos desde o boot
+        uint32_t freeHeap;
+        uint32_t largestBlock;
+        uint16_t liveBlocks;      ///< Blocos rastreados vivos
+        uint8_t fragmentation;    ///< Percentual
+    };
+
+    /**
+     * @brief Cópia consistente de todas as tabelas.
+     */
+    struct Snapshot {
+        ModuleStats modules[HEAP_PROFILE_MAX_MODULES];
+        SiteStats sites[HEAP_PROFILE_MAX_SITES];
+        TimelineSample timeline[HEAP_PROFILE_TIMELINE_SIZE];  ///< Do mais antigo ao mais recente
+        uint8_t moduleCount;
+        uint16_t siteCount;
+        uint16_t timelineCount;
+        uint16_t liveBlocks;
+        uint32_t untracked;       ///< Alocações fora das tabelas (tabelas cheias)
+    };
+
+    /**
+     * @brief Registra um bloco alocado.
+     * @param ptr Bloco retornado pelo alocador.
+     * @param size Tamanho solicitado.
+     * @param frames Endereços de retorno do ponto de chamada.
+     */
+    static void recordAlloc(void* ptr, size_t size, const uint32_t* frames);
+
+    /**
+     * @brief Registra a liberação de um bloco.
+     * @param ptr Bloco liberado.
+     */
+    static void recordFree(void* ptr);
+
+    /**
+     * @brief Grava uma amostra na linha do tempo, se o intervalo já passou.
+     *
+     * Chamado pelo MemoryManager a cada atualização de estatísticas.
+     */
+    static void sample();
+
+    /**
+     * @brief Copia todas as tabelas.
+     * @param snapshot Destino da cópia.
+     */
+    static void getSnapshot(Snapshot& snapshot);
+
+private:
+    HeapProfiler() = delete;
+};
+
+#endif // HEAP_PROFILER_H
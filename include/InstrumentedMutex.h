@@ -0,0 +1,136 @@
+/**
+ * @file InstrumentedMutex.h
+ * @brief Mutex do FreeRTOS com estatísticas de contenção por nome.
+ *
+ * Cada mutex nomeado conta aquisições, esperas e timeouts e mantém
+ * histogramas do tempo de espera e do tempo de posse (esp_timer, em µs),
+ * além da tarefa que o detém. Num timeout, guarda a tarefa que desistiu e
+ * a que segurava o mutex naquele momento. Os mutexes se registram ao serem
+ * criados; a rota /locks e o comando de console "locks" listam todos.
+ *
+ * Com TRACE_ENABLED, a espera de um mutex ocupado aparece no trace como
+ * um intervalo com o nome do mutex.
+ *
+ * Com LOCK_PROFILE_ENABLED falso (esp32dev_release), take/give só chamam o
+ * semáforo: os relatórios listam os mutexes e o dono, com contadores zerados.
+ */
+
+#ifndef INSTRUMENTED_MUTEX_H
+#define INSTRUMENTED_MUTEX_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+/**
+ * @class InstrumentedMutex
+ * @brief Invólucro fino de xSemaphoreCreateMutex com contadores.
+ */
+class InstrumentedMutex {
+public:
+    static constexpr uint8_t HISTOGRAM_BUCKETS = 6;
+
+    /**
+     * @brief Limites superiores (µs, exclusivos) das faixas dos histogramas;
+     *        a última faixa acumula os tempos maiores.
+     */
+    static const uint32_t HISTOGRAM_BOUNDS[HISTOGRAM_BUCKETS - 1];
+
+    /**
+     * @brief Contadores de um mutex.
+     */
+    struct Stats {
+        const char* name;
+        uint32_t acquisitions;          ///< Aquisições bem-sucedidas
+        uint32_t contended;             ///< Aquisições que precisaram esperar
+        uint32_t timeouts;              ///< Tentativas que desistiram
+        uint32_t maxWaitMicros;
+        uint32_t maxHoldMicros;
+        uint64_t totalWaitMicros;       ///< Inclui a espera das tentativas com timeout
+        uint64_t totalHoldMicros;
+        uint32_t waitHistogram[HISTOGRAM_BUCKETS];
+        uint32_t holdHistogram[HISTOGRAM_BUCKETS];
+        char owner[configMAX_TASK_NAME_LEN];             ///< Tarefa que detém o mutex ("" = livre)
+        char lastTimeoutWaiter[configMAX_TASK_NAME_LEN]; ///< Tarefa do último timeout
+        char lastTimeoutHolder[configMAX_TASK_NAME_LEN]; ///< Quem detinha o mutex nesse timeout
+    };
+
+    /**
+     * @brief Declara o mutex; o semáforo só é criado por create().
+     * @param name Nome literal do mutex (não é copiado).
+     */
+    explicit InstrumentedMutex(const char* name);
+    ~InstrumentedMutex();
+
+    InstrumentedMutex(const InstrumentedMutex&) = delete;
+    InstrumentedMutex& operator=(const InstrumentedMutex&) = delete;
+
+    /**
+     * @brief Cria o semáforo e registra o mutex para os relatórios.
+     * @return true se o mutex existe após a chamada.
+     */
+    bool create();
+
+    /**
+     * @brief Exclui o semáforo e remove o mutex dos relatórios.
+     */
+    void destroy();
+
+    bool isCreated() const { return m_handle != nullptr; }
+    const char* getName() const { return m_name; }
+
+    /**
+     * @brief Adquire o mutex.
+     * @param ticks Espera máxima (portMAX_DELAY para esperar sempre).
+     * @return true se o mutex foi adquirido.
+     */
+    bool take(TickType_t ticks);
+
+    /**
+     * @brief Libera o mutex adquirido por take(); ignorado se a tarefa
+     *        atual não o detém.
+     */
+    void give();
+
+    /**
+     * @brief Quantidade de mutexes registrados.
+     */
+    static uint8_t getCount();
+
+    /**
+     * @brief Copia os contadores de um mutex registrado.
+     * @param index Posição no registro (0 a getCount() - 1).
+     * @param stats Destino da cópia.
+     * @return false se a posição não existe.
+     */
+    static bool getStats(uint8_t index, Stats& stats);
+
+    /**
+     * @brief Zera os contadores de todos os mutexes (o dono atual é mantido).
+     */
+    static void resetAll();
+
+    /**
+     * @brief Comando de console "locks [reset]": imprime a tabela de mutexes.
+     * @param args Argumentos após o nome do comando.
+     */
+    static void printReport(const char* args);
+
+private:
+    static uint8_t bucketOf(uint32_t micros);
+    void clear();
+
+    const char* m_name;
+    SemaphoreHandle_t m_handle;
+    TaskHandle_t m_owner;
+    int64_t m_acquiredAt;               ///< Escrito só por quem detém o mutex
+    portMUX_TYPE m_lock;                ///< Protege m_stats e m_owner deste mutex
+#if TRACE_ENABLED
+    uint8_t m_traceName;
+#endif
+    Stats m_stats;
+};
+
+#endif // INSTRUMENTED_MUTEX_H
@@ -38,6 +38,26 @@ struct IrrigationData {
                       lastDecisionTime(0) {}
 };
 
+/**
+ * @struct IrrigationTuning
+ * @brief Parâmetros da decisão automática de irrigação.
+ *
+ * Os padrões vêm do Config.h. Trocá-los em tempo de execução permite ajustar
+ * o controle sem recompilar, como faz a varredura de parâmetros do host.
+ */
+struct IrrigationTuning {
+    float thresholdLow;           ///< Umidade abaixo da qual a bomba liga (%)
+    float thresholdHigh;          ///< Umidade a partir da qual a bomba desliga (%)
+    uint32_t minInterval;         ///< Intervalo mínimo entre ativações automáticas (ms)
+    uint32_t maxRuntime;          ///< Duração máxima de uma ativação automática (ms)
+
+    // Construtor com valores padrão
+    IrrigationTuning() : thresholdLow(MOISTURE_THRESHOLD_LOW),
+                         thresholdHigh(MOISTURE_THRESHOLD_HIGH),
+                         minInterval(IRRIGATION_MIN_INTERVAL),
+                         maxRuntime(IRRIGATION_MAX_RUNTIME) {}
+};
+
 /**
  * @class IrrigationController
  * @brief Controlador principal do sistema de irrigação com lógica inteligente.
@@ -145,6 +165,24 @@ public:
      */
     bool resetEmergency();
 
+    /**
+     * @brief Substitui os parâmetros da decisão automática.
+     *
+     * Rejeita limiares fora de 0-100% ou invertidos e durações acima de
+     * IRRIGATION_MAX_RUNTIME, que continua valendo como limite de segurança.
+     *
+     * @param tuning Novos parâmetros.
+     * @return true se os parâmetros foram aceitos.
+     */
+    bool setTuning(const IrrigationTuning& tuning);
+
+    /**
+     * @brief Obtém os parâmetros atuais da decisão automática.
+     *
+     * @return Referência constante aos parâmetros.
+     */
+    const IrrigationTuning& getTuning() const;
+
     /**
      * @brief Verifica se o sistema está inicializado.
      *
@@ -202,6 +240,7 @@ private:
 
     // Dados do sistema
     IrrigationData m_data;              ///< Dados principais
+    IrrigationTuning m_tuning;          ///< Parâmetros da decisão automática
     bool m_initialized;                 ///< Flag de inicialização
     uint32_t m_scheduledStopTime;       ///< Tempo programado para parar
     uint32_t m_lastRuntimeUpdate;       ///< Última atualização de runtime
@@ -0,0 +1,104 @@
+/**
+ * @file JobScheduler.h
+ * @brief Tarefas periódicas de manutenção numa roda de tempo hierárquica.
+ *
+ * Cada job declara período, fase e core. Cada core tem a sua roda, avançada
+ * pela tarefa que roda nele (sensores ou web) a cada ciclo com run(). A roda
+ * tem três níveis de 2^JOB_SCHEDULER_WHEEL_BITS posições: o primeiro em
+ * ticks de JOB_SCHEDULER_TICK_MS e os seguintes em voltas do anterior. Os
+ * jobs ficam em listas encadeadas por índice dentro das posições, então
+ * inserir e vencer custam O(1). Um job só desce de nível quando a roda de
+ * baixo completa uma volta.
+ *
+ * O job vence nos instantes t com t % período == fase, contados no relógio
+ * do esp_timer. Se a tarefa atrasar mais de um período, os vencimentos
+ * perdidos são contados e não executados: o job roda uma vez e volta à sua
+ * grade. Para cada job ficam o tempo de execução e o atraso em relação ao
+ * vencimento (µs), consultados em /jobs e pelo comando de console "jobs".
+ */
+
+#ifndef JOB_SCHEDULER_H
+#define JOB_SCHEDULER_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include <freertos/FreeRTOS.h>
+
+/**
+ * @class JobScheduler
+ * @brief Registro e execução dos jobs periódicos por core.
+ */
+class JobScheduler {
+public:
+    typedef void (*Handler)(void* context);
+
+    static constexpr uint8_t CORE_COUNT = portNUM_PROCESSORS;
+    static constexpr int8_t INVALID_JOB = -1;
+
+    /**
+     * @brief Configuração e contadores de um job.
+     */
+    struct Stats {
+        const char* name;
+        uint32_t periodMs;
+        uint32_t phaseMs;
+        uint8_t core;
+        uint32_t runs;                  ///< Execuções
+        uint32_t skipped;               ///< Vencimentos perdidos por atraso maior que o período
+        uint32_t lastRunMicros;
+        uint32_t maxRunMicros;
+        uint64_t totalRunMicros;
+        uint32_t lastLateMicros;        ///< Atraso da última execução em relação ao vencimento
+        uint32_t maxLateMicros;
+        uint64_t totalLateMicros;
+    };
+
+    /**
+     * @brief Registra um job periódico.
+     *
+     * O período e a fase são arredondados para ticks de JOB_SCHEDULER_TICK_MS.
+     *
+     * @param name Nome literal do job (não é copiado).
+     * @param periodMs Período de execução.
+     * @param phaseMs Deslocamento dentro do período, para espalhar jobs de mesmo período.
+     * @param core Core cuja tarefa executa o job (TASK_SENSOR_CORE ou TASK_WEB_CORE).
+     * @param handler Função executada no vencimento.
+     * @param context Argumento repassado ao handler.
+     * @return Índice do job, ou INVALID_JOB se a tabela estiver cheia.
+     */
+    static int8_t add(const char* name, uint32_t periodMs, uint32_t phaseMs, uint8_t core,
+                      Handler handler, void* context = nullptr);
+
+    /**
+     * @brief Executa os jobs vencidos do core. Chamar a cada ciclo da tarefa
+     *        do core, fora de mutexes.
+     * @param core Core da tarefa chamadora.
+     */
+    static void run(uint8_t core);
+
+    /**
+     * @brief Quantidade de jobs registrados.
+     */
+    static uint8_t getCount();
+
+    /**
+     * @brief Copia a configuração e os contadores de um job.
+     * @return false se o índice não existe.
+     */
+    static bool getStats(uint8_t index, Stats& stats);
+
+    /**
+     * @brief Zera os contadores de todos os jobs.
+     */
+    static void resetStats();
+
+    /**
+     * @brief Comando de console "jobs": imprime a tabela; "jobs reset" zera.
+     */
+    static void printReport(const char* args);
+
+private:
+    JobScheduler() = delete;
+};
+
+#endif // JOB_SCHEDULER_H
@@ -8,21 +8,13 @@
 
 #include <Arduino.h>
 #include <vector>
+#include <atomic>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include "Config.h"
 #include "ConsoleFormat.h"
-
-/**
- * @struct LogEntry
- * @brief Estrutura para armazenar uma entrada de log no buffer circular.
- */
-struct LogEntry {
-    uint32_t timestamp;               ///< Timestamp em milissegundos
-    LogLevel level;                   ///< Nível de log
-    char module[LOG_MODULE_NAME_MAX_SIZE]; ///< Nome do módulo de origem
-    char message[LOG_MAX_MESSAGE_SIZE];   ///< Mensagem de log
-};
+#include "DeferredLog.h"
+#include "InstrumentedMutex.h"
 
 /**
  * @struct TelemetrySession
@@ -35,12 +27,94 @@ struct TelemetrySession {
     bool active;                      ///< Indica se a sessão está ativa
 };
 
+/**
+ * @struct LogRateLimiter
+ * @brief Token bucket de um ponto de chamada de log.
+ *
+ * Não possui construtor: as instâncias estáticas criadas pelas macros LOG_*
+ * são zeradas na carga do firmware e dispensam guardas de inicialização.
+ * O estado é atualizado por compare-and-swap, sem lock compartilhado entre
+ * pontos de chamada; o estado zerado equivale a um bucket cheio.
+ *
+ * A primeira supressão enfileira o ponto de chamada; flushPending() resume
+ * as contagens pendentes, para que uma rajada seguida de silêncio também
+ * seja relatada.
+ */
+struct LogRateLimiter {
+    std::atomic<uint32_t> state;      ///< Intervalo do último consumo << 4 | tokens gastos
+    std::atomic<uint32_t> suppressed; ///< Mensagens suprimidas desde a última emitida
+    std::atomic<bool> queued;         ///< Na fila de flushPending()
+    const char* module;               ///< Módulo do ponto de chamada (para o resumo)
+    uint8_t level;                    ///< Nível do ponto de chamada (para o resumo)
+
+    /**
+     * @brief Consome um token, se disponível.
+     * @param suppressedOut Recebe quantas mensagens foram suprimidas antes desta.
+     * @param callLevel Nível do ponto de chamada.
+     * @param callModule Módulo do ponto de chamada (literal).
+     * @return true se a mensagem deve ser emitida.
+     */
+    bool allow(uint32_t* suppressedOut, LogLevel callLevel, const char* callModule);
+
+    /**
+     * @brief Job "log.suppressed": emite uma linha por ponto de chamada
+     *        com mensagens suprimidas ainda não relatadas.
+     * @param context Não utilizado.
+     */
+    static void flushPending(void*);
+};
+
 /**
  * @class CircularLogBuffer
- * @brief Implementa um buffer circular para armazenamento de logs.
+ * @brief Anel de bytes com registros de tamanho variável.
+ *
+ * Cada registro ocupa apenas o texto da mensagem mais um cabeçalho de 8
+ * bytes (tamanho, timestamp, nível, módulo) e um rodapé de 2 bytes com o
+ * tamanho, que permite percorrer o anel do mais recente ao mais antigo. Os
+ * nomes de módulo são internados em uma tabela e gravados como um índice.
+ * Registros antigos são descartados conforme novos chegam.
  */
 class CircularLogBuffer {
 public:
+    /**
+     * @struct Record
+     * @brief Registro lido do anel.
+     */
+    struct Record {
+        uint32_t timestamp;                 ///< Timestamp em milissegundos
+        LogLevel level;                     ///< Nível de log
+        const char* module;                 ///< Nome do módulo (tabela interna, vida útil do firmware)
+        uint16_t length;                    ///< Tamanho da mensagem
+        char message[LOG_MAX_MESSAGE_SIZE]; ///< Mensagem terminada em nulo
+    };
+
+    /**
+     * @class Iterator
+     * @brief Percorre os registros do mais recente ao mais antigo.
+     *
+     * Cada passo copia um registro sob o lock do anel. Se escritores
+     * concorrentes descartarem o registro que seria lido, a iteração
+     * termina em vez de ler dados sobrescritos.
+     */
+    class Iterator {
+    public:
+        /**
+         * @brief Lê o próximo registro (mais antigo que o anterior).
+         * @param record Destino do registro.
+         * @return false quando não há mais registros válidos.
+         */
+        bool next(Record& record);
+
+    private:
+        friend class CircularLogBuffer;
+        Iterator(CircularLogBuffer& buffer, size_t end, uint32_t sequence)
+            : m_buffer(buffer), m_end(end), m_sequence(sequence) {}
+
+        CircularLogBuffer& m_buffer;
+        size_t m_end;           ///< Posição logo após o próximo registro
+        uint32_t m_sequence;    ///< Sequência do próximo registro + 1
+    };
+
     /**
      * @brief Obtém a instância única do buffer circular.
      * @return Referência à instância singleton.
@@ -48,31 +122,70 @@ public:
     static CircularLogBuffer& getInstance();
 
     /**
-     * @brief Adiciona uma entrada ao buffer circular.
-     * @param entry Entrada de log a ser adicionada.
+     * @brief Adiciona um registro ao anel.
+     * @param level Nível de log.
+     * @param module Nome do módulo de origem.
+     * @param message Mensagem já formatada.
+     */
+    void addEntry(LogLevel level, const char* module, const char* message);
+
+    /**
+     * @brief Cria um iterador a partir do registro mais recente.
+     * @return Iterador posicionado no registro mais recente.
      */
-    void addEntry(const LogEntry& entry);
+    Iterator newest();
 
     /**
-     * @brief Obtém as entradas armazenadas no buffer.
-     * @param buffer Buffer para armazenar as entradas formatadas.
-     * @param maxSize Tamanho máximo do buffer.
-     * @return Número de bytes escritos no buffer.
+     * @brief Formata a linha de cabeçalho do log, seguida de uma linha vazia.
+     * @param buffer Destino do texto.
+     * @param maxSize Tamanho do buffer.
+     * @return Número de bytes escritos (truncado se não couber).
      */
-    size_t getEntries(char* buffer, size_t maxSize);
+    size_t formatHeader(char* buffer, size_t maxSize);
+
+    /**
+     * @brief Formata um registro como uma linha de texto terminada em '\n'.
+     * @param record Registro lido por um Iterator.
+     * @param buffer Destino do texto.
+     * @param maxSize Tamanho do buffer (LOG_LINE_MAX_SIZE nunca trunca).
+     * @return Número de bytes escritos (truncado se não couber).
+     */
+    static size_t formatRecord(const Record& record, char* buffer, size_t maxSize);
+
+    /**
+     * @brief Número de registros atualmente no anel.
+     * @return Quantidade de registros.
+     */
+    size_t getCount();
 
 private:
     CircularLogBuffer();
-    ~CircularLogBuffer();
 
     // Impede cópia e atribuição
     CircularLogBuffer(const CircularLogBuffer&) = delete;
     CircularLogBuffer& operator=(const CircularLogBuffer&) = delete;
 
-    // Dados do buffer
-    LogEntry m_entries[LOG_BUFFER_SIZE];   ///< Buffer circular de entradas
+    // Índice do módulo na tabela, registrando-o se necessário (fora do lock do anel)
+    uint8_t internModule(const char* module);
+
+    // Cópia de/para o anel, tratando a volta ao início
+    void copyIn(size_t position, const void* data, size_t length);
+    void copyOut(size_t position, void* data, size_t length) const;
+
+    // Dados do anel
+    uint8_t m_ring[LOG_RING_BYTES];        ///< Registros de tamanho variável
     size_t m_head;                         ///< Posição da próxima escrita
-    SemaphoreHandle_t m_mutex;             ///< Mutex para acesso thread-safe
+    size_t m_used;                         ///< Bytes ocupados por registros
+    uint32_t m_firstSequence;              ///< Sequência do registro mais antigo
+    uint32_t m_nextSequence;               ///< Sequência do próximo registro
+    portMUX_TYPE m_lock;                   ///< Protege o anel
+
+    // Tabela de módulos internados. Só cresce: as entradas são escritas
+    // antes de m_moduleCount ser publicado, e a leitura dispensa lock
+    char m_modules[LOG_MODULE_TABLE_SIZE][LOG_MODULE_NAME_MAX_SIZE];
+    const char* m_moduleKeys[LOG_MODULE_TABLE_SIZE];  ///< Ponteiro visto no registro (confirmado pelo nome)
+    std::atomic<uint8_t> m_moduleCount;
+    portMUX_TYPE m_moduleLock;             ///< Serializa apenas novos registros
 
     // Instância singleton
     static CircularLogBuffer* s_instance;
@@ -124,7 +237,7 @@ private:
     // Dados de telemetria
     TelemetrySession m_sessions[MAX_TELEMETRY_SESSIONS]; ///< Sessões ativas
     uint32_t m_nextToken;                               ///< Próximo token a ser atribuído
-    SemaphoreHandle_t m_mutex;                          ///< Mutex para acesso thread-safe
+    InstrumentedMutex m_mutex;                          ///< Mutex para acesso thread-safe
 
     // Métodos auxiliares
     TelemetrySession* findSession(uint32_t token);
@@ -155,12 +268,25 @@ public:
     void log(LogLevel level, const char* module, const char* fmt, ...);
 
     /**
-     * @brief Obtém logs armazenados em buffer.
-     * @param buffer Buffer para armazenar logs.
-     * @param maxSize Tamanho máximo do buffer.
-     * @return Número de bytes escritos no buffer.
+     * @brief Registra uma mensagem apenas no buffer circular.
+     *
+     * Usado pelo modo diferido, em que a saída serial é binária.
+     *
+     * @param level Nível de log.
+     * @param module Nome do módulo (opcional).
+     * @param fmt String de formato.
+     * @param ... Argumentos variáveis.
+     */
+    void store(LogLevel level, const char* module, const char* fmt, ...);
+
+    /**
+     * @brief Variante de store() com va_list.
+     * @param level Nível de log.
+     * @param module Nome do módulo (opcional).
+     * @param fmt String de formato.
+     * @param args Argumentos variáveis.
      */
-    size_t getStoredLogs(char* buffer, size_t maxSize);
+    void storeV(LogLevel level, const char* module, const char* fmt, va_list args);
 
     /**
      * @brief Inicia uma sessão de telemetria.
@@ -207,17 +333,58 @@ private:
     LogRouter(const LogRouter&) = delete;
     LogRouter& operator=(const LogRouter&) = delete;
 
+    // Copia uma mensagem já formatada para o buffer circular
+    void storeEntry(LogLevel level, const char* module, const char* message);
+
     // Instância singleton
     static LogRouter* s_instance;
 };
 
+// Emissão efetiva de uma mensagem, conforme o modo de log
+#if LOG_DEFERRED_MODE
+#define LOG_EMIT(level, module, fmt, ...) DEFLOG_WRITE(level, module, fmt, ##__VA_ARGS__)
+#else
+#define LOG_EMIT(level, module, fmt, ...) LogRouter::getInstance().log(level, module, fmt, ##__VA_ARGS__)
+#endif
+
+// Nível aceito por algum destino (serial ou buffer circular)
+#define LOG_LEVEL_ACTIVE(level) \
+    (static_cast<int>(level) >= static_cast<int>(LOG_LEVEL_SERIAL) || \
+     static_cast<int>(level) >= static_cast<int>(LOG_LEVEL_MEMORY))
+
+/**
+ * Registra uma mensagem em um nível fixo.
+ *
+ * Níveis abaixo de LOG_COMPILE_LEVEL resultam em uma condição constante
+ * falsa e o compilador descarta a chamada e seus argumentos. Níveis que
+ * nenhum destino aceita são testados antes do bucket e não consomem
+ * tokens. Cada ponto de chamada tem seu próprio token bucket: mensagens
+ * excedentes são contadas e resumidas em uma única linha quando o bucket
+ * se recupera, ou pelo job "log.suppressed" a cada LOG_RATE_LIMIT_FLUSH_MS
+ * se o ponto silenciar. FATAL nunca é suprimido.
+ */
+#define LOG_AT(level, module, fmt, ...) do { \
+    if (static_cast<int>(level) >= LOG_COMPILE_LEVEL && LOG_LEVEL_ACTIVE(level)) { \
+        static LogRateLimiter _logLimiter; \
+        uint32_t _logSuppressed = 0; \
+        if (!LOG_RATE_LIMIT_ENABLED || (level) == LogLevel::FATAL || \
+            _logLimiter.allow(&_logSuppressed, level, module)) { \
+            if (_logSuppressed > 0) { \
+                LOG_EMIT(level, module, "%u mensagens anteriores deste ponto suprimidas", \
+                         (unsigned)_logSuppressed); \
+            } \
+            LOG_EMIT(level, module, fmt, ##__VA_ARGS__); \
+        } \
+    } \
+} while (0)
+
 // Macros para facilitar o uso
-#define LOG_TRACE(module, fmt, ...) LogRouter::getInstance().log(LogLevel::TRACE, module, fmt, ##__VA_ARGS__)
-#define LOG_DEBUG(module, fmt, ...) LogRouter::getInstance().log(LogLevel::DEBUG, module, fmt, ##__VA_ARGS__)
-#define LOG_INFO(module, fmt, ...)  LogRouter::getInstance().log(LogLevel::INFO, module, fmt, ##__VA_ARGS__)
-#define LOG_WARN(module, fmt, ...)  LogRouter::getInstance().log(LogLevel::WARN, module, fmt, ##__VA_ARGS__)
-#define LOG_ERROR(module, fmt, ...) LogRouter::getInstance().log(LogLevel::ERROR, module, fmt, ##__VA_ARGS__)
-#define LOG_FATAL(module, fmt, ...) LogRouter::getInstance().log(LogLevel::FATAL, module, fmt, ##__VA_ARGS__)
+#define LOG_TRACE(module, fmt, ...) LOG_AT(LogLevel::TRACE, module, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(module, fmt, ...) LOG_AT(LogLevel::DEBUG, module, fmt, ##__VA_ARGS__)
+#define LOG_INFO(module, fmt, ...)  LOG_AT(LogLevel::INFO, module, fmt, ##__VA_ARGS__)
+#define LOG_WARN(module, fmt, ...)  LOG_AT(LogLevel::WARN, module, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(module, fmt, ...) LOG_AT(LogLevel::ERROR, module, fmt, ##__VA_ARGS__)
+#define LOG_FATAL(module, fmt, ...) LOG_AT(LogLevel::FATAL, module, fmt, ##__VA_ARGS__)
 
 // Macros para telemetria
 #define TELEMETRY_BEGIN(name) LogRouter::getInstance().beginTelemetry(name)
@@ -0,0 +1,113 @@
+/**
+ * @file LoopTimingMonitor.h
+ * @brief Pontualidade das tarefas de sensores e web.
+ *
+ * A tarefa de sensores acorda por vTaskDelayUntil a cada TASK_LOOP_PERIOD_MS.
+ * A cada despertar, o monitor compara o instante real (esp_timer, em µs) com
+ * o instante previsto pelo tick de referência e registra o atraso num
+ * histograma. A tarefa web acorda por notificação quando há dados novos; o
+ * atraso registrado é o tempo entre a notificação e o despertar. Atrasos a
+ * partir de LOOP_TIMING_MISS_US contam como prazo perdido: o ciclo anterior
+ * passou do prazo ou a tarefa ficou sem CPU.
+ */
+
+#ifndef LOOP_TIMING_MONITOR_H
+#define LOOP_TIMING_MONITOR_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include <freertos/FreeRTOS.h>
+
+/**
+ * @class LoopTimingMonitor
+ * @brief Atraso de despertar, perdas de prazo e histograma por tarefa.
+ */
+class LoopTimingMonitor {
+public:
+    /**
+     * @brief Tarefas monitoradas.
+     */
+    enum Loop : uint8_t {
+        SENSOR_LOOP = 0,
+        WEB_LOOP,
+        LOOP_COUNT
+    };
+
+    static constexpr uint8_t HISTOGRAM_BUCKETS = 8;
+
+    /**
+     * @brief Limites superiores (µs, exclusivos) das faixas do histograma;
+     *        a última faixa acumula os atrasos maiores.
+     */
+    static const uint32_t HISTOGRAM_BOUNDS[HISTOGRAM_BUCKETS - 1];
+
+    /**
+     * @brief Contadores de uma tarefa.
+     */
+    struct Stats {
+        uint32_t wakes;                 ///< Despertares registrados
+        uint32_t lastLateMicros;        ///< Atraso do último despertar
+        uint32_t maxLateMicros;         ///< Maior atraso desde o boot
+        uint32_t windowMaxLateMicros;   ///< Maior atraso desde a última takeWindowMax()
+        uint32_t overruns;              ///< Despertares com prazo perdido
+        uint16_t missStreak;            ///< Prazos perdidos consecutivos até agora
+        uint16_t maxMissStreak;         ///< Maior sequência de prazos perdidos
+        uint32_t histogram[HISTOGRAM_BUCKETS];
+    };
+
+    /**
+     * @brief Define a referência de tempo de uma tarefa.
+     *
+     * Deve receber o mesmo valor usado para iniciar o xLastWakeTime de
+     * vTaskDelayUntil. O instante correspondente em µs é tomado no primeiro
+     * onWake(), que acontece num limite de tick e não é contado.
+     *
+     * @param loop Tarefa monitorada.
+     * @param startTick Tick de referência.
+     */
+    static void begin(Loop loop, TickType_t startTick);
+
+    /**
+     * @brief Registra um despertar. Chamar logo após vTaskDelayUntil.
+     * @param loop Tarefa monitorada.
+     * @param expectedTick xLastWakeTime atualizado por vTaskDelayUntil.
+     */
+    static void onWake(Loop loop, TickType_t expectedTick);
+
+    /**
+     * @brief Registra um despertar por notificação.
+     * @param loop Tarefa monitorada.
+     * @param signaledMicros esp_timer_get_time() (32 bits baixos) no envio da notificação.
+     */
+    static void onSignal(Loop loop, uint32_t signaledMicros);
+
+    /**
+     * @brief Obtém uma cópia dos contadores.
+     * @param loop Tarefa monitorada.
+     * @return Contadores atuais.
+     */
+    static Stats getStats(Loop loop);
+
+    /**
+     * @brief Retorna e zera o maior atraso da janela atual.
+     * @param loop Tarefa monitorada.
+     * @return Maior atraso (µs) desde a chamada anterior.
+     */
+    static uint32_t takeWindowMax(Loop loop);
+
+    /**
+     * @brief Nome da tarefa para relatórios.
+     */
+    static const char* getName(Loop loop);
+
+    /**
+     * @brief Comando de console "loops": imprime contadores e histogramas.
+     * @param args Ignorado.
+     */
+    static void printReport(const char* args);
+
+private:
+    LoopTimingMonitor() = delete;
+};
+
+#endif // LOOP_TIMING_MONITOR_H
@@ -9,6 +9,7 @@
 #include <Arduino.h>
 #include "Config.h"
 #include "DataTypes.h"
+#include "ObjectPool.h"
 
 /**
  * Classe para gerenciamento de memória
@@ -21,35 +22,17 @@ private:
     // Singleton
     static MemoryManager *s_instance;
 
-    // Timestamp da última verificação
-    uint32_t m_lastCheckTime;
-
     // Estatísticas de memória
     SystemStats m_stats;
 
-    /**
-     * Pool de objetos SensorData
-     * Pré-aloca objetos para evitar alocação dinâmica frequente
-     */
-    struct SensorDataPool {
-        static constexpr uint8_t POOL_SIZE = 10;
-        SensorData items[POOL_SIZE];
-        bool inUse[POOL_SIZE];
-
-        SensorDataPool() {
-            // Inicializa todos como livres
-            for (uint8_t i = 0; i < POOL_SIZE; i++) {
-                inUse[i] = false;
-            }
-        }
+    // Buffer JSON como tipo próprio, para ser gerenciado por um pool
+    struct JsonBuffer {
+        char data[JSON_BUFFER_SIZE];
     };
 
-    // Pools de objetos
-    SensorDataPool m_sensorDataPool;
-
-    // Buffer JSON estático para evitar alocação dinâmica
-    char m_jsonBuffer[JSON_BUFFER_SIZE];
-    bool m_jsonBufferInUse;
+    // Pools de objetos pré-alocados, seguros entre tarefas e núcleos
+    ObjectPool<SensorData, SENSOR_DATA_POOL_SIZE> m_sensorDataPool;
+    ObjectPool<JsonBuffer, JSON_BUFFER_POOL_SIZE> m_jsonBufferPool;
 
     // Construtor privado (singleton)
     MemoryManager();
@@ -85,21 +68,37 @@ public:
     bool releaseSensorData(SensorData *data);
 
     /**
-     * Adquire o buffer JSON.
+     * Adquire um buffer JSON de JSON_BUFFER_SIZE bytes.
      *
-     * @return Ponteiro para o buffer, ou nullptr se estiver em uso.
+     * @return Ponteiro para o buffer, ou nullptr se todos estiverem em uso.
      */
     char *acquireJsonBuffer();
 
     /**
-     * Libera o buffer JSON.
+     * Libera um buffer JSON.
      *
+     * @param buffer Ponteiro obtido de acquireJsonBuffer().
      * @return true se o buffer foi liberado, false caso contrário.
      */
-    bool releaseJsonBuffer();
+    bool releaseJsonBuffer(char *buffer);
+
+    /**
+     * Obtém as estatísticas do pool de SensorData.
+     *
+     * @return Capacidade, uso atual, marca d'água e falhas.
+     */
+    ObjectPoolStats getSensorDataPoolStats() const;
+
+    /**
+     * Obtém as estatísticas do pool de buffers JSON.
+     *
+     * @return Capacidade, uso atual, marca d'água e falhas.
+     */
+    ObjectPoolStats getJsonBufferPoolStats() const;
 
     /**
-     * Atualiza as estatísticas de memória.
+     * Atualiza as estatísticas de memória. Chamado a cada segundo pelo job
+     * "memory.stats" do SystemMonitor.
      *
      * @return Estatísticas atualizadas.
      */
@@ -0,0 +1,201 @@
+/**
+ * @file ObjectPool.h
+ * @brief Pool de objetos de tamanho fixo, thread-safe e sem bloqueio.
+ *
+ * Os objetos ficam em armazenamento estático dentro do pool. Os slots livres
+ * formam uma pilha encadeada por índices, cujo topo é atualizado com
+ * compare-and-swap; um contador de versão no topo evita o problema ABA.
+ * Aquisição e liberação são O(1) e podem ser chamadas de qualquer tarefa ou
+ * núcleo simultaneamente.
+ *
+ * Não depende do framework Arduino, para poder ser medido no host.
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <atomic>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+
+// Verificações de posse (ponteiro liberado duas vezes) nas builds de
+// depuração de memória
+#ifndef OBJECT_POOL_DEBUG
+#ifdef DEBUG_MEMORY
+#define OBJECT_POOL_DEBUG DEBUG_MEMORY
+#else
+#define OBJECT_POOL_DEBUG false
+#endif
+#endif
+
+/**
+ * @struct ObjectPoolStats
+ * @brief Estatísticas de uso de um pool.
+ */
+struct ObjectPoolStats {
+    uint16_t capacity;          ///< Número total de slots
+    uint16_t inUse;             ///< Slots adquiridos no momento
+    uint16_t highWater;         ///< Maior número de slots em uso simultâneo
+    uint32_t failures;          ///< Aquisições que encontraram o pool vazio
+    uint32_t invalidReleases;   ///< Liberações de ponteiros que não pertencem ao pool
+};
+
+/**
+ * @class ObjectPool
+ * @brief Pool de até N objetos do tipo T.
+ *
+ * @tparam T Tipo dos objetos.
+ * @tparam N Número de slots (menor que 0xFFFF).
+ */
+template <typename T, size_t N>
+class ObjectPool {
+    static_assert(N > 0 && N < 0xFFFF, "N deve caber em índices de 16 bits");
+
+public:
+    ObjectPool() : m_inUse(0), m_highWater(0), m_failures(0), m_invalidReleases(0) {
+        for (size_t i = 0; i < N; i++) {
+            m_next[i].store(i + 1 < N ? static_cast<uint16_t>(i + 1) : NO_SLOT, std::memory_order_relaxed);
+            m_owned[i].store(0, std::memory_order_relaxed);
+        }
+        m_head.store(0, std::memory_order_release);
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Adquire um objeto, construído com os argumentos fornecidos.
+     * @return Ponteiro para o objeto, ou nullptr se o pool estiver vazio.
+     */
+    template <typename... Args>
+    T* acquire(Args&&... args) {
+        uint32_t head = m_head.load(std::memory_order_acquire);
+        uint16_t index;
+
+        while (true) {
+            index = static_cast<uint16_t>(head & INDEX_MASK);
+            if (index == NO_SLOT) {
+                m_failures.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            uint32_t next = nextTag(head) | m_next[index].load(std::memory_order_relaxed);
+            if (m_head.compare_exchange_weak(head, next,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+                break;
+            }
+        }
+
+        if (OBJECT_POOL_DEBUG) {
+            m_owned[index].store(1, std::memory_order_relaxed);
+        }
+
+        // Atualiza uso e marca d'água
+        uint16_t inUse = m_inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+        uint16_t highWater = m_highWater.load(std::memory_order_relaxed);
+        while (inUse > highWater &&
+               !m_highWater.compare_exchange_weak(highWater, inUse, std::memory_order_relaxed)) {
+        }
+
+        return new (slot(index)) T(static_cast<Args&&>(args)...);
+    }
+
+    /**
+     * @brief Destrói o objeto e devolve seu slot ao pool.
+     * @param object Ponteiro obtido de acquire().
+     * @return false se o ponteiro não pertence ao pool (ou, nas builds de
+     *         depuração, se já havia sido liberado).
+     */
+    bool release(T* object) {
+        int index = indexOf(object);
+        if (index < 0) {
+            m_invalidReleases.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        if (OBJECT_POOL_DEBUG && m_owned[index].exchange(0, std::memory_order_relaxed) == 0) {
+            m_invalidReleases.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        object->~T();
+        m_inUse.fetch_sub(1, std::memory_order_relaxed);
+
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        uint32_t newHead;
+        do {
+            m_next[index].store(static_cast<uint16_t>(head & INDEX_MASK), std::memory_order_relaxed);
+            newHead = nextTag(head) | static_cast<uint32_t>(index);
+        } while (!m_head.compare_exchange_weak(head, newHead,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+
+        return true;
+    }
+
+    /**
+     * @brief Verifica se um ponteiro aponta para um slot deste pool.
+     */
+    bool owns(const T* object) const {
+        return indexOf(object) >= 0;
+    }
+
+    /**
+     * @brief Obtém uma cópia das estatísticas de uso.
+     */
+    ObjectPoolStats getStats() const {
+        ObjectPoolStats stats;
+        stats.capacity = static_cast<uint16_t>(N);
+        stats.inUse = m_inUse.load(std::memory_order_relaxed);
+        stats.highWater = m_highWater.load(std::memory_order_relaxed);
+        stats.failures = m_failures.load(std::memory_order_relaxed);
+        stats.invalidReleases = m_invalidReleases.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /**
+     * @brief Número total de slots.
+     */
+    static constexpr size_t capacity() { return N; }
+
+private:
+    static const uint16_t NO_SLOT = 0xFFFF;
+    static const uint32_t INDEX_MASK = 0xFFFF;
+    static const uint32_t TAG_INCREMENT = 0x10000;
+
+    // Incrementa a versão do topo a cada troca
+    static uint32_t nextTag(uint32_t head) {
+        return (head + TAG_INCREMENT) & ~INDEX_MASK;
+    }
+
+    void* slot(size_t index) {
+        return &m_storage[index * sizeof(T)];
+    }
+
+    // Índice do slot apontado, ou -1 se o ponteiro não for de um slot
+    int indexOf(const T* object) const {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(object);
+        if (p < m_storage || p >= m_storage + sizeof(m_storage)) {
+            return -1;
+        }
+
+        size_t offset = static_cast<size_t>(p - m_storage);
+        if (offset % sizeof(T) != 0) {
+            return -1;
+        }
+        return static_cast<int>(offset / sizeof(T));
+    }
+
+    alignas(T) unsigned char m_storage[N * sizeof(T)];
+    std::atomic<uint16_t> m_next[N];       // Próximo slot livre na pilha
+    std::atomic<uint8_t> m_owned[N];       // Slot adquirido (apenas depuração)
+    std::atomic<uint32_t> m_head;          // Versão (16 bits altos) | topo da pilha
+    std::atomic<uint16_t> m_inUse;
+    std::atomic<uint16_t> m_highWater;
+    std::atomic<uint32_t> m_failures;
+    std::atomic<uint32_t> m_invalidReleases;
+};
+
+#endif // OBJECT_POOL_H
@@ -0,0 +1,224 @@
+/**
+ * @file PatternMatcher.h
+ * @brief Autômato Aho-Corasick de capacidade fixa para busca de múltiplos padrões.
+ *
+ * Todo o armazenamento é pré-alocado no próprio objeto: adicionar padrões
+ * e pesquisar mensagens nunca usa o heap. A busca percorre a mensagem uma
+ * única vez, em tempo proporcional ao seu tamanho, independentemente do
+ * número de padrões.
+ *
+ * Não depende do framework Arduino, para poder ser medido no host.
+ */
+
+#ifndef PATTERN_MATCHER_H
+#define PATTERN_MATCHER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @class PatternMatcher
+ * @brief Autômato Aho-Corasick com até MaxStates estados.
+ *
+ * O trie é armazenado como listas de filhos (primeiro filho/irmão), com uma tabela
+ * direta de 256 entradas para a raiz, onde a maior parte dos caracteres de
+ * uma mensagem comum é consumida. Os links de falha são reconstruídos a
+ * cada padrão adicionado; padrões devem ser registrados na inicialização.
+ *
+ * @tparam MaxStates Número máximo de estados (soma aproximada dos tamanhos
+ *                   dos padrões + 1).
+ */
+template <size_t MaxStates>
+class PatternMatcher {
+    static_assert(MaxStates > 1 && MaxStates < 0xFFFF, "MaxStates deve caber em uint16_t");
+
+public:
+    PatternMatcher() {
+        clear();
+    }
+
+    /**
+     * @brief Remove todos os padrões.
+     */
+    void clear() {
+        memset(m_rootNext, 0, sizeof(m_rootNext));
+        m_firstEdge[ROOT] = NO_EDGE;
+        m_fail[ROOT] = ROOT;
+        m_flags[ROOT] = 0;
+        m_stateCount = 1;
+        m_patternCount = 0;
+    }
+
+    /**
+     * @brief Adiciona um padrão ao autômato.
+     * @param pattern Texto a ser procurado (não vazio).
+     * @return true se o padrão foi adicionado ou já existia; false se não
+     *         houver estados livres (o autômato fica inalterado).
+     */
+    bool addPattern(const char* pattern) {
+        if (!pattern || pattern[0] == '\0') {
+            return false;
+        }
+
+        // Verifica a capacidade antes de alterar o trie
+        size_t required = 0;
+        uint16_t state = ROOT;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(pattern);
+        for (; *p; p++) {
+            uint16_t next = child(state, *p);
+            if (next == NO_STATE) {
+                required = strlen(reinterpret_cast<const char*>(p));
+                break;
+            }
+            state = next;
+        }
+
+        if (required == 0 && (m_flags[state] & FLAG_TERMINAL)) {
+            return true; // Padrão duplicado
+        }
+        if (m_stateCount + required > MaxStates) {
+            return false;
+        }
+
+        // Insere os estados que faltam
+        for (; *p; p++) {
+            uint16_t next = m_stateCount++;
+            m_firstEdge[next] = NO_EDGE;
+            m_flags[next] = 0;
+
+            // Cada estado é identificado pela aresta que entra nele
+            m_symbol[next] = *p;
+            m_nextSibling[next] = m_firstEdge[state];
+            m_firstEdge[state] = next;
+
+            if (state == ROOT) {
+                m_rootNext[*p] = next;
+            }
+            state = next;
+        }
+
+        m_flags[state] |= FLAG_TERMINAL;
+        m_patternCount++;
+
+        buildFailureLinks();
+        return true;
+    }
+
+    /**
+     * @brief Verifica se algum padrão ocorre no texto.
+     * @param text Texto terminado em nulo.
+     * @return true no primeiro padrão encontrado.
+     */
+    bool matches(const char* text) const {
+        if (!text || m_patternCount == 0) {
+            return false;
+        }
+
+        uint16_t state = ROOT;
+        for (const uint8_t* p = reinterpret_cast<const uint8_t*>(text); *p; p++) {
+            if (state == ROOT) {
+                // Na raiz a transição depende só do caractere: avança sem
+                // encadear acessos até o início de um possível padrão
+                while (*p && m_rootNext[*p] == ROOT) {
+                    p++;
+                }
+                if (!*p) {
+                    break;
+                }
+            }
+
+            state = step(state, *p);
+            if (m_flags[state] & FLAG_OUTPUT) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Número de padrões distintos registrados.
+     */
+    size_t patternCount() const { return m_patternCount; }
+
+    /**
+     * @brief Número de estados em uso (inclui a raiz).
+     */
+    size_t stateCount() const { return m_stateCount; }
+
+private:
+    static const uint16_t ROOT = 0;
+    static const uint16_t NO_STATE = 0xFFFF;
+    static const uint16_t NO_EDGE = 0xFFFF;
+    static const uint8_t FLAG_TERMINAL = 0x01; // Um padrão termina neste estado
+    static const uint8_t FLAG_OUTPUT = 0x02;   // Algum padrão termina aqui ou em um sufixo
+
+    // Transição direta do trie (sem links de falha)
+    uint16_t child(uint16_t state, uint8_t symbol) const {
+        if (state == ROOT) {
+            return m_rootNext[symbol] != ROOT ? m_rootNext[symbol] : NO_STATE;
+        }
+        for (uint16_t s = m_firstEdge[state]; s != NO_EDGE; s = m_nextSibling[s]) {
+            if (m_symbol[s] == symbol) {
+                return s;
+            }
+        }
+        return NO_STATE;
+    }
+
+    // Transição do autômato completo (segue links de falha)
+    uint16_t step(uint16_t state, uint8_t symbol) const {
+        while (state != ROOT) {
+            for (uint16_t s = m_firstEdge[state]; s != NO_EDGE; s = m_nextSibling[s]) {
+                if (m_symbol[s] == symbol) {
+                    return s;
+                }
+            }
+            state = m_fail[state];
+        }
+        return m_rootNext[symbol];
+    }
+
+    void buildFailureLinks() {
+        uint16_t queue[MaxStates];
+        size_t head = 0;
+        size_t tail = 0;
+
+        // Filhos da raiz falham para a raiz
+        for (uint16_t s = m_firstEdge[ROOT]; s != NO_EDGE; s = m_nextSibling[s]) {
+            m_fail[s] = ROOT;
+            m_flags[s] = (m_flags[s] & FLAG_TERMINAL) ? (FLAG_TERMINAL | FLAG_OUTPUT) : 0;
+            queue[tail++] = s;
+        }
+
+        // Busca em largura: o link de falha de um estado depende apenas
+        // de estados mais rasos, já processados
+        while (head < tail) {
+            uint16_t state = queue[head++];
+
+            for (uint16_t s = m_firstEdge[state]; s != NO_EDGE; s = m_nextSibling[s]) {
+                m_fail[s] = step(m_fail[state], m_symbol[s]);
+
+                uint8_t flags = m_flags[s] & FLAG_TERMINAL;
+                if (flags || (m_flags[m_fail[s]] & FLAG_OUTPUT)) {
+                    flags |= FLAG_OUTPUT;
+                }
+                m_flags[s] = flags;
+
+                queue[tail++] = s;
+            }
+        }
+    }
+
+    uint16_t m_rootNext[256];          // Transições da raiz (0 = permanece na raiz)
+    uint16_t m_firstEdge[MaxStates];   // Primeira aresta de saída de cada estado
+    uint16_t m_fail[MaxStates];        // Link de falha de cada estado
+    uint16_t m_nextSibling[MaxStates]; // Próximo filho do mesmo pai
+    uint8_t m_symbol[MaxStates];       // Caractere da aresta que entra no estado
+    uint8_t m_flags[MaxStates];        // FLAG_TERMINAL / FLAG_OUTPUT
+    uint16_t m_stateCount;
+    uint16_t m_patternCount;
+};
+
+#endif // PATTERN_MATCHER_H
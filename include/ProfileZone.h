@@ -0,0 +1,153 @@
+/**
+ * @file ProfileZone.h
+ * @brief Zonas de tempo com histogramas de latência em ciclos de CPU.
+ *
+ * PROFILE_ZONE("sensor.read") mede, pelo contador CCOUNT, o tempo até o fim
+ * do escopo e o registra no histograma da zona. Cada zona é um objeto
+ * estático criado no primeiro uso e encadeado numa lista global; o
+ * histograma é log-linear (estilo HDR): cada potência de 2 é dividida em
+ * 2^PROFILE_ZONE_SUB_BUCKET_BITS faixas, com memória fixa por zona.
+ *
+ * O CCOUNT é por core e as tarefas do AsyncTCP (handlers HTTP) não são
+ * fixadas: se o escopo termina em outro core a medição é descartada e só
+ * contada em "migradas".
+ *
+ * Com PROFILE_ZONES_ENABLED false a macro é vazia e nada é compilado.
+ */
+
+#ifndef PROFILE_ZONE_H
+#define PROFILE_ZONE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+#if PROFILE_ZONES_ENABLED
+
+#include <freertos/FreeRTOS.h>
+#include "CycleCounter.h"
+
+/**
+ * @class ProfileZone
+ * @brief Histograma de latência de um trecho de código.
+ */
+class ProfileZone {
+public:
+    static constexpr uint8_t SUB_BITS = PROFILE_ZONE_SUB_BUCKET_BITS;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BITS;
+    static constexpr size_t BUCKET_COUNT = (32 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @brief Percentis de uma zona, em ciclos.
+     */
+    struct Summary {
+        const char* name;
+        uint32_t count;           ///< Medições registradas
+        uint32_t p50;             ///< Limite superior da faixa da mediana
+        uint32_t p99;             ///< Limite superior da faixa do percentil 99
+        uint32_t max;             ///< Maior medição exata
+        uint32_t migrated;        ///< Medições descartadas por troca de core
+        uint64_t totalCycles;     ///< Soma das medições (para a média)
+    };
+
+    /**
+     * @brief Cria a zona e a inclui na lista global.
+     * @param name Nome literal da zona (não é copiado).
+     */
+    explicit ProfileZone(const char* name);
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    /**
+     * @brief Registra uma medição.
+     * @param cycles Duração em ciclos de CPU.
+     */
+    void record(uint32_t cycles);
+
+    /**
+     * @brief Conta uma medição descartada porque o escopo mudou de core.
+     */
+    void discard();
+
+    /**
+     * @brief Calcula os percentis atuais da zona.
+     * @return Resumo da zona.
+     */
+    Summary summarize() const;
+
+    const char* getName() const { return m_name; }
+    const ProfileZone* next() const { return m_next; }
+
+    /**
+     * @brief Primeira zona da lista (a criada mais recentemente).
+     * @return Zona ou nullptr se nenhuma foi usada ainda.
+     */
+    static const ProfileZone* first();
+
+    /**
+     * @brief Zera os histogramas de todas as zonas.
+     */
+    static void resetAll();
+
+    /**
+     * @brief Comando de console "profile [reset]": imprime a tabela de zonas.
+     * @param args Argumentos após o nome do comando.
+     */
+    static void printReport(const char* args);
+
+    /**
+     * @class Scope
+     * @brief Mede do construtor ao destrutor e registra na zona.
+     */
+    class Scope {
+    public:
+        explicit Scope(ProfileZone& zone)
+            : m_zone(zone), m_core(xPortGetCoreID()), m_start(CycleCounter::now()) {}
+
+        ~Scope() {
+            uint32_t end = CycleCounter::now();
+            // Ciclos de cores diferentes não são comparáveis
+            if (xPortGetCoreID() == m_core) {
+                m_zone.record(end - m_start);
+            } else {
+                m_zone.discard();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ProfileZone& m_zone;
+        BaseType_t m_core;
+        uint32_t m_start;
+    };
+
+private:
+    static size_t bucketOf(uint32_t cycles);
+    static uint32_t bucketUpperBound(size_t bucket);
+    uint32_t percentile(uint32_t rank) const;
+    void clear();
+
+    const char* m_name;
+    ProfileZone* m_next;
+    uint32_t m_count;
+    uint32_t m_max;
+    uint32_t m_migrated;
+    uint64_t m_totalCycles;
+    uint32_t m_buckets[BUCKET_COUNT];
+};
+
+#define PROFILE_ZONE_CONCAT_(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_(a, b)
+#define PROFILE_ZONE(name) \
+    static ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(name); \
+    ProfileZone::Scope PROFILE_ZONE_CONCAT(profileZoneScope, __LINE__)(PROFILE_ZONE_CONCAT(profileZone, __LINE__))
+
+#else
+
+#define PROFILE_ZONE(name) do {} while (0)
+
+#endif // PROFILE_ZONES_ENABLED
+
+#endif // PROFILE_ZONE_H
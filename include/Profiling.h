@@ -1,6 +1,13 @@
 /**
  * @file Profiling.h
  * @brief Define funções para instrumentação e análise de desempenho de código.
+ *
+ * No ambiente esp32dev_profile o código do projeto é compilado com
+ * -finstrument-functions: cada entrada e saída de função passa pelos hooks
+ * de Profiling.cpp, que mantêm uma pilha de chamadas por tarefa e acumulam,
+ * por endereço de função, o número de chamadas e os ciclos inclusivos
+ * (com as funções chamadas) e exclusivos (só o corpo da função). Os
+ * endereços são resolvidos no host por scripts/profile_symbolize.py.
  */
 
 #ifndef PROFILING_H
@@ -11,12 +18,40 @@
 
 namespace Profiling {
     /**
-     * Obtém as estatísticas de profiling acumuladas.
+     * Totais acumulados de uma função.
+     */
+    struct FunctionStats {
+        uint32_t address;          ///< Endereço da função
+        uint32_t calls;            ///< Chamadas concluídas
+        uint64_t inclusiveCycles;  ///< Ciclos incluindo as funções chamadas
+        uint64_t exclusiveCycles;  ///< Ciclos apenas no corpo da função
+    };
+
+    /**
+     * Estado geral do profiler.
+     */
+    struct Summary {
+        uint16_t functions;        ///< Funções distintas registradas
+        uint8_t tasks;             ///< Tarefas com pilha de chamadas (inclui excluídas)
+        uint32_t droppedCalls;     ///< Chamadas perdidas (tabela ou tarefas esgotadas)
+        uint32_t depthOverflows;   ///< Chamadas além de PROFILE_STACK_DEPTH
+    };
+
+    /**
+     * Copia uma posição da tabela de funções.
+     *
+     * @param slot Posição na tabela (0 a PROFILE_MAX_FUNCTIONS - 1).
+     * @param stats Destino da cópia.
+     * @return false se a posição está vazia.
+     */
+    bool getFunction(size_t slot, FunctionStats &stats);
+
+    /**
+     * Obtém o estado geral do profiler.
      *
-     * @param total_time Ponteiro para armazenar o tempo total de execução.
-     * @param calls Ponteiro para armazenar o número de chamadas de função.
+     * @return Contadores gerais.
      */
-    void getStats(uint32_t *total_time, uint32_t *calls);
+    Summary getSummary();
 
     /**
      * Reinicia as estatísticas de profiling.
@@ -24,4 +59,4 @@ namespace Profiling {
     void reset();
 }
 
-#endif // PROFILING_H
\ No newline at end of file
+#endif // PROFILING_H
@@ -0,0 +1,143 @@
+/**
+ * @file RequestArena.h
+ * @brief Arena de alocação por requisição para os handlers web.
+ *
+ * Cada requisição HTTP ou mensagem WebSocket recebe uma arena apoiada em um
+ * slab pré-alocado. Alocações apenas avançam um ponteiro e nada é liberado
+ * individualmente: o slab inteiro volta ao pool quando a requisição termina,
+ * sem passar pelo heap e sem contribuir para a fragmentação.
+ */
+
+#ifndef REQUEST_ARENA_H
+#define REQUEST_ARENA_H
+
+#include <Arduino.h>
+#include <new>
+#include "Config.h"
+#include "ObjectPool.h"
+
+/**
+ * @class RequestArena
+ * @brief Alocador bump-pointer sobre um slab de REQUEST_ARENA_SLAB_SIZE bytes.
+ */
+class RequestArena {
+public:
+    /**
+     * @brief Estatísticas globais das arenas.
+     */
+    struct Stats {
+        uint32_t acquired;      ///< Arenas entregues
+        uint32_t exhausted;     ///< Aquisições sem slab livre
+        uint32_t overflows;     ///< Alocações que não couberam no slab
+        uint32_t peakBytes;     ///< Maior uso de uma arena
+        ObjectPoolStats slabs;  ///< Uso do pool de slabs
+    };
+
+    /**
+     * @brief Obtém uma arena vazia.
+     * @return Arena, ou nullptr se todos os slabs estiverem em uso.
+     */
+    static RequestArena* acquire();
+
+    /**
+     * @brief Devolve a arena ao pool, invalidando toda a memória alocada nela.
+     * @param arena Arena obtida de acquire().
+     */
+    static void release(RequestArena* arena);
+
+    /**
+     * @brief Obtém as estatísticas das arenas.
+     * @return Cópia das estatísticas.
+     */
+    static Stats getStats();
+
+    /**
+     * @brief Aloca memória na arena.
+     * @param size Tamanho em bytes.
+     * @param alignment Alinhamento (potência de 2).
+     * @return Ponteiro, ou nullptr se não houver espaço.
+     */
+    void* allocate(size_t size, size_t alignment = alignof(uint32_t));
+
+    /**
+     * @brief Copia bytes para a arena como string terminada em nulo.
+     * @param data Bytes de origem.
+     * @param length Quantidade de bytes.
+     * @return Cópia terminada em nulo, ou nullptr se não houver espaço.
+     */
+    char* copyString(const void* data, size_t length);
+
+    /**
+     * @brief Reserva todo o espaço restante como buffer de caracteres.
+     * @param capacity Recebe o tamanho do buffer.
+     * @return Buffer, ou nullptr se a arena estiver cheia.
+     */
+    char* allocateRemaining(size_t* capacity);
+
+    /**
+     * @brief Constrói um objeto na arena. O destrutor nunca é chamado.
+     * @return Objeto, ou nullptr se não houver espaço.
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        return memory ? new (memory) T(static_cast<Args&&>(args)...) : nullptr;
+    }
+
+    /**
+     * @brief Bytes já alocados.
+     */
+    size_t used() const { return m_offset; }
+
+    /**
+     * @brief Bytes ainda disponíveis (sem considerar alinhamento).
+     */
+    size_t remaining() const { return REQUEST_ARENA_SLAB_SIZE - m_offset; }
+
+private:
+    friend class ObjectPool<RequestArena, REQUEST_ARENA_SLAB_COUNT>;
+
+    RequestArena() : m_offset(0) {}
+
+    alignas(8) uint8_t m_slab[REQUEST_ARENA_SLAB_SIZE];
+    size_t m_offset;
+};
+
+/**
+ * @class ScopedArena
+ * @brief Arena devolvida automaticamente ao fim do escopo.
+ *
+ * Para respostas assíncronas, detach() transfere a posse para quem
+ * libera a arena ao fim da requisição.
+ */
+class ScopedArena {
+public:
+    ScopedArena() : m_arena(RequestArena::acquire()) {}
+
+    ~ScopedArena() {
+        if (m_arena) {
+            RequestArena::release(m_arena);
+        }
+    }
+
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+    explicit operator bool() const { return m_arena != nullptr; }
+    RequestArena* operator->() const { return m_arena; }
+
+    /**
+     * @brief Abandona a posse da arena sem liberá-la.
+     * @return A arena, que deve ser liberada com RequestArena::release().
+     */
+    RequestArena* detach() {
+        RequestArena* arena = m_arena;
+        m_arena = nullptr;
+        return arena;
+    }
+
+private:
+    RequestArena* m_arena;
+};
+
+#endif // REQUEST_ARENA_H
@@ -0,0 +1,127 @@
+/**
+ * @file SensorTraceRecorder.h
+ * @brief Gravação das leituras brutas dos sensores para reprodução no host.
+ *
+ * A cada leitura, o SensorManager grava um registro de 12 bytes num anel em
+ * RAM: ADC do pH antes do filtro, temperatura e umidade do DHT22 e o nível
+ * dos pinos dos botões. A rota /sensors/trace exporta o anel em binário, e
+ * o sensor_replay do host (host/sim) devolve os registros ao Hardware
+ * virtual, de 1x a 1000x, para medir filtro, decisão e telemetria sobre
+ * dados reais de campo.
+ *
+ * Formato do arquivo (little-endian): cabeçalho "STR1", versão (2),
+ * tamanho do registro (12), 2 bytes reservados, quantidade de registros,
+ * registros perdidos e posição final do dump (uint32 cada), seguidos dos
+ * registros do mais antigo ao mais recente. A posição final é o valor a
+ * passar em /sensors/trace?reset=<posição>, que descarta apenas o que foi
+ * baixado; leituras gravadas depois do dump continuam no anel.
+ *
+ * O anel guarda SENSOR_TRACE_RECORDS leituras, uma a cada
+ * SENSOR_CHECK_INTERVAL: com 2048 e 200 ms, cerca de 6,8 minutos. Baixe com
+ * intervalo menor que isso ou aumente SENSOR_TRACE_RECORDS no build.
+ *
+ * O formato vale sempre; a gravação só existe com SENSOR_TRACE_ENABLED.
+ */
+
+#ifndef SENSOR_TRACE_RECORDER_H
+#define SENSOR_TRACE_RECORDER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class SensorTraceRecorder
+ * @brief Anel de leituras brutas, gravado pela tarefa de sensores.
+ */
+class SensorTraceRecorder {
+public:
+    /**
+     * @brief Registro como gravado no anel e no arquivo.
+     */
+    struct Record {
+        uint32_t timestamp;      ///< millis() da leitura
+        uint16_t phRaw;          ///< ADC do pH (0-4095), antes do filtro
+        int16_t temperature;     ///< Centésimos de °C; TEMPERATURE_INVALID = falha
+        uint16_t humidity;       ///< Centésimos de %; HUMIDITY_INVALID = falha
+        uint8_t pins;            ///< Níveis dos pinos dos botões (PHOSPHORUS_PIN_HIGH, ...)
+        uint8_t reserved;
+    };
+
+    static constexpr int16_t TEMPERATURE_INVALID = INT16_MIN;
+    static constexpr uint16_t HUMIDITY_INVALID = 0xFFFF;
+    static constexpr uint8_t PHOSPHORUS_PIN_HIGH = 0x01;
+    static constexpr uint8_t POTASSIUM_PIN_HIGH = 0x02;
+
+    static constexpr uint8_t FORMAT_VERSION = 2;
+    static constexpr size_t HEADER_SIZE = 20;
+
+    /**
+     * @brief Monta um registro a partir das leituras (NAN vira valor inválido).
+     */
+    static Record encode(uint32_t timestamp, uint16_t phRaw, float temperature, float humidity,
+                         uint8_t phosphorusLevel, uint8_t potassiumLevel) {
+        Record record;
+        record.timestamp = timestamp;
+        record.phRaw = phRaw;
+        record.temperature = (temperature > -300.0f && temperature < 300.0f)
+            ? static_cast<int16_t>(lroundf(temperature * 100.0f)) : TEMPERATURE_INVALID;
+        record.humidity = (humidity >= 0.0f && humidity <= 600.0f)
+            ? static_cast<uint16_t>(lroundf(humidity * 100.0f)) : HUMIDITY_INVALID;
+        record.pins = (phosphorusLevel ? PHOSPHORUS_PIN_HIGH : 0) | (potassiumLevel ? POTASSIUM_PIN_HIGH : 0);
+        record.reserved = 0;
+        return record;
+    }
+
+    static float decodeTemperature(const Record& record) {
+        return record.temperature == TEMPERATURE_INVALID ? NAN : record.temperature / 100.0f;
+    }
+
+    static float decodeHumidity(const Record& record) {
+        return record.humidity == HUMIDITY_INVALID ? NAN : record.humidity / 100.0f;
+    }
+
+#if SENSOR_TRACE_ENABLED
+    /**
+     * @brief Grava uma leitura; não loga nem aloca.
+     */
+    static void record(const Record& record);
+
+    /**
+     * @brief Total de registros gravados desde o boot.
+     */
+    static uint32_t getHead();
+
+    /**
+     * @brief Posição do registro mais antigo ainda no anel e não descartado.
+     */
+    static uint32_t getTail();
+
+    /**
+     * @brief Copia o registro de uma posição absoluta.
+     * @return false se a posição já foi sobrescrita.
+     */
+    static bool readRecord(uint32_t position, Record& record);
+
+    /**
+     * @brief Descarta os registros anteriores à posição (após um download).
+     * @param position Posição final informada no cabeçalho do dump.
+     */
+    static void discardUntil(uint32_t position);
+
+    /**
+     * @brief Registros sobrescritos antes de serem exportados.
+     */
+    static uint32_t getDropped();
+#endif
+
+private:
+    SensorTraceRecorder() = delete;
+};
+
+#if SENSOR_TRACE_ENABLED
+#define SENSOR_TRACE_RECORD(...) SensorTraceRecorder::record(SensorTraceRecorder::encode(__VA_ARGS__))
+#else
+#define SENSOR_TRACE_RECORD(...) do {} while (0)
+#endif
+
+#endif // SENSOR_TRACE_RECORDER_H
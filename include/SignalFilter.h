@@ -0,0 +1,41 @@
+/**
+ * @file SignalFilter.h
+ * @brief Filtros das leituras de sensores, sem dependências de hardware.
+ */
+
+#ifndef SIGNAL_FILTER_H
+#define SIGNAL_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace SignalFilter {
+
+/**
+ * @brief Média móvel sobre uma janela circular de N leituras.
+ *
+ * Grava o novo valor na posição indicada e retorna a média da janela. O
+ * índice é mantido por quem chama, para que várias janelas avancem juntas.
+ *
+ * @tparam N Tamanho da janela.
+ * @tparam Sum Tipo do acumulador (largo o bastante para N leituras).
+ * @param window Leituras históricas (N posições).
+ * @param index Posição a sobrescrever.
+ * @param newValue Nova leitura.
+ * @return Média dos valores na janela.
+ */
+template <size_t N, typename Sum, typename T>
+inline T movingAverage(T* window, uint8_t index, T newValue) {
+    window[index] = newValue;
+
+    Sum sum = 0;
+    for (size_t i = 0; i < N; i++) {
+        sum += window[i];
+    }
+
+    return static_cast<T>(sum / static_cast<Sum>(N));
+}
+
+} // namespace SignalFilter
+
+#endif // SIGNAL_FILTER_H
@@ -19,9 +19,6 @@ class SystemMonitor {
 private:
     static SystemMonitor *s_instance;
 
-    // Timestamp da última atualização
-    uint32_t m_lastCheckTime;
-
     // Timestamp do último reset do watchdog
     uint32_t m_lastWatchdogReset;
 
@@ -41,6 +38,16 @@ private:
      */
     bool setupWatchdog();
 
+    /**
+     * Job "watchdog": reinicia o watchdog a 75% do timeout.
+     */
+    static void watchdogJob(void *context);
+
+    /**
+     * Job "memory.stats": atualiza as estatísticas de memória a cada segundo.
+     */
+    static void memoryStatsJob(void *context);
+
 public:
     /**
      * Obtém a instância do singleton.
@@ -50,20 +57,13 @@ public:
     static SystemMonitor &getInstance();
 
     /**
-     * Inicializa o monitor de sistema.
+     * Inicializa o monitor de sistema e registra os jobs do watchdog e das
+     * estatísticas de memória no JobScheduler (core de sensores).
      *
      * @return true se a inicialização foi bem-sucedida.
      */
     bool init();
 
-    /**
-     * Atualiza o monitor e reinicia o watchdog.
-     * Deve ser chamado periodicamente para evitar reset.
-     *
-     * @return SystemStats atualizado.
-     */
-    const SystemStats &update();
-
     /**
      * Obtém estatísticas atuais do sistema.
      *
@@ -72,7 +72,10 @@ public:
     const SystemStats &getStats() const;
 
     /**
-     * Verifica a integridade do sistema.
+     * Verifica a integridade do sistema percorrendo o heap inteiro.
+     *
+     * Chamado pelo HeapIntegrityChecker quando uma fatia encontra
+     * corrupção, para confirmar e imprimir os detalhes.
      *
      * @return true se o sistema está íntegro, false caso contrário.
      */
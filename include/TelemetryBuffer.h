@@ -39,6 +39,12 @@ struct TelemetryBuffer {
     uint16_t heapFragmentation;    ///< Fragmentação do heap em percentual
     uint32_t uptime;               ///< Tempo de atividade em segundos
     uint32_t wifiRssi;             ///< Força do sinal WiFi em dBm
+    uint32_t sensorLoopLate;       ///< Maior atraso recente da tarefa de sensores (µs)
+    uint32_t sensorLoopMisses;     ///< Prazos perdidos pela tarefa de sensores
+    uint16_t sensorLoopStreak;     ///< Maior sequência de prazos perdidos (sensores)
+    uint32_t webLoopLate;          ///< Maior atraso recente da tarefa web (µs)
+    uint32_t webLoopMisses;        ///< Prazos perdidos pela tarefa web
+    uint16_t webLoopStreak;        ///< Maior sequência de prazos perdidos (web)
 
     // Metadados
     uint32_t timestamp;       ///< Timestamp em milissegundos desde o boot
@@ -8,6 +8,7 @@
 
 #include <Arduino.h>
 #include "TelemetryBuffer.h"
+#include "InstrumentedMutex.h"
 
 /**
  * Tipo de função callback para receber notificações de telemetria.
@@ -29,7 +30,7 @@ private:
     static const uint8_t MAX_LISTENERS = 5;                ///< Número máximo de ouvintes suportados
     static TelemetryEventListener s_listeners[MAX_LISTENERS]; ///< Array de funções callbacks registradas
     static uint8_t s_listenerCount;                     ///< Contador de ouvintes registrados
-    static SemaphoreHandle_t s_mutex;                   ///< Mutex para acesso thread-safe
+    static InstrumentedMutex s_mutex;                   ///< Mutex para acesso thread-safe
 
 public:
     /**
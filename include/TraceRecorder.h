@@ -0,0 +1,133 @@
+/**
+ * @file TraceRecorder.h
+ * @brief Gravador de eventos de trace em RAM, exportável para o Perfetto.
+ *
+ * Cada core grava num anel binário próprio de TRACE_RING_EVENTS eventos de
+ * 16 bytes, sem locks: a posição é reservada com um incremento atômico e o
+ * evento só vale depois que seu número de sequência é publicado. Os
+ * carimbos de tempo são ciclos CCOUNT do core que gravou; eventos de
+ * âncora periódicos associam ciclos ao esp_timer para alinhar os dois
+ * cores. A rota /trace exporta os anéis e scripts/trace_to_chrome.py os
+ * converte para o formato JSON do Chrome/Perfetto.
+ * A espera por mutexes é gravada pelo InstrumentedMutex.
+ *
+ * Com TRACE_ENABLED false as macros são vazias.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include <freertos/FreeRTOS.h>
+
+#if TRACE_ENABLED
+
+/**
+ * @class TraceRecorder
+ * @brief Anéis de eventos por core e tabelas de nomes e tarefas.
+ */
+class TraceRecorder {
+public:
+    /**
+     * @brief Tipos de evento; os valores são as fases do formato do Chrome.
+     */
+    enum EventType : uint8_t {
+        BEGIN = 'B',
+        END = 'E',
+        INSTANT = 'i',
+        COUNTER = 'C',
+        ANCHOR = 'A'         ///< value = esp_timer_get_time() (µs, 32 bits baixos)
+    };
+
+    /**
+     * @brief Evento como gravado no anel e exportado em /trace.
+     */
+    struct Event {
+        uint32_t sequence;   ///< Posição no anel + 1; 0 = em escrita
+        uint32_t timestamp;  ///< CCOUNT do core
+        int32_t value;       ///< Valor de INSTANT/COUNTER/ANCHOR
+        uint8_t name;        ///< Índice na tabela de nomes
+        uint8_t task;        ///< Índice na tabela de tarefas
+        uint8_t type;        ///< EventType
+        uint8_t core;
+    };
+
+    static constexpr uint8_t CORE_COUNT = portNUM_PROCESSORS;
+
+    /**
+     * @brief Registra um nome de evento (literal, não é copiado).
+     * @return Índice do nome; 0 ("?") se a tabela estiver cheia.
+     */
+    static uint8_t internName(const char* name);
+
+    /**
+     * @brief Grava um evento no anel do core atual.
+     */
+    static void record(EventType type, uint8_t name, int32_t value = 0);
+
+    /**
+     * @brief Suspende ou retoma a gravação (suspensa durante a exportação).
+     */
+    static void setPaused(bool paused);
+
+    static uint8_t getNameCount();
+    static const char* getName(uint8_t index);
+    static uint8_t getTaskCount();
+    static const char* getTaskName(uint8_t index);
+
+    /**
+     * @brief Posição de escrita do anel de um core (total de eventos gravados).
+     */
+    static uint32_t getHead(uint8_t core);
+
+    /**
+     * @brief Copia o evento de uma posição absoluta do anel.
+     * @return false se a posição foi sobrescrita ou ainda está em escrita.
+     */
+    static bool readEvent(uint8_t core, uint32_t position, Event& event);
+
+    /**
+     * @class Scope
+     * @brief Grava BEGIN no construtor e END no destrutor.
+     */
+    class Scope {
+    public:
+        explicit Scope(uint8_t name) : m_name(name) { record(BEGIN, name); }
+        ~Scope() { record(END, m_name); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        uint8_t m_name;
+    };
+
+private:
+    TraceRecorder() = delete;
+
+    static uint8_t currentTask();
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Índice do nome, registrado uma única vez por ponto de uso
+#define TRACE_NAME(name) \
+    ([]() { static const uint8_t traceName = TraceRecorder::internName(name); return traceName; }())
+
+#define TRACE_SCOPE(name) \
+    TraceRecorder::Scope TRACE_CONCAT(traceScope, __LINE__)(TRACE_NAME(name))
+#define TRACE_INSTANT(name, value) \
+    TraceRecorder::record(TraceRecorder::INSTANT, TRACE_NAME(name), static_cast<int32_t>(value))
+#define TRACE_COUNTER(name, value) \
+    TraceRecorder::record(TraceRecorder::COUNTER, TRACE_NAME(name), static_cast<int32_t>(value))
+
+#else
+
+#define TRACE_SCOPE(name) do {} while (0)
+#define TRACE_INSTANT(name, value) do {} while (0)
+#define TRACE_COUNTER(name, value) do {} while (0)
+
+#endif // TRACE_ENABLED
+
+#endif // TRACE_RECORDER_H
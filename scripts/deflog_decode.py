@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""
+Decodificador dos logs com formatação adiada (LOG_DEFERRED_MODE).
+
+Lê o fluxo da serial (porta, arquivo capturado ou stdin), separa os quadros
+binários gerados por DeferredLog do texto comum e reconstrói cada mensagem
+usando as strings de formato e nomes de módulo lidos do firmware.elf.
+
+Exemplos:
+    python scripts/deflog_decode.py --elf .pio/build/esp32dev_deferred_log/firmware.elf \\
+        --port /dev/ttyUSB0
+    python scripts/deflog_decode.py --elf firmware.elf --input captura.bin
+
+Autor: Leonardo Sena (slayerlab)
+Versão: 1.0.0
+"""
+
+import argparse
+import re
+import struct
+import sys
+from typing import BinaryIO, Iterator, List, Tuple
+
+from elf_reader import ElfReader
+
+
+# Deve corresponder a DeferredLog.h
+FRAME_SYNC = 0x1E
+HEADER_PAYLOAD_SIZE = 13
+FLAG_TRUNCATED = 0x80
+
+LEVEL_NAMES = ["TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"]
+
+# Especificação printf: flags, largura, precisão, modificador de tamanho e conversão
+FORMAT_SPEC = re.compile(r'%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|z|j|t|L)?([diouxXcsfFeEgGaAp%])')
+
+
+class FrameDecodeError(Exception):
+    """Quadro com argumentos incompatíveis com a string de formato."""
+
+
+def decode_arguments(fmt: str, payload: bytes, truncated: bool) -> str:
+    """
+    Aplica os argumentos brutos de um quadro à sua string de formato.
+
+    Args:
+        fmt: String de formato lida do ELF.
+        payload: Bytes dos argumentos.
+        truncated: Indica que o dispositivo descartou argumentos por falta de espaço.
+
+    Returns:
+        Mensagem formatada.
+    """
+    output: List[str] = []
+    position = 0
+    last = 0
+
+    for match in FORMAT_SPEC.finditer(fmt):
+        output.append(fmt[last:match.start()])
+        last = match.end()
+
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == '%':
+            output.append('%')
+            continue
+
+        spec = '%' + (flags or '') + (width or '') + ('.' + precision if precision else '')
+
+        try:
+            if conversion == 's':
+                if position >= len(payload):
+                    raise FrameDecodeError()
+                size = payload[position]
+                value = payload[position + 1:position + 1 + size].decode('utf-8', errors='replace')
+                position += 1 + size
+                output.append((spec + 's') % value)
+            elif conversion in 'fFeEgGaA':
+                value, = struct.unpack_from('<f', payload, position)
+                position += 4
+                output.append((spec + conversion.replace('a', 'e').replace('A', 'E')) % value)
+            elif length == 'll':
+                value, = struct.unpack_from('<q' if conversion in 'di' else '<Q', payload, position)
+                position += 8
+                output.append((spec + conversion) % value)
+            else:
+                value, = struct.unpack_from('<i' if conversion in 'di' else '<I', payload, position)
+                position += 4
+                if conversion == 'c':
+                    output.append((spec + 'c') % chr(value & 0xFF))
+                elif conversion == 'p':
+                    output.append('0x%08x' % value)
+                else:
+                    output.append((spec + conversion.replace('u', 'd')) % value)
+        except (struct.error, FrameDecodeError):
+            output.append('<?>' if truncated else '<erro>')
+
+    output.append(fmt[last:])
+    return ''.join(output)
+
+
+def read_chunks(stream: BinaryIO) -> Iterator[bytes]:
+    """
+    Lê o fluxo em blocos, sem encerrar nos timeouts da porta serial.
+
+    Args:
+        stream: Porta serial, arquivo ou stdin.
+
+    Yields:
+        Blocos de bytes lidos.
+    """
+    is_serial = hasattr(stream, 'in_waiting')
+    reader = getattr(stream, 'read1', stream.read)
+
+    while True:
+        chunk = stream.read(max(1, stream.in_waiting)) if is_serial else reader(256)
+        if chunk:
+            yield chunk
+        elif not is_serial:
+            return
+
+
+def split_stream(stream: BinaryIO) -> Iterator[Tuple[str, bytes]]:
+    """
+    Separa o fluxo da serial em texto comum e quadros binários válidos.
+
+    Args:
+        stream: Fluxo binário de entrada.
+
+    Yields:
+        Tuplas ('text', bytes) ou ('frame', carga).
+    """
+    buffer = bytearray()
+
+    for chunk in read_chunks(stream):
+        buffer.extend(chunk)
+
+        while buffer:
+            sync = buffer.find(bytes([FRAME_SYNC]))
+            if sync < 0:
+                yield 'text', bytes(buffer)
+                buffer.clear()
+                break
+            if sync > 0:
+                yield 'text', bytes(buffer[:sync])
+                del buffer[:sync]
+                continue
+
+            # Aguarda o quadro completo
+            if len(buffer) < 2 or len(buffer) < buffer[1] + 3:
+                break
+
+            payload_len = buffer[1]
+            payload = bytes(buffer[2:2 + payload_len])
+            checksum = 0
+            for byte in payload:
+                checksum ^= byte
+
+            if payload_len >= HEADER_PAYLOAD_SIZE and checksum == buffer[2 + payload_len]:
+                yield 'frame', payload
+                del buffer[:payload_len + 3]
+            else:
+                # Falso sincronismo: trata o byte como texto e continua
+                yield 'text', bytes(buffer[:1])
+                del buffer[:1]
+
+    if buffer:
+        yield 'text', bytes(buffer)
+
+
+def format_frame(elf: ElfReader, payload: bytes) -> str:
+    """
+    Reconstrói a linha de log de um quadro.
+
+    Args:
+        elf: Firmware carregado.
+        payload: Carga do quadro (sem sync, tamanho e checksum).
+
+    Returns:
+        Linha de log no mesmo formato do console em modo texto.
+    """
+    level_byte, timestamp, fmt_addr, module_addr = struct.unpack_from('<BIII', payload, 0)
+    level = level_byte & 0x7F
+    truncated = bool(level_byte & FLAG_TRUNCATED)
+
+    fmt = elf.read_string(fmt_addr)
+    module = elf.read_string(module_addr) or 'SYS'
+    level_name = LEVEL_NAMES[level] if level < len(LEVEL_NAMES) else 'UNKN'
+
+    if fmt is None:
+        message = f"<formato desconhecido 0x{fmt_addr:08x}: firmware.elf diferente do gravado?>"
+    else:
+        message = decode_arguments(fmt, payload[HEADER_PAYLOAD_SIZE:], truncated)
+
+    return f"[{timestamp // 1000:5d}.{timestamp % 1000:03d}][{level_name}][{module}] {message}"
+
+
+def open_input(args: argparse.Namespace) -> BinaryIO:
+    """Abre a porta serial, o arquivo capturado ou stdin."""
+    if args.port:
+        try:
+            import serial  # type: ignore
+        except ImportError:
+            sys.exit("ERRO: pyserial é necessário para ler da porta serial (pip install pyserial)")
+        return serial.Serial(args.port, args.baud, timeout=0.1)
+    if args.input:
+        return open(args.input, 'rb')
+    return sys.stdin.buffer
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Decodifica logs binários do modo diferido")
+    parser.add_argument('--elf', required=True, help="firmware.elf correspondente ao firmware gravado")
+    parser.add_argument('--port', help="Porta serial do dispositivo")
+    parser.add_argument('--baud', type=int, default=115200, help="Velocidade da serial")
+    parser.add_argument('--input', help="Arquivo com a captura bruta da serial")
+    args = parser.parse_args()
+
+    elf = ElfReader(args.elf)
+    stream = open_input(args)
+    out = sys.stdout
+
+    try:
+        for kind, data in split_stream(stream):
+            if kind == 'frame':
+                out.write(format_frame(elf, data) + '\n')
+            else:
+                out.write(data.decode('utf-8', errors='replace'))
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""
+Leitor mínimo de arquivos ELF usado pelas ferramentas de host.
+
+Carrega as seções e a tabela de símbolos de um firmware.elf sem depender de
+bibliotecas externas (pyelftools, binutils), permitindo:
+1. Ler strings terminadas em nulo a partir de um endereço virtual
+2. Resolver endereços de código para o símbolo que os contém
+
+Suporta ELF de 32 e 64 bits little-endian, o suficiente para o firmware do
+ESP32 (Xtensa) e para binários de host.
+
+Autor: Leonardo Sena (slayerlab)
+Versão: 1.0.0
+"""
+
+import bisect
+import struct
+from typing import Dict, List, Optional, Tuple
+
+
+SHT_PROGBITS = 1
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+STT_FUNC = 2
+
+
+class ElfSection:
+    """Seção de um arquivo ELF com seu conteúdo carregado."""
+
+    def __init__(self, name: str, sh_type: int, addr: int, data: bytes) -> None:
+        self.name = name
+        self.type = sh_type
+        self.addr = addr
+        self.data = data
+
+    def contains(self, address: int) -> bool:
+        return self.addr <= address < self.addr + len(self.data)
+
+
+class ElfReader:
+    """Acesso somente leitura às seções e símbolos de um ELF."""
+
+    def __init__(self, path: str) -> None:
+        with open(path, 'rb') as elf_file:
+            self._raw = elf_file.read()
+
+        if self._raw[:4] != b'\x7fELF':
+            raise ValueError(f"{path} não é um arquivo ELF")
+        if self._raw[5] != 1:
+            raise ValueError("Apenas ELF little-endian é suportado")
+
+        self._is64 = self._raw[4] == 2
+        self.sections: List[ElfSection] = []
+        self._functions: List[Tuple[int, int, str]] = []
+        self._function_addrs: List[int] = []
+        self._string_cache: Dict[int, Optional[str]] = {}
+
+        self._load_sections()
+        self._load_symbols()
+
+    def _load_sections(self) -> None:
+        if self._is64:
+            shoff, = struct.unpack_from('<Q', self._raw, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self._raw, 0x3A)
+        else:
+            shoff, = struct.unpack_from('<I', self._raw, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self._raw, 0x2E)
+
+        headers = []
+        for index in range(shnum):
+            offset = shoff + index * shentsize
+            if self._is64:
+                name, sh_type, _flags, addr, sh_offset, size, link = struct.unpack_from(
+                    '<IIQQQQI', self._raw, offset)
+            else:
+                name, sh_type, _flags, addr, sh_offset, size, link = struct.unpack_from(
+                    '<IIIIIII', self._raw, offset)
+            headers.append((name, sh_type, addr, sh_offset, size, link))
+
+        names_offset = headers[shstrndx][3]
+        self._headers = headers
+
+        for name, sh_type, addr, sh_offset, size, _link in headers:
+            data = b'' if sh_type == SHT_NOBITS else self._raw[sh_offset:sh_offset + size]
+            self.sections.append(ElfSection(self._cstring(names_offset + name), sh_type, addr, data))
+
+    def _load_symbols(self) -> None:
+        for name, sh_type, _addr, sh_offset, size, link in self._headers:
+            if sh_type != SHT_SYMTAB:
+                continue
+
+            strtab_offset = self._headers[link][3]
+            entry_size = 24 if self._is64 else 16
+
+            for offset in range(sh_offset, sh_offset + size, entry_size):
+                if self._is64:
+                    st_name, st_info, _other, _shndx, value, st_size = struct.unpack_from(
+                        '<IBBHQQ', self._raw, offset)
+                else:
+                    st_name, value, st_size, st_info, _other, _shndx = struct.unpack_from(
+                        '<IIIBBH', self._raw, offset)
+
+                if (st_info & 0xF) == STT_FUNC and value != 0:
+                    self._functions.append((value, st_size, self._cstring(strtab_offset + st_name)))
+
+        self._functions.sort()
+        self._function_addrs = [entry[0] for entry in self._functions]
+
+    def _cstring(self, offset: int) -> str:
+        end = self._raw.find(b'\0', offset)
+        return self._raw[offset:end].decode('utf-8', errors='replace')
+
+    def read_string(self, address: int) -> Optional[str]:
+        """
+        Lê uma string terminada em nulo a partir de um endereço virtual.
+
+        Args:
+            address: Endereço da string no firmware.
+
+        Returns:
+            A string decodificada ou None se o endereço não pertence a nenhuma seção.
+        """
+        if address in self._string_cache:
+            return self._string_cache[address]
+
+        result = None
+        for section in self.sections:
+            if section.type == SHT_PROGBITS and section.addr and section.contains(address):
+                start = address - section.addr
+                end = section.data.find(b'\0', start)
+                if end < 0:
+                    end = len(section.data)
+                result = section.data[start:end].decode('utf-8', errors='replace')
+                break
+
+        self._string_cache[address] = result
+        return result
+
+    def symbolize(self, address: int) -> Optional[str]:
+        """
+        Encontra a função que contém um endereço de código.
+
+        Args:
+            address: Endereço de código.
+
+        Returns:
+            Nome da função (com deslocamento, se não for o início) ou None.
+        """
+        index = bisect.bisect_right(self._function_addrs, address) - 1
+        if index < 0:
+            return None
+
+        start, size, name = self._functions[index]
+        if size and address >= start + size:
+            return None
+
+        return name if address == start else f"{name}+0x{address - start:x}"
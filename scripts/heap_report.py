@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""
+Relatório do HeapProfiler (ambiente esp32dev_heap_profile).
+
+Lê o JSON da rota /heap (diretamente do dispositivo ou de um arquivo salvo),
+converte os endereços dos pontos de chamada em nomes de função usando o
+firmware.elf e imprime as tabelas por tarefa, por ponto de chamada e a
+linha do tempo de fragmentação.
+
+Exemplos:
+    python scripts/heap_report.py --elf .pio/build/esp32dev_heap_profile/firmware.elf \\
+        --url http://192.168.0.10/heap
+    python scripts/heap_report.py --elf firmware.elf --input heap.json --sort live
+
+Autor: Leonardo Sena (slayerlab)
+Versão: 1.0.0
+"""
+
+import argparse
+import json
+import sys
+import urllib.request
+from typing import Any, Dict, List, Optional
+
+from elf_reader import ElfReader
+
+
+SORT_KEYS = ('total', 'live', 'allocs')
+
+
+def load_report(args: argparse.Namespace) -> Dict[str, Any]:
+    """Obtém o JSON da rota /heap ou de um arquivo."""
+    if args.input:
+        with open(args.input, 'r', encoding='utf-8') as handle:
+            return json.load(handle)
+
+    with urllib.request.urlopen(args.url, timeout=10) as response:
+        return json.load(response)
+
+
+def describe_frame(elf: Optional[ElfReader], frame: str) -> str:
+    """Converte um endereço de chamada em 'função+deslocamento'."""
+    address = int(frame, 16)
+    name = elf.symbolize(address) if elf else None
+    return name or frame
+
+
+def print_modules(modules: List[Dict[str, Any]], sort_key: str) -> None:
+    print("Por tarefa")
+    print(f"  {'tarefa':<16} {'allocs':>8} {'frees':>8} {'total':>10} {'vivo':>8} {'pico':>8}")
+    for module in sorted(modules, key=lambda m: m[sort_key], reverse=True):
+        print(f"  {module['name']:<16} {module['allocs']:>8} {module['frees']:>8} "
+              f"{module['total']:>10} {module['live']:>8} {module['peak']:>8}")
+    print()
+
+
+def print_sites(elf: Optional[ElfReader], sites: List[Dict[str, Any]],
+                sort_key: str, limit: int) -> None:
+    print(f"Pontos de chamada (top {limit} por {sort_key})")
+    for site in sorted(sites, key=lambda s: s[sort_key], reverse=True)[:limit]:
+        print(f"  allocs={site['allocs']} frees={site['frees']} "
+              f"total={site['total']} vivo={site['live']}")
+        for frame in site['frames']:
+            print(f"      {describe_frame(elf, frame)}")
+    print()
+
+
+def print_timeline(timeline: Dict[str, Any]) -> None:
+    samples = timeline.get('samples', [])
+    print(f"Linha do tempo (intervalo de {timeline.get('interval', 0)} s, {len(samples)} amostras)")
+    print(f"  {'uptime':>8} {'livre':>8} {'maior':>8} {'frag%':>6} {'blocos':>7}")
+    for uptime, free_heap, largest, fragmentation, live_blocks in samples:
+        print(f"  {uptime:>8} {free_heap:>8} {largest:>8} {fragmentation:>6} {live_blocks:>7}")
+
+    if len(samples) >= 2:
+        first, last = samples[0], samples[-1]
+        print(f"  variação: livre {last[1] - first[1]:+d} bytes, "
+              f"fragmentação {last[3] - first[3]:+d} pontos em {last[0] - first[0]} s")
+    print()
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Relatório de alocações do HeapProfiler")
+    parser.add_argument('--elf', help="firmware.elf para resolver os pontos de chamada")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--url', help="URL da rota /heap do dispositivo")
+    source.add_argument('--input', help="Arquivo com o JSON salvo da rota /heap")
+    parser.add_argument('--sort', choices=SORT_KEYS, default='total', help="Critério de ordenação")
+    parser.add_argument('--top', type=int, default=20, help="Quantidade de pontos de chamada listados")
+    args = parser.parse_args()
+
+    report = load_report(args)
+    elf = ElfReader(args.elf) if args.elf else None
+
+    print(f"Blocos vivos rastreados: {report['liveBlocks']} | "
+          f"alocações fora das tabelas: {report['untracked']}\n")
+    print_modules(report['modules'], args.sort)
+    print_sites(elf, report['sites'], args.sort, args.top)
+    print_timeline(report['timeline'])
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
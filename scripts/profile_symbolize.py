@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""
+Relatório do profiler de funções (ambiente esp32dev_profile).
+
+Lê o JSON da rota /profile/functions (diretamente do dispositivo ou de um
+arquivo salvo), converte os endereços das funções em nomes usando o
+firmware.elf e imprime chamadas, tempo inclusivo e exclusivo por função.
+
+Exemplos:
+    python scripts/profile_symbolize.py --elf .pio/build/esp32dev_profile/firmware.elf \\
+        --url http://192.168.0.10/profile/functions
+    python scripts/profile_symbolize.py --elf firmware.elf --input profile.json --sort incl
+
+Autor: Leonardo Sena (slayerlab)
+Versão: 1.0.0
+"""
+
+import argparse
+import json
+import sys
+import urllib.request
+from typing import Any, Dict, List, Optional
+
+from elf_reader import ElfReader
+
+
+SORT_KEYS = ('excl', 'incl', 'calls')
+
+
+def load_report(args: argparse.Namespace) -> Dict[str, Any]:
+    """Obtém o JSON da rota /profile/functions ou de um arquivo."""
+    if args.input:
+        with open(args.input, 'r', encoding='utf-8') as handle:
+            return json.load(handle)
+
+    with urllib.request.urlopen(args.url, timeout=10) as response:
+        return json.load(response)
+
+
+def describe_function(elf: Optional[ElfReader], address: str) -> str:
+    """Converte o endereço de entrada da função em seu nome."""
+    name = elf.symbolize(int(address, 16)) if elf else None
+    return name or address
+
+
+def print_functions(elf: Optional[ElfReader], functions: List[Dict[str, Any]],
+                    cpu_mhz: int, sort_key: str, limit: int) -> None:
+    total_exclusive = sum(function['excl'] for function in functions) or 1
+
+    print(f"Funções (top {limit} por {sort_key}, tempos em µs a {cpu_mhz} MHz)")
+    print(f"  {'chamadas':>9} {'inclusivo':>12} {'exclusivo':>12} {'excl%':>6} {'µs/chamada':>11}  função")
+    for function in sorted(functions, key=lambda f: f[sort_key], reverse=True)[:limit]:
+        inclusive = function['incl'] / cpu_mhz
+        exclusive = function['excl'] / cpu_mhz
+        per_call = inclusive / function['calls'] if function['calls'] else 0.0
+        share = 100.0 * function['excl'] / total_exclusive
+        print(f"  {function['calls']:>9} {inclusive:>12.1f} {exclusive:>12.1f} {share:>6.1f} "
+              f"{per_call:>11.2f}  {describe_function(elf, function['addr'])}")
+    print()
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Relatório do profiler de funções")
+    parser.add_argument('--elf', help="firmware.elf para resolver os endereços das funções")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--url', help="URL da rota /profile/functions do dispositivo")
+    source.add_argument('--input', help="Arquivo com o JSON salvo da rota /profile/functions")
+    parser.add_argument('--sort', choices=SORT_KEYS, default='excl', help="Critério de ordenação")
+    parser.add_argument('--top', type=int, default=30, help="Quantidade de funções listadas")
+    args = parser.parse_args()
+
+    report = load_report(args)
+    elf = ElfReader(args.elf) if args.elf else None
+    cpu_mhz = report.get('cpuMhz') or 240
+
+    print(f"Funções registradas: {len(report['functions'])} | tarefas: {report['tasks']} | "
+          f"chamadas perdidas: {report['dropped']} | "
+          f"além da profundidade máxima: {report['depthOverflows']}\n")
+    print_functions(elf, report['functions'], cpu_mhz, args.sort, args.top)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+Conversor do trace de eventos (ambiente esp32dev_trace) para JSON do Chrome.
+
+Lê o dump binário da rota /trace (diretamente do dispositivo ou de um
+arquivo salvo) e gera um arquivo no formato Trace Event do Chrome, aberto
+pelo Perfetto (ui.perfetto.dev) ou por chrome://tracing. Cada tarefa vira
+uma trilha; os ciclos CCOUNT de cada core são convertidos em microssegundos
+a partir dos eventos de âncora, que os associam ao esp_timer comum aos
+dois cores.
+
+Exemplos:
+    python scripts/trace_to_chrome.py --url http://192.168.0.10/trace --output trace.json
+    python scripts/trace_to_chrome.py --input trace.bin --output trace.json
+
+Autor: Leonardo Sena (slayerlab)
+Versão: 1.0.0
+"""
+
+import argparse
+import json
+import struct
+import sys
+import urllib.request
+from typing import Any, Dict, List, Tuple
+
+
+MAGIC = b'TRC1'
+EVENT_FORMAT = '<IIiBBBB'
+EVENT_SIZE = struct.calcsize(EVENT_FORMAT)
+ANCHOR = ord('A')
+WRAP = 1 << 32
+
+
+class TraceDump:
+    """Conteúdo decodificado do dump binário."""
+
+    def __init__(self, data: bytes) -> None:
+        if data[:4] != MAGIC:
+            raise ValueError("Dump sem o cabeçalho TRC1")
+
+        version, cores, name_count, task_count = data[4:8]
+        if version != 1:
+            raise ValueError(f"Versão de dump não suportada: {version}")
+        self.cpu_mhz, self.ring_events = struct.unpack_from('<II', data, 8)
+        offset = 16
+
+        self.names, offset = self._read_texts(data, offset, name_count)
+        self.tasks, offset = self._read_texts(data, offset, task_count)
+
+        # Eventos válidos por core, na ordem de gravação
+        self.cores: List[List[Tuple[int, int, int, int, int, int]]] = []
+        for _ in range(cores):
+            head, count = struct.unpack_from('<II', data, offset)
+            offset += 8
+            first = head - count
+            events = []
+            for i in range(count):
+                sequence, timestamp, value, name, task, kind, core = \
+                    struct.unpack_from(EVENT_FORMAT, data, offset)
+                offset += EVENT_SIZE
+                if sequence == first + i + 1:
+                    events.append((timestamp, value, name, task, kind, core))
+            self.cores.append(events)
+
+    @staticmethod
+    def _read_texts(data: bytes, offset: int, count: int) -> Tuple[List[str], int]:
+        texts = []
+        for _ in range(count):
+            length = data[offset]
+            texts.append(data[offset + 1:offset + 1 + length].decode('utf-8', errors='replace'))
+            offset += 1 + length
+        return texts, offset
+
+
+def load_dump(args: argparse.Namespace) -> bytes:
+    """Obtém o dump da rota /trace ou de um arquivo."""
+    if args.input:
+        with open(args.input, 'rb') as handle:
+            return handle.read()
+
+    with urllib.request.urlopen(args.url, timeout=30) as response:
+        return response.read()
+
+
+def signed_delta(current: int, previous: int) -> int:
+    """Diferença entre contadores de 32 bits, tolerando estouro e pequenas inversões."""
+    delta = (current - previous) % WRAP
+    return delta - WRAP if delta >= WRAP // 2 else delta
+
+
+def core_timeline(events: List[Tuple[int, int, int, int, int, int]], cpu_mhz: int) -> List[float]:
+    """Converte os ciclos de um core em µs do esp_timer usando as âncoras."""
+    cycles = []
+    total = 0
+    previous = None
+    for timestamp, *_ in events:
+        if previous is not None:
+            total += signed_delta(timestamp, previous)
+        previous = timestamp
+        cycles.append(total)
+
+    # Âncoras: (ciclos acumulados, µs do esp_timer desembrulhado)
+    anchors = []
+    micros = None
+    for index, (_, value, _, _, kind, _) in enumerate(events):
+        if kind != ANCHOR:
+            continue
+        raw = value % WRAP
+        micros = raw if micros is None else micros + signed_delta(raw, micros % WRAP)
+        anchors.append((cycles[index], micros))
+
+    if not anchors:
+        # Sem âncora no anel: só é possível uma escala relativa ao início
+        anchors.append((0, 0))
+
+    times = []
+    anchor_index = 0
+    for value in cycles:
+        while anchor_index + 1 < len(anchors) and anchors[anchor_index + 1][0] <= value:
+            anchor_index += 1
+        anchor_cycles, anchor_micros = anchors[anchor_index]
+        times.append(anchor_micros + (value - anchor_cycles) / cpu_mhz)
+    return times
+
+
+def convert(dump: TraceDump) -> Dict[str, Any]:
+    trace_events: List[Dict[str, Any]] = []
+
+    for task_id, task_name in enumerate(dump.tasks):
+        trace_events.append({'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': task_id,
+                             'args': {'name': task_name}})
+
+    for events in dump.cores:
+        times = core_timeline(events, dump.cpu_mhz)
+        for (_, value, name_id, task, kind, core), ts in zip(events, times):
+            if kind == ANCHOR:
+                continue
+
+            name = dump.names[name_id] if name_id < len(dump.names) else '?'
+            entry: Dict[str, Any] = {'name': name, 'ph': chr(kind), 'ts': round(ts, 3),
+                                     'pid': 1, 'tid': task}
+            if kind == ord('C'):
+                entry['args'] = {name: value}
+            elif kind == ord('i'):
+                entry['s'] = 't'
+                entry['args'] = {'value': value, 'core': core}
+            else:
+                entry['args'] = {'core': core}
+                if kind == ord('E'):
+                    entry['args']['value'] = value
+            trace_events.append(entry)
+
+    # Ordenação estável: eventos com o mesmo instante mantêm a ordem de gravação
+    trace_events.sort(key=lambda e: e.get('ts', -1))
+    return {'traceEvents': trace_events, 'displayTimeUnit': 'ns'}
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Converte o dump de /trace para JSON do Chrome/Perfetto")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--url', help="URL da rota /trace do dispositivo")
+    source.add_argument('--input', help="Arquivo com o dump binário salvo da rota /trace")
+    parser.add_argument('--output', default='trace.json', help="Arquivo JSON gerado")
+    parser.add_argument('--save-raw', help="Salva também o dump binário recebido")
+    args = parser.parse_args()
+
+    data = load_dump(args)
+    if args.save_raw:
+        with open(args.save_raw, 'wb') as handle:
+            handle.write(data)
+
+    dump = TraceDump(data)
+    result = convert(dump)
+
+    with open(args.output, 'w', encoding='utf-8') as handle:
+        json.dump(result, handle)
+
+    counts = ', '.join(f"core {core}: {len(events)}" for core, events in enumerate(dump.cores))
+    print(f"{len(result['traceEvents'])} eventos ({counts}) em {args.output}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
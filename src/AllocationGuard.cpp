@@ -0,0 +1,117 @@
+/**
+ * @file AllocationGuard.cpp
+ * @brief Implementação dos contadores de alocação após o boot.
+ *
+ * onAllocation() roda dentro dos wrappers de malloc: não pode alocar nem
+ * usar o LogSystem. Os backtraces saem por esp_rom_printf.
+ */
+
+#include "AllocationGuard.h"
+#include "LogSystem.h"
+
+#define MODULE_NAME "AllocGuard"
+
+#if ALLOC_GUARD_ENABLED
+
+#include <esp_debug_helpers.h>
+#include <esp_rom_sys.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static volatile bool s_bootComplete = false;
+static AllocationGuard::Stats s_stats = {};
+static uint32_t s_reports = 0;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Profundidade de escopos protegidos da tarefa atual (TLS do FreeRTOS).
+// Só é lida depois do boot, quando toda alocação parte de uma tarefa.
+static __thread uint8_t t_scopeDepth = 0;
+
+void AllocationGuard::markBootComplete() {
+    portENTER_CRITICAL(&s_lock);
+    s_stats = {};
+    s_stats.bootComplete = true;
+    portEXIT_CRITICAL(&s_lock);
+
+    s_bootComplete = true;
+    LOG_INFO(MODULE_NAME, "Boot concluído - alocações em caminhos críticos serão contadas");
+}
+
+void AllocationGuard::onAllocation(size_t size) {
+    // realloc(ptr, 0) libera o bloco; não é uma alocação
+    if (!s_bootComplete || size == 0) {
+        return;
+    }
+
+    bool hotPath = t_scopeDepth > 0;
+    bool report = false;
+
+    portENTER_CRITICAL(&s_lock);
+    s_stats.steadyAllocs++;
+    if (hotPath) {
+        s_stats.hotPathAllocs++;
+        s_stats.hotPathBytes += size;
+        report = ALLOC_GUARD_BACKTRACE && s_reports < ALLOC_GUARD_MAX_REPORTS;
+        if (report) {
+            s_reports++;
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (report) {
+        esp_rom_printf("\n[AllocGuard] alocação de %u bytes em caminho crítico (%s)\n",
+                       static_cast<unsigned>(size), pcTaskGetTaskName(nullptr));
+        esp_backtrace_print(ALLOC_GUARD_BACKTRACE_DEPTH);
+    }
+}
+
+AllocationGuard::Stats AllocationGuard::getStats() {
+    portENTER_CRITICAL(&s_lock);
+    Stats stats = s_stats;
+    portEXIT_CRITICAL(&s_lock);
+    return stats;
+}
+
+uint32_t AllocationGuard::getViolationCount() {
+    return s_stats.hotPathAllocs;
+}
+
+AllocationGuard::Scope::Scope() {
+    t_scopeDepth++;
+}
+
+AllocationGuard::Scope::~Scope() {
+    t_scopeDepth--;
+}
+
+AllocationGuard::Exempt::Exempt() : m_savedDepth(t_scopeDepth) {
+    t_scopeDepth = 0;
+}
+
+AllocationGuard::Exempt::~Exempt() {
+    t_scopeDepth = m_savedDepth;
+}
+
+#else
+
+void AllocationGuard::markBootComplete() {}
+
+void AllocationGuard::onAllocation(size_t) {}
+
+AllocationGuard::Stats AllocationGuard::getStats() {
+    return Stats();
+}
+
+uint32_t AllocationGuard::getViolationCount() {
+    return 0;
+}
+
+AllocationGuard::Scope::Scope() {}
+
+AllocationGuard::Scope::~Scope() {}
+
+AllocationGuard::Exempt::Exempt() : m_savedDepth(0) {}
+
+AllocationGuard::Exempt::~Exempt() {}
+
+#endif // ALLOC_GUARD_ENABLED
@@ -7,6 +7,18 @@
 #include "LogSystem.h"
 #include "OutputManager.h"
 #include "TelemetryBuffer.h"
+#include "CrashLog.h"
+#include "ConsoleWriter.h"
+#include "RequestArena.h"
+#include "HeapProfiler.h"
+#include "AllocationGuard.h"
+#include "Profiling.h"
+#include "ProfileZone.h"
+#include "TraceRecorder.h"
+#include "SensorTraceRecorder.h"
+#include "InstrumentedMutex.h"
+#include "JobScheduler.h"
+#include <atomic>
 
 // Nome do módulo para logs
 #define MODULE_NAME "WebServer"
@@ -404,6 +416,724 @@ const char AsyncSoilWebServer::INDEX_HTML[] PROGMEM = R"rawliteral(
 // Uma vez que a biblioteca não fornece meios de associar o ponteiro this ao websocket
 static AsyncSoilWebServer* s_instance = nullptr;
 
+/**
+ * Filler comum das respostas chunked: copia até maxLen bytes do buffer
+ * pendente do gerador, chamando refill() sempre que ele se esgota.
+ */
+template <typename Stream>
+static size_t drainChunks(Stream& stream, uint8_t* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (stream.pendingSent == stream.pendingLength && !stream.refill()) {
+            break;
+        }
+        size_t chunk = stream.pendingLength - stream.pendingSent;
+        if (chunk > maxLen - written) {
+            chunk = maxLen - written;
+        }
+        memcpy(buffer + written, &stream.pending[stream.pendingSent], chunk);
+        stream.pendingSent += chunk;
+        written += chunk;
+    }
+    return written;
+}
+
+/**
+ * Gera o texto de /logs uma linha por vez: o anel atual por um
+ * CircularLogBuffer::Iterator, o boot anterior por índice. Só a linha
+ * corrente fica na arena, então o log inteiro nunca precisa caber nela.
+ */
+struct LogTextStream {
+    CircularLogBuffer::Iterator iterator;
+    CircularLogBuffer::Record record;
+    bool previousBoot;
+    uint8_t phase;          // 0 = cabeçalho, 1 = linhas, 2 = fim
+    uint16_t previousIndex;
+    char pending[LOG_LINE_MAX_SIZE];
+    uint16_t pendingLength;
+    uint16_t pendingSent;
+
+    explicit LogTextStream(bool previous)
+        : iterator(CircularLogBuffer::getInstance().newest()), previousBoot(previous),
+          phase(0), previousIndex(0), pendingLength(0), pendingSent(0) {}
+
+    // Formata a próxima linha; retorna false ao terminar
+    bool refill() {
+        pendingLength = 0;
+        pendingSent = 0;
+
+        if (phase == 0) {
+            pendingLength = previousBoot ?
+                CrashLog::formatPreviousHeader(pending, sizeof(pending)) :
+                CircularLogBuffer::getInstance().formatHeader(pending, sizeof(pending));
+            phase = 1;
+        } else if (phase == 1) {
+            if (previousBoot) {
+                pendingLength = CrashLog::formatPreviousEntry(previousIndex++, pending, sizeof(pending));
+            } else if (iterator.next(record)) {
+                pendingLength = CircularLogBuffer::formatRecord(record, pending, sizeof(pending));
+            }
+            if (pendingLength == 0) {
+                phase = 2;
+            }
+        }
+
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+
+/**
+ * Gera {"logs":["linha",...]} a partir das linhas de um LogTextStream,
+ * sob demanda, para uma resposta chunked.
+ */
+struct LogJsonStream {
+    LogTextStream text;     // Linha corrente em text.pending, lida até text.pendingSent
+    uint16_t lines;
+    uint8_t phase;          // 0 = prefixo, 1 = linhas, 2 = sufixo, 3 = fim
+    bool lineOpen;
+    char pending[32];       // Trecho gerado ainda não enviado
+    uint8_t pendingLength;
+    uint8_t pendingSent;
+
+    explicit LogJsonStream(bool previousBoot)
+        : text(previousBoot), lines(0), phase(0), lineOpen(false),
+          pendingLength(0), pendingSent(0) {}
+
+    // Acrescenta um trecho indivisível ao buffer pendente, se couber
+    bool put(const char* piece, size_t pieceLength) {
+        if (pendingLength + pieceLength > sizeof(pending)) {
+            return false;
+        }
+        memcpy(&pending[pendingLength], piece, pieceLength);
+        pendingLength += pieceLength;
+        return true;
+    }
+
+    // Gera o próximo bloco de JSON; retorna false ao terminar
+    bool refill() {
+        pendingLength = 0;
+        pendingSent = 0;
+
+        while (phase < 3) {
+            if (phase == 0) {
+                if (!put("{\"logs\":[", 9)) break;
+                phase = 1;
+            } else if (phase == 1) {
+                if (!lineOpen) {
+                    // Pula linhas vazias entre entradas
+                    while (text.pendingSent < text.pendingLength &&
+                           text.pending[text.pendingSent] == '\n') {
+                        text.pendingSent++;
+                    }
+                    if (text.pendingSent >= text.pendingLength) {
+                        if (!text.refill()) {
+                            phase = 2;
+                        }
+                        continue;
+                    }
+                    // Separador entre linhas e abertura da string
+                    if (!put(lines > 0 ? ",\"" : "\"", lines > 0 ? 2 : 1)) break;
+                    lineOpen = true;
+                    continue;
+                }
+
+                // Linha truncada sem '\n' também é fechada no fim do texto
+                char c = text.pendingSent < text.pendingLength ? text.pending[text.pendingSent] : '\n';
+                char escaped[7];
+                size_t escapedLength;
+
+                if (c == '\n') {
+                    if (!put("\"", 1)) break;
+                    lineOpen = false;
+                    lines++;
+                    if (text.pendingSent < text.pendingLength) {
+                        text.pendingSent++;
+                    }
+                    continue;
+                } else if (c == '"' || c == '\\') {
+                    escaped[0] = '\\';
+                    escaped[1] = c;
+                    escapedLength = 2;
+                } else if (static_cast<uint8_t>(c) < 0x20) {
+                    escapedLength = snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<uint8_t>(c));
+                } else {
+                    escaped[0] = c;
+                    escapedLength = 1;
+                }
+
+                if (!put(escaped, escapedLength)) break;
+                text.pendingSent++;
+            } else {
+                if (!put("]}", 2)) break;
+                phase = 3;
+            }
+        }
+
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+
+static_assert(sizeof(LogJsonStream) <= REQUEST_ARENA_SLAB_SIZE,
+              "O gerador de /logs deve caber em um slab da arena");
+
+/**
+ * Gera o JSON de /locks, um mutex por vez, a partir das cópias dos
+ * contadores feitas por InstrumentedMutex::getStats().
+ */
+struct LocksJsonStream {
+    uint8_t index;
+    uint8_t phase;          // 0 = cabeçalho, 1 = mutexes, 2 = fim
+    char pending[448];
+    uint16_t pendingLength;
+    uint16_t pendingSent;
+
+    LocksJsonStream() : index(0), phase(0), pendingLength(0), pendingSent(0) {}
+
+    void append(const char* fmt, ...) {
+        va_list args;
+        va_start(args, fmt);
+        int length = vsnprintf(pending + pendingLength, sizeof(pending) - pendingLength, fmt, args);
+        va_end(args);
+        // Truncado, vsnprintf retorna o tamanho que o texto teria
+        size_t room = sizeof(pending) - 1 - pendingLength;
+        if (length > 0) {
+            pendingLength += static_cast<size_t>(length) < room ? length : room;
+        }
+    }
+
+    void appendHistogram(const char* key, const uint32_t* histogram) {
+        append(",\"%s\":[", key);
+        for (uint8_t b = 0; b < InstrumentedMutex::HISTOGRAM_BUCKETS; b++) {
+            append(b ? ",%u" : "%u", histogram[b]);
+        }
+        append("]");
+    }
+
+    bool refill() {
+        pendingLength = 0;
+        pendingSent = 0;
+        InstrumentedMutex::Stats stats;
+
+        switch (phase) {
+            case 0:
+                append("{\"enabled\":%s,\"boundsUs\":[", LOCK_PROFILE_ENABLED ? "true" : "false");
+                for (uint8_t b = 0; b < InstrumentedMutex::HISTOGRAM_BUCKETS - 1; b++) {
+                    append(b ? ",%u" : "%u", InstrumentedMutex::HISTOGRAM_BOUNDS[b]);
+                }
+                append("],\"locks\":[");
+                phase = 1;
+                break;
+
+            case 1:
+                if (InstrumentedMutex::getStats(index, stats)) {
+                    append("%s{\"name\":\"%s\",\"acquisitions\":%u,\"contended\":%u,\"timeouts\":%u,"
+                           "\"waitTotalUs\":%llu,\"waitMaxUs\":%u,\"holdTotalUs\":%llu,\"holdMaxUs\":%u",
+                           index ? "," : "", stats.name, stats.acquisitions, stats.contended, stats.timeouts,
+                           static_cast<unsigned long long>(stats.totalWaitMicros), stats.maxWaitMicros,
+                           static_cast<unsigned long long>(stats.totalHoldMicros), stats.maxHoldMicros);
+                    appendHistogram("wait", stats.waitHistogram);
+                    appendHistogram("hold", stats.holdHistogram);
+                    append(",\"owner\":\"%s\",\"lastTimeout\":{\"waiter\":\"%s\",\"holder\":\"%s\"}}",
+                           stats.owner, stats.lastTimeoutWaiter, stats.lastTimeoutHolder);
+                    index++;
+                } else {
+                    append("]}");
+                    phase = 2;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+
+/**
+ * Gera o JSON de /jobs, um job por vez, a partir das cópias dos contadores
+ * feitas por JobScheduler::getStats().
+ */
+struct JobsJsonStream {
+    uint8_t index;
+    uint8_t phase;          // 0 = cabeçalho, 1 = jobs, 2 = fim
+    char pending[320];
+    uint16_t pendingLength;
+    uint16_t pendingSent;
+
+    JobsJsonStream() : index(0), phase(0), pendingLength(0), pendingSent(0) {}
+
+    bool refill() {
+        pendingSent = 0;
+        int length = 0;
+        JobScheduler::Stats stats;
+
+        switch (phase) {
+            case 0:
+                length = snprintf(pending, sizeof(pending), "{\"tickMs\":%u,\"jobs\":[",
+                                  JOB_SCHEDULER_TICK_MS);
+                phase = 1;
+                break;
+
+            case 1:
+                if (JobScheduler::getStats(index, stats)) {
+                    length = snprintf(pending, sizeof(pending),
+                        "%s{\"name\":\"%s\",\"core\":%u,\"periodMs\":%u,\"phaseMs\":%u,"
+                        "\"runs\":%u,\"skipped\":%u,\"runLastUs\":%u,\"runMaxUs\":%u,\"runTotalUs\":%llu,"
+                        "\"lateLastUs\":%u,\"lateMaxUs\":%u,\"lateTotalUs\":%llu}",
+                        index ? "," : "", stats.name, stats.core, stats.periodMs, stats.phaseMs,
+                        stats.runs, stats.skipped, stats.lastRunMicros, stats.maxRunMicros,
+                        static_cast<unsigned long long>(stats.totalRunMicros),
+                        stats.lastLateMicros, stats.maxLateMicros,
+                        static_cast<unsigned long long>(stats.totalLateMicros));
+                    index++;
+                } else {
+                    length = snprintf(pending, sizeof(pending), "]}");
+                    phase = 2;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        if (length < 0) {
+            length = 0;
+        }
+        pendingLength = static_cast<size_t>(length) < sizeof(pending) ? length : sizeof(pending) - 1;
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+
+#if HEAP_PROFILE_ENABLED
+/**
+ * Gera o JSON de /heap a partir de um snapshot do HeapProfiler, um item
+ * por vez. O gerador vive na arena da requisição; o snapshot, maior que um
+ * slab, é estático e atende uma requisição por vez.
+ */
+struct HeapJsonStream {
+    const HeapProfiler::Snapshot* snapshot;
+    uint16_t index;
+    uint8_t phase;          // 0 = cabeçalho, 1 = módulos, 2 = sites, 3 = linha do tempo, 4 = sufixo, 5 = fim
+    char pending[160];
+    uint8_t pendingLength;
+    uint8_t pendingSent;
+
+    explicit HeapJsonStream(const HeapProfiler::Snapshot* source)
+        : snapshot(source), index(0), phase(0), pendingLength(0), pendingSent(0) {}
+
+    bool refill() {
+        pendingSent = 0;
+        int length = 0;
+        const char* separator = index > 0 ? "," : "";
+
+        switch (phase) {
+            case 0:
+                length = snprintf(pending, sizeof(pending),
+                    "{\"liveBlocks\":%u,\"untracked\":%u,\"modules\":[",
+                    snapshot->liveBlocks, snapshot->untracked);
+                phase = 1;
+                break;
+
+            case 1:
+                if (index < snapshot->moduleCount) {
+                    const HeapProfiler::ModuleStats& module = snapshot->modules[index];
+                    length = snprintf(pending, sizeof(pending),
+                        "%s{\"name\":\"%s\",\"allocs\":%u,\"frees\":%u,\"total\":%u,\"live\":%u,\"peak\":%u}",
+                        separator, module.name, module.allocCount, module.freeCount,
+                        module.totalBytes, module.liveBytes, module.peakLiveBytes);
+                    index++;
+                } else {
+                    length = snprintf(pending, sizeof(pending), "],\"sites\":[");
+                    index = 0;
+                    phase = 2;
+                }
+                break;
+
+            case 2:
+                if (index < snapshot->siteCount) {
+                    const HeapProfiler::SiteStats& site = snapshot->sites[index];
+                    length = snprintf(pending, sizeof(pending), "%s{\"frames\":[", separator);
+                    for (int i = 0; i < HEAP_PROFILE_SITE_DEPTH && site.frames[i] != 0; i++) {
+                        length += snprintf(&pending[length], sizeof(pending) - length,
+                            "%s\"0x%08x\"", i > 0 ? "," : "", site.frames[i]);
+                    }
+                    length += snprintf(&pending[length], sizeof(pending) - length,
+                        "],\"allocs\":%u,\"frees\":%u,\"total\":%u,\"live\":%u}",
+                        site.allocCount, site.freeCount, site.totalBytes, site.liveBytes);
+                    index++;
+                } else {
+                    length = snprintf(pending, sizeof(pending),
+                        "],\"timeline\":{\"interval\":%u,\"samples\":[",
+                        HEAP_PROFILE_SAMPLE_INTERVAL_MS / 1000);
+                    index = 0;
+                    phase = 3;
+                }
+                break;
+
+            case 3:
+                if (index < snapshot->timelineCount) {
+                    // [uptime, livre, maior bloco, fragmentação %, blocos vivos]
+                    const HeapProfiler::TimelineSample& entry = snapshot->timeline[index];
+                    length = snprintf(pending, sizeof(pending), "%s[%u,%u,%u,%u,%u]",
+                        separator, entry.uptime, entry.freeHeap, entry.largestBlock,
+                        entry.fragmentation, entry.liveBlocks);
+                    index++;
+                } else {
+                    phase = 4;
+                    return refill();
+                }
+                break;
+
+            case 4:
+                length = snprintf(pending, sizeof(pending), "]}}");
+                phase = 5;
+                break;
+
+            default:
+                break;
+        }
+
+        pendingLength = length;
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+#endif // HEAP_PROFILE_ENABLED
+
+#if FUNCTION_PROFILE_ENABLED
+/**
+ * Gera o JSON de /profile/functions percorrendo a tabela do Profiling,
+ * uma posição ocupada por vez. Os totais são lidos durante o envio.
+ */
+struct FunctionProfileJsonStream {
+    size_t slot;
+    uint16_t count;
+    uint8_t phase;          // 0 = cabeçalho, 1 = funções, 2 = sufixo, 3 = fim
+    char pending[112];
+    uint8_t pendingLength;
+    uint8_t pendingSent;
+
+    FunctionProfileJsonStream()
+        : slot(0), count(0), phase(0), pendingLength(0), pendingSent(0) {}
+
+    bool refill() {
+        pendingSent = 0;
+        int length = 0;
+
+        switch (phase) {
+            case 0:
+                length = snprintf(pending, sizeof(pending),
+                    "{\"cpuMhz\":%u,\"functions\":[", getCpuFrequencyMhz());
+                phase = 1;
+                break;
+
+            case 1: {
+                Profiling::FunctionStats stats;
+                while (slot < PROFILE_MAX_FUNCTIONS && !Profiling::getFunction(slot, stats)) {
+                    slot++;
+                }
+                if (slot < PROFILE_MAX_FUNCTIONS) {
+                    length = snprintf(pending, sizeof(pending),
+                        "%s{\"addr\":\"0x%08x\",\"calls\":%u,\"incl\":%llu,\"excl\":%llu}",
+                        count > 0 ? "," : "", stats.address, stats.calls,
+                        static_cast<unsigned long long>(stats.inclusiveCycles),
+                        static_cast<unsigned long long>(stats.exclusiveCycles));
+                    slot++;
+                    count++;
+                } else {
+                    phase = 2;
+                    return refill();
+                }
+                break;
+            }
+
+            case 2: {
+                Profiling::Summary summary = Profiling::getSummary();
+                length = snprintf(pending, sizeof(pending),
+                    "],\"dropped\":%u,\"depthOverflows\":%u,\"tasks\":%u}",
+                    summary.droppedCalls, summary.depthOverflows, summary.tasks);
+                phase = 3;
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        pendingLength = length;
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+#endif // FUNCTION_PROFILE_ENABLED
+
+#if PROFILE_ZONES_ENABLED
+/**
+ * Gera o JSON de /profile percorrendo a lista de zonas, uma por vez.
+ * As zonas são estáticas; só o gerador vive na arena da requisição.
+ */
+struct ZoneProfileJsonStream {
+    const ProfileZone* zone;
+    float cpuMhz;
+    bool first;
+    uint8_t phase;          // 0 = cabeçalho, 1 = zonas, 2 = fim
+    char pending[192];
+    uint8_t pendingLength;
+    uint8_t pendingSent;
+
+    ZoneProfileJsonStream()
+        : zone(ProfileZone::first()), cpuMhz(getCpuFrequencyMhz()), first(true), phase(0),
+          pendingLength(0), pendingSent(0) {}
+
+    bool refill() {
+        pendingSent = 0;
+        int length = 0;
+
+        switch (phase) {
+            case 0:
+                length = snprintf(pending, sizeof(pending),
+                    "{\"cpuMhz\":%u,\"zones\":[", static_cast<unsigned>(cpuMhz));
+                phase = 1;
+                break;
+
+            case 1:
+                if (zone) {
+                    // Tempos em µs; p50/p99 são o limite superior da faixa do histograma
+                    ProfileZone::Summary summary = zone->summarize();
+                    float mean = summary.count ? summary.totalCycles / static_cast<float>(summary.count) : 0.0f;
+                    length = snprintf(pending, sizeof(pending),
+                        "%s{\"name\":\"%s\",\"count\":%u,\"mean\":%.1f,\"p50\":%.1f,\"p99\":%.1f,\"max\":%.1f,\"migrated\":%u}",
+                        first ? "" : ",", summary.name, summary.count, mean / cpuMhz,
+                        summary.p50 / cpuMhz, summary.p99 / cpuMhz, summary.max / cpuMhz,
+                        summary.migrated);
+                    zone = zone->next();
+                    first = false;
+                } else {
+                    length = snprintf(pending, sizeof(pending), "]}");
+                    phase = 2;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        pendingLength = length;
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+#endif // PROFILE_ZONES_ENABLED
+
+#if TRACE_ENABLED
+/**
+ * Exporta os anéis do TraceRecorder em formato binário (little-endian):
+ * cabeçalho "TRC1", tabelas de nomes e tarefas (comprimento + texto) e,
+ * para cada core, a posição de escrita, a quantidade de eventos e os
+ * eventos de 16 bytes do mais antigo ao mais recente.
+ */
+struct TraceDumpStream {
+    uint8_t phase;          // 0 = cabeçalho, 1 = nomes, 2 = tarefas, 3 = core, 4 = eventos, 5 = fim
+    uint8_t index;
+    uint8_t core;
+    uint32_t position;
+    uint32_t end;
+    uint8_t pending[64];
+    uint8_t pendingLength;
+    uint8_t pendingSent;
+
+    TraceDumpStream()
+        : phase(0), index(0), core(0), position(0), end(0), pendingLength(0), pendingSent(0) {}
+
+    void putU32(uint32_t value) {
+        memcpy(&pending[pendingLength], &value, sizeof(value));
+        pendingLength += sizeof(value);
+    }
+
+    void putText(const char* text) {
+        size_t length = strnlen(text, sizeof(pending) - 1);
+        pending[pendingLength++] = static_cast<uint8_t>(length);
+        memcpy(&pending[pendingLength], text, length);
+        pendingLength += length;
+    }
+
+    bool refill() {
+        pendingLength = 0;
+        pendingSent = 0;
+
+        switch (phase) {
+            case 0:
+                memcpy(pending, "TRC1", 4);
+                pending[4] = 1;
+                pending[5] = TraceRecorder::CORE_COUNT;
+                pending[6] = TraceRecorder::getNameCount();
+                pending[7] = TraceRecorder::getTaskCount();
+                pendingLength = 8;
+                putU32(getCpuFrequencyMhz());
+                putU32(TRACE_RING_EVENTS);
+                phase = 1;
+                break;
+
+            case 1:
+                if (index < TraceRecorder::getNameCount()) {
+                    putText(TraceRecorder::getName(index++));
+                } else {
+                    index = 0;
+                    phase = 2;
+                    return refill();
+                }
+                break;
+
+            case 2:
+                if (index < TraceRecorder::getTaskCount()) {
+                    putText(TraceRecorder::getTaskName(index++));
+                } else {
+                    phase = 3;
+                    return refill();
+                }
+                break;
+
+            case 3:
+                if (core < TraceRecorder::CORE_COUNT) {
+                    end = TraceRecorder::getHead(core);
+                    position = end > TRACE_RING_EVENTS ? end - TRACE_RING_EVENTS : 0;
+                    putU32(end);
+                    putU32(end - position);
+                    phase = 4;
+                } else {
+                    phase = 5;
+                }
+                break;
+
+            case 4:
+                // Eventos sobrescritos ou em escrita saem com sequência 0
+                while (position < end && pendingLength + sizeof(TraceRecorder::Event) <= sizeof(pending)) {
+                    TraceRecorder::Event event;
+                    if (!TraceRecorder::readEvent(core, position, event)) {
+                        memset(&event, 0, sizeof(event));
+                    }
+                    memcpy(&pending[pendingLength], &event, sizeof(event));
+                    pendingLength += sizeof(event);
+                    position++;
+                }
+                if (position == end) {
+                    core++;
+                    phase = 3;
+                }
+                if (pendingLength == 0) {
+                    return refill();
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+#endif // TRACE_ENABLED
+
+#if SENSOR_TRACE_ENABLED
+/**
+ * Exporta o anel do SensorTraceRecorder no formato descrito em
+ * SensorTraceRecorder.h. Registros sobrescritos durante o envio saem
+ * zerados (timestamp 0).
+ */
+struct SensorTraceDumpStream {
+    uint8_t phase;          // 0 = cabeçalho, 1 = registros, 2 = fim
+    uint32_t position;
+    uint32_t end;
+    uint8_t pending[60];
+    uint8_t pendingLength;
+    uint8_t pendingSent;
+
+    SensorTraceDumpStream()
+        : phase(0), position(0), end(0), pendingLength(0), pendingSent(0) {}
+
+    void putU32(uint32_t value) {
+        memcpy(&pending[pendingLength], &value, sizeof(value));
+        pendingLength += sizeof(value);
+    }
+
+    bool refill() {
+        pendingLength = 0;
+        pendingSent = 0;
+
+        switch (phase) {
+            case 0:
+                end = SensorTraceRecorder::getHead();
+                position = SensorTraceRecorder::getTail();
+                memcpy(pending, "STR1", 4);
+                pending[4] = SensorTraceRecorder::FORMAT_VERSION;
+                pending[5] = sizeof(SensorTraceRecorder::Record);
+                pending[6] = 0;
+                pending[7] = 0;
+                pendingLength = 8;
+                putU32(end - position);
+                putU32(SensorTraceRecorder::getDropped());
+                putU32(end);
+                phase = 1;
+                break;
+
+            case 1:
+                while (position < end && pendingLength + sizeof(SensorTraceRecorder::Record) <= sizeof(pending)) {
+                    SensorTraceRecorder::Record record;
+                    if (!SensorTraceRecorder::readRecord(position, record)) {
+                        memset(&record, 0, sizeof(record));
+                    }
+                    memcpy(&pending[pendingLength], &record, sizeof(record));
+                    pendingLength += sizeof(record);
+                    position++;
+                }
+                if (position == end) {
+                    phase = 2;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        return pendingLength > 0;
+    }
+
+    size_t read(uint8_t* buffer, size_t maxLen) {
+        return drainChunks(*this, buffer, maxLen);
+    }
+};
+#endif // SENSOR_TRACE_ENABLED
+
 AsyncSoilWebServer::AsyncSoilWebServer(uint16_t port, SensorManager &sensorManager)
     : m_server(port),
     m_websocket("/ws"),
@@ -434,6 +1164,51 @@ bool AsyncSoilWebServer::begin() {
     m_server.on("/logs", HTTP_GET,
         [this](AsyncWebServerRequest *request) { handleLogs(request); });
 
+    // Rota para os contadores do console serial
+    m_server.on("/console", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleConsole(request); });
+
+    // Rota para a contenção dos mutexes instrumentados
+    m_server.on("/locks", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleLocks(request); });
+
+    // Rota para o tempo de execução e o atraso dos jobs periódicos
+    m_server.on("/jobs", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleJobs(request); });
+
+#if HEAP_PROFILE_ENABLED
+    // Rota para a atribuição de alocações e a linha do tempo do heap
+    m_server.on("/heap", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleHeap(request); });
+#endif
+
+#if FUNCTION_PROFILE_ENABLED
+    // Rota para os totais por função (ambiente esp32dev_profile)
+    m_server.on("/profile/functions", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleFunctionProfile(request); });
+#endif
+
+#if PROFILE_ZONES_ENABLED
+    // Rota para os percentis das zonas de tempo
+    m_server.on("/profile", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleZoneProfile(request); });
+#endif
+
+#if TRACE_ENABLED
+    // Rota para o dump binário do trace (scripts/trace_to_chrome.py)
+    m_server.on("/trace", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleTrace(request); });
+#endif
+
+#if SENSOR_TRACE_ENABLED
+    // Rota para as leituras brutas dos sensores (host/sim/SensorReplay.cpp)
+    m_server.on("/sensors/trace", HTTP_GET,
+        [this](AsyncWebServerRequest *request) { handleSensorTrace(request); });
+#endif
+
+    // Limpeza de clientes inativos na tarefa web, fora da fase do "wifi.check"
+    JobScheduler::add("ws.cleanup", 5000, 500, TASK_WEB_CORE, cleanupJob, this);
+
     // Handler para rotas não encontradas
     m_server.onNotFound(
         [this](AsyncWebServerRequest *request) { handleNotFound(request); });
@@ -448,6 +1223,8 @@ bool AsyncSoilWebServer::begin() {
 }
 
 void AsyncSoilWebServer::handleRoot(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.root");
+
     // Envia a página HTML
     request->send(200, "text/html", INDEX_HTML);
 
@@ -462,6 +1239,9 @@ void AsyncSoilWebServer::handleRoot(AsyncWebServerRequest *request) {
 }
 
 void AsyncSoilWebServer::handleData(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.data");
+    TRACE_SCOPE("http.data");
+
     // Força atualização dos sensores
     m_sensorManager.update(true);
 
@@ -483,12 +1263,8 @@ void AsyncSoilWebServer::handleData(AsyncWebServerRequest *request) {
     sensors["timestamp"] = telemetry.timestamp;
     sensors["readCount"] = telemetry.readCount;
 
-    // Serializa para string
-    String response;
-    serializeJson(doc, response);
-
-    // Envia a resposta
-    request->send(200, "application/json", response);
+    // Serializa na arena da requisição e envia sem cópia para o heap
+    sendJson(request, doc);
 
     if (DEBUG_MODE) {
         {
@@ -501,62 +1277,52 @@ void AsyncSoilWebServer::handleData(AsyncWebServerRequest *request) {
 }
 
 void AsyncSoilWebServer::handleLogs(AsyncWebServerRequest *request) {
-    // Tamanho máximo do buffer para armazenar os logs
-    const size_t bufferSize = LOG_BUFFER_SIZE * (LOG_MAX_MESSAGE_SIZE + 64);
-
-    // Aloca buffer para armazenar os logs
-    char* logBuffer = new char[bufferSize];
-    if (!logBuffer) {
-        // Caso não consiga alocar memória, retorna erro
-        LOG_ERROR(MODULE_NAME, "Falha ao alocar memória para buffer de logs");
-        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
-        return;
-    }
-
-    // Inicializa o buffer
-    memset(logBuffer, 0, bufferSize);
-
-    // Obtém os logs do buffer circular
-    size_t bytesWritten = LogRouter::getInstance().getStoredLogs(logBuffer, bufferSize - 1);
+    PROFILE_ZONE("http.logs");
 
-    if (bytesWritten == 0) {
-        // Se não há logs, retorna array vazio
-        delete[] logBuffer;
-        request->send(200, "application/json", "{\"logs\":[]}");
+    // Memória de trabalho da requisição, devolvida quando a conexão fecha
+    ScopedArena arena;
+    if (!arena) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
         return;
     }
 
-    // Verifica o parâmetro de formato - padrão é JSON
-    String format = request->hasParam("format") ? request->getParam("format")->value() : "json";
+    // ?boot=previous retorna o log recuperado da RTC RAM após um reset
+    bool previousBoot = request->hasParam("boot") &&
+                        request->getParam("boot")->value().equalsIgnoreCase("previous");
 
-    if (format.equalsIgnoreCase("text") || format.equalsIgnoreCase("plain")) {
-        // Retorna como texto simples
-        AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", logBuffer);
-        request->send(response);
+    // Verifica o parâmetro de formato - padrão é JSON
+    const char* format = request->hasParam("format") ?
+        request->getParam("format")->value().c_str() : "json";
+    bool plainText = strcasecmp(format, "text") == 0 || strcasecmp(format, "plain") == 0;
+
+    // Os logs são lidos uma linha por vez à medida que a resposta é enviada,
+    // então a resposta nunca é truncada pelo tamanho da arena
+    AsyncWebServerResponse *response = nullptr;
+    if (plainText) {
+        LogTextStream* stream = arena->create<LogTextStream>(previousBoot);
+        if (stream) {
+            response = request->beginChunkedResponse("text/plain",
+                [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+                    return stream->read(buffer, maxLen);
+                });
+        }
     } else {
-        // Formata como JSON
-        StaticJsonDocument<512> doc;
-        JsonArray logs = doc.createNestedArray("logs");
-
-        // Converte as linhas de log em um array JSON
-        char* line = strtok(logBuffer, "\n");
-        while (line != nullptr) {
-            if (strlen(line) > 0) {
-                logs.add(line);
-            }
-            line = strtok(nullptr, "\n");
+        LogJsonStream* stream = arena->create<LogJsonStream>(previousBoot);
+        if (stream) {
+            response = request->beginChunkedResponse("application/json",
+                [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+                    return stream->read(buffer, maxLen);
+                });
         }
+    }
 
-        // Serializa o documento JSON
-        String jsonResponse;
-        serializeJson(doc, jsonResponse);
-
-        // Envia a resposta
-        request->send(200, "application/json", jsonResponse);
+    if (!response) {
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
     }
 
-    // Libera o buffer
-    delete[] logBuffer;
+    attachArena(request, arena.detach());
+    request->send(response);
 
     if (DEBUG_MODE) {
         {
@@ -564,67 +1330,311 @@ void AsyncSoilWebServer::handleLogs(AsyncWebServerRequest *request) {
             char ipStr[16];
             snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
             DBG_DEBUG(MODULE_NAME, "API logs requisitada por %s (formato: %s)",
-                ipStr, format.c_str());
+                ipStr, format);
         }
     }
 }
 
-void AsyncSoilWebServer::handleNotFound(AsyncWebServerRequest *request) {
-    // Envia resposta 404
-    request->send(404, "text/plain", "Página não encontrada");
+void AsyncSoilWebServer::handleConsole(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.console");
 
-    if (DEBUG_MODE) {
-        {
-            IPAddress ip = request->client()->remoteIP();
-            char ipStr[16];
-            snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
-            DBG_DEBUG(MODULE_NAME, "404 - %s (IP: %s)",
-                request->url().c_str(), ipStr);
-        }
+    ConsoleWriter::Stats stats = ConsoleWriter::getStats();
+
+    StaticJsonDocument<256> doc;
+    doc["bytesQueued"] = stats.bytesQueued;
+    doc["bytesDropped"] = stats.bytesDropped;
+    doc["messagesDropped"] = stats.messagesDropped;
+    doc["blockedMicros"] = stats.blockedMicros;
+    doc["maxBlockedMicros"] = stats.maxBlockedMicros;
+    doc["txFree"] = ConsoleWriter::getFreeSpace();
+    doc["txBufferSize"] = CONSOLE_TX_BUFFER_SIZE;
+
+    sendJson(request, doc);
+}
+
+void AsyncSoilWebServer::handleLocks(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.locks");
+
+    // ?reset=1 zera os contadores para medir uma janela específica
+    if (request->hasParam("reset")) {
+        InstrumentedMutex::resetAll();
+        request->send(200, "application/json", "{\"reset\":true}");
+        return;
+    }
+
+    ScopedArena arena;
+    if (!arena) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
+        return;
+    }
+
+    LocksJsonStream* stream = arena->create<LocksJsonStream>();
+    if (!stream) {
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
+    }
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+        [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+            return stream->read(buffer, maxLen);
+        });
+    attachArena(request, arena.detach());
+    request->send(response);
+}
+
+void AsyncSoilWebServer::handleJobs(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.jobs");
+
+    // ?reset=1 zera os contadores para medir uma janela específica
+    if (request->hasParam("reset")) {
+        JobScheduler::resetStats();
+        request->send(200, "application/json", "{\"reset\":true}");
+        return;
+    }
+
+    ScopedArena arena;
+    if (!arena) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
+        return;
+    }
+
+    JobsJsonStream* stream = arena->create<JobsJsonStream>();
+    if (!stream) {
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
+    }
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+        [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+            return stream->read(buffer, maxLen);
+        });
+    attachArena(request, arena.detach());
+    request->send(response);
+}
+
+#if HEAP_PROFILE_ENABLED
+void AsyncSoilWebServer::handleHeap(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.heap");
+
+    // O snapshot (alguns KB) fica fora da pilha da tarefa do servidor e não
+    // cabe em um slab: uma única cópia estática, liberada no disconnect
+    static HeapProfiler::Snapshot s_snapshot;
+    static std::atomic<bool> s_snapshotInUse(false);
+
+    ScopedArena arena;
+    if (!arena || s_snapshotInUse.exchange(true)) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
+        return;
+    }
+
+    HeapJsonStream* stream = arena->create<HeapJsonStream>(&s_snapshot);
+    if (!stream) {
+        s_snapshotInUse.store(false);
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
+    }
+
+    HeapProfiler::getSnapshot(s_snapshot);
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+        [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+            return stream->read(buffer, maxLen);
+        });
+    RequestArena *detached = arena.detach();
+    request->onDisconnect([detached]() {
+        RequestArena::release(detached);
+        s_snapshotInUse.store(false);
+    });
+    request->send(response);
+}
+#endif
+
+#if FUNCTION_PROFILE_ENABLED
+void AsyncSoilWebServer::handleFunctionProfile(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.profile_functions");
+
+    // ?reset=1 zera a tabela para medir uma janela específica
+    if (request->hasParam("reset")) {
+        Profiling::reset();
+        request->send(200, "application/json", "{\"reset\":true}");
+        return;
+    }
+
+    ScopedArena arena;
+    if (!arena) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
+        return;
     }
+
+    FunctionProfileJsonStream* stream = arena->create<FunctionProfileJsonStream>();
+    if (!stream) {
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
+    }
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+        [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+            return stream->read(buffer, maxLen);
+        });
+    attachArena(request, arena.detach());
+    request->send(response);
+}
+#endif
+
+#if PROFILE_ZONES_ENABLED
+void AsyncSoilWebServer::handleZoneProfile(AsyncWebServerRequest *request) {
+    // ?reset=1 zera os histogramas para medir uma janela específica
+    if (request->hasParam("reset")) {
+        ProfileZone::resetAll();
+        request->send(200, "application/json", "{\"reset\":true}");
+        return;
+    }
+
+    ScopedArena arena;
+    if (!arena) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
+        return;
+    }
+
+    ZoneProfileJsonStream* stream = arena->create<ZoneProfileJsonStream>();
+    if (!stream) {
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
+    }
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+        [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+            return stream->read(buffer, maxLen);
+        });
+    attachArena(request, arena.detach());
+    request->send(response);
+}
+#endif
+
+#if TRACE_ENABLED
+void AsyncSoilWebServer::handleTrace(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.trace");
+    ScopedArena arena;
+    if (!arena) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
+        return;
+    }
+
+    TraceDumpStream* stream = arena->create<TraceDumpStream>();
+    if (!stream) {
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
+    }
+
+    // A gravação fica suspensa durante o envio para que os anéis não sejam
+    // sobrescritos enquanto são lidos
+    TraceRecorder::setPaused(true);
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/octet-stream",
+        [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+            return stream->read(buffer, maxLen);
+        });
+    RequestArena *detached = arena.detach();
+    request->onDisconnect([detached]() {
+        TraceRecorder::setPaused(false);
+        RequestArena::release(detached);
+    });
+    request->send(response);
 }
+#endif
+
+#if SENSOR_TRACE_ENABLED
+void AsyncSoilWebServer::handleSensorTrace(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.sensor_trace");
+    // ?reset=<posição> descarta o que foi baixado, até a posição final do
+    // cabeçalho do dump; o que foi gravado depois continua no anel
+    if (request->hasParam("reset")) {
+        uint32_t position = strtoul(request->getParam("reset")->value().c_str(), nullptr, 10);
+        SensorTraceRecorder::discardUntil(position);
+
+        char body[48];
+        snprintf(body, sizeof(body), "{\"reset\":true,\"tail\":%u}", SensorTraceRecorder::getTail());
+        request->send(200, "application/json", body);
+        return;
+    }
 
-String AsyncSoilWebServer::prepareJsonMessage(bool dataOnly) {
-    // Aloca documento JSON na stack
-    StaticJsonDocument<JSON_BUFFER_SIZE> doc;
+    ScopedArena arena;
+    if (!arena) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
+        return;
+    }
 
-    // Dados dos sensores
-    JsonObject sensors = doc.createNestedObject("sensors");
-    const SensorData& data = m_sensorManager.getData();
+    SensorTraceDumpStream* stream = arena->create<SensorTraceDumpStream>();
+    if (!stream) {
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
+    }
+
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/octet-stream",
+        [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+            return stream->read(buffer, maxLen);
+        });
+    attachArena(request, arena.detach());
+    request->send(response);
+}
+#endif
+
+void AsyncSoilWebServer::attachArena(AsyncWebServerRequest *request, RequestArena *arena) {
+    // A requisição é destruída logo após o disconnect; depois disso a
+    // resposta não lê mais a memória da arena
+    request->onDisconnect([arena]() { RequestArena::release(arena); });
+}
 
-    sensors["ph"] = data.ph;
-    // Agora a temperatura já vem calibrada diretamente do sensor
-    // A calibração é aplicada em Hardware::readTemperature() através da função
-    // Hardware::getCalibrationTemperature()
-    sensors["temperature"] = data.temperature;
+void AsyncSoilWebServer::sendFromArena(AsyncWebServerRequest *request, RequestArena *arena,
+                                       const char *contentType, const char *body, size_t length) {
+    // A resposta "PROGMEM" apenas referencia o corpo, que no ESP32 pode estar
+    // na RAM: nada é copiado para uma String
+    AsyncWebServerResponse *response = request->beginResponse_P(
+        200, contentType, reinterpret_cast<const uint8_t *>(body), length);
 
-    sensors["humidity"] = data.humidityPercent;
-    sensors["phosphorus"] = data.phosphorusPresent;
-    sensors["potassium"] = data.potassiumPresent;
-    sensors["timestamp"] = data.timestamp;
+    if (!response) {
+        RequestArena::release(arena);
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
+    }
 
-    // Adiciona estatísticas do sistema se solicitado
-    if (!dataOnly) {
-        // Obtém estatísticas atualizadas
-        const SystemStats& stats = SystemMonitor::getInstance().getStats();
+    attachArena(request, arena);
+    request->send(response);
+}
 
-        JsonObject statsObj = doc.createNestedObject("stats");
-        statsObj["freeHeap"] = stats.freeHeap;
-        statsObj["fragmentation"] = stats.heapFragmentation;
-        statsObj["uptime"] = stats.uptime;
-        statsObj["clients"] = m_clientCount;
+void AsyncSoilWebServer::sendJson(AsyncWebServerRequest *request, const JsonDocument &doc) {
+    ScopedArena arena;
+    if (!arena) {
+        request->send(503, "application/json", "{\"error\":\"Servidor ocupado\"}");
+        return;
+    }
 
-        // Status WiFi
-        char wifiStatus[50];
-        WiFiManager::getInstance().getStatusString(wifiStatus, sizeof(wifiStatus));
-        statsObj["wifi"] = wifiStatus;
+    size_t capacity = measureJson(doc) + 1;
+    char *body = static_cast<char *>(arena->allocate(capacity, 1));
+    if (!body) {
+        request->send(500, "application/json", "{\"error\":\"Memória insuficiente\"}");
+        return;
     }
 
-    // Serializa para string
-    String output;
-    serializeJson(doc, output);
+    size_t length = serializeJson(doc, body, capacity);
+    sendFromArena(request, arena.detach(), "application/json", body, length);
+}
+
+void AsyncSoilWebServer::handleNotFound(AsyncWebServerRequest *request) {
+    PROFILE_ZONE("http.not_found");
+
+    // Envia resposta 404
+    request->send(404, "text/plain", "Página não encontrada");
 
-    return output;
+    if (DEBUG_MODE) {
+        {
+            IPAddress ip = request->client()->remoteIP();
+            char ipStr[16];
+            snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
+            DBG_DEBUG(MODULE_NAME, "404 - %s (IP: %s)",
+                request->url().c_str(), ipStr);
+        }
+    }
 }
 
 bool AsyncSoilWebServer::update(bool forceUpdate) {
@@ -632,15 +1642,10 @@ bool AsyncSoilWebServer::update(bool forceUpdate) {
 
     // Atualiza apenas a cada 100ms para limitar carga de rede (10Hz)
     if (forceUpdate || (currentTime - m_lastBroadcastTime >= 100)) {
-        // Limpa clientes inativos a cada 5 segundos
-        if (currentTime % 5000 < 100) {
-            cleanClients();
-        }
-
         // Apenas solicita atualização se houver clientes conectados
         if (m_clientCount > 0) {
-            // Atualiza as estatísticas do sistema
-            SystemMonitor::getInstance().update();
+            // O broadcast inteiro deve rodar sem alocar no heap
+            ALLOC_GUARD_SCOPE();
 
             // Solicita que o SensorManager atualize seus dados
             m_sensorManager.update(forceUpdate);
@@ -673,14 +1678,22 @@ uint16_t AsyncSoilWebServer::getClientCount() const {
     return m_clientCount;
 }
 
-bool AsyncSoilWebServer::broadcastMessage(const String &message) {
-    // Envia a mensagem para todos os clientes
-    m_websocket.textAll(message);
+bool AsyncSoilWebServer::broadcastMessage(StringView message) {
+    {
+        // O AsyncWebSocket copia a mensagem para um buffer compartilhado
+        // entre os clientes: única alocação permitida por broadcast
+        ALLOC_GUARD_EXEMPT();
+        m_websocket.textAll(message.data(), message.length());
+    }
 
     // Retorna true se há clientes para receber
     return (m_clientCount > 0);
 }
 
+void AsyncSoilWebServer::cleanupJob(void *context) {
+    static_cast<AsyncSoilWebServer *>(context)->cleanClients();
+}
+
 uint16_t AsyncSoilWebServer::cleanClients() {
     // Limpa clientes inativos
     uint16_t initialCount = m_clientCount;
@@ -701,17 +1714,17 @@ void AsyncSoilWebServer::handleWebSocketEvent(AsyncWebSocket *server,
                                 AsyncWebSocketClient *client,
                                 AwsEventType type, void *arg, uint8_t *data,
                                 size_t len) {
+    TRACE_SCOPE("ws.event");
+
     switch (type) {
         case WS_EVT_CONNECT:
             // Novo cliente conectado
             m_clientCount++;
+            TRACE_COUNTER("ws.clients", m_clientCount);
             if (DEBUG_MODE) {
                 DBG_DEBUG(MODULE_NAME, "WebSocket: Cliente #%u conectado", client->id());
             }
 
-            // Atualiza estatísticas do sistema antes de enviar
-            SystemMonitor::getInstance().update();
-
             // Força uma atualização dos sensores para ter valores mais atuais
             m_sensorManager.update(true);
 
@@ -725,6 +1738,7 @@ void AsyncSoilWebServer::handleWebSocketEvent(AsyncWebSocket *server,
         case WS_EVT_DISCONNECT:
             // Cliente desconectado
             m_clientCount--;
+            TRACE_COUNTER("ws.clients", m_clientCount);
             if (DEBUG_MODE) {
                 DBG_DEBUG(MODULE_NAME, "WebSocket: Cliente #%u desconectado", client->id());
             }
@@ -757,23 +1771,26 @@ void AsyncSoilWebServer::handleWebSocketEvent(AsyncWebSocket *server,
 
 void AsyncSoilWebServer::processWebSocketCommand(AsyncWebSocketClient *client,
                                                uint8_t *data, size_t len) {
+    // Memória de trabalho da mensagem, devolvida ao fim do escopo
+    ScopedArena arena;
+    if (!arena) {
+        LOG_ERROR(MODULE_NAME, "Sem arena livre para comando WebSocket");
+        return;
+    }
+
     // Converte os dados recebidos em string
-    char* commandStr = new char[len + 1];
+    char* commandStr = arena->copyString(data, len);
     if (!commandStr) {
-        LOG_ERROR(MODULE_NAME, "Falha ao alocar memória para comando WebSocket");
+        LOG_ERROR(MODULE_NAME, "Comando WebSocket excede a arena (%u bytes)", len);
         return;
     }
 
-    memcpy(commandStr, data, len);
-    commandStr[len] = '\0';
-
     // Analisa o comando JSON
     StaticJsonDocument<256> doc;
     DeserializationError error = deserializeJson(doc, commandStr);
 
     if (error) {
         LOG_WARN(MODULE_NAME, "Comando JSON inválido recebido: %s", error.c_str());
-        delete[] commandStr;
         return;
     }
 
@@ -799,9 +1816,12 @@ void AsyncSoilWebServer::processWebSocketCommand(AsyncWebSocketClient *client,
             response["success"] = success;
             response["action"] = "toggle";
 
-            String responseStr;
-            serializeJson(response, responseStr);
-            client->text(responseStr);
+            size_t capacity = measureJson(response) + 1;
+            char* responseStr = static_cast<char*>(arena->allocate(capacity, 1));
+            if (responseStr) {
+                size_t length = serializeJson(response, responseStr, capacity);
+                client->text(responseStr, length);
+            }
 
             // Força atualização imediata dos dados para todos os clientes
             if (success) {
@@ -814,8 +1834,6 @@ void AsyncSoilWebServer::processWebSocketCommand(AsyncWebSocketClient *client,
             LOG_WARN(MODULE_NAME, "Ação desconhecida recebida: %s", action);
         }
     }
-
-    delete[] commandStr;
 }
 
 void AsyncSoilWebServer::onWebSocketEvent(AsyncWebSocket *server,
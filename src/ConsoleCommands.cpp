@@ -0,0 +1,102 @@
+/**
+ * @file ConsoleCommands.cpp
+ * @brief Implementação do leitor de comandos da serial.
+ */
+
+#include "ConsoleCommands.h"
+#include "ConsoleWriter.h"
+#include "LogSystem.h"
+
+#define MODULE_NAME "Console"
+
+struct Command {
+    const char* name;
+    const char* help;
+    ConsoleCommands::Handler handler;
+};
+
+static Command s_commands[CONSOLE_MAX_COMMANDS];
+static uint8_t s_commandCount = 0;
+
+// Linha em recepção; só a tarefa que chama poll() a usa
+static char s_line[CONSOLE_COMMAND_MAX_LENGTH + 1];
+static uint8_t s_lineLength = 0;
+static bool s_lineOverflow = false;
+
+bool ConsoleCommands::registerCommand(const char* name, const char* help, Handler handler) {
+    if (s_commandCount == 0) {
+        s_commands[s_commandCount++] = {"help", "Lista os comandos", printHelp};
+    }
+
+    if (s_commandCount >= CONSOLE_MAX_COMMANDS) {
+        LOG_WARN(MODULE_NAME, "Tabela de comandos cheia - '%s' ignorado", name);
+        return false;
+    }
+
+    s_commands[s_commandCount++] = {name, help, handler};
+    return true;
+}
+
+void ConsoleCommands::poll() {
+    while (Serial.available() > 0) {
+        char c = static_cast<char>(Serial.read());
+
+        if (c == '\r' || c == '\n') {
+            if (s_lineOverflow) {
+                printf("Comando longo demais (máximo %u caracteres)\n", CONSOLE_COMMAND_MAX_LENGTH);
+            } else if (s_lineLength > 0) {
+                s_line[s_lineLength] = '\0';
+                execute(s_line);
+            }
+            s_lineLength = 0;
+            s_lineOverflow = false;
+        } else if (s_lineLength < CONSOLE_COMMAND_MAX_LENGTH) {
+            s_line[s_lineLength++] = c;
+        } else {
+            s_lineOverflow = true;
+        }
+    }
+}
+
+void ConsoleCommands::execute(char* line) {
+    // Separa o nome dos argumentos
+    char* args = line;
+    while (*args && *args != ' ') {
+        args++;
+    }
+    if (*args) {
+        *args++ = '\0';
+        while (*args == ' ') {
+            args++;
+        }
+    }
+
+    for (uint8_t i = 0; i < s_commandCount; i++) {
+        if (strcmp(s_commands[i].name, line) == 0) {
+            s_commands[i].handler(args);
+            return;
+        }
+    }
+
+    printf("Comando desconhecido: %s (digite help)\n", line);
+}
+
+void ConsoleCommands::printHelp(const char*) {
+    for (uint8_t i = 0; i < s_commandCount; i++) {
+        printf("  %-12s %s\n", s_commands[i].name, s_commands[i].help);
+    }
+}
+
+void ConsoleCommands::printf(const char* fmt, ...) {
+    char buffer[160];
+
+    va_list args;
+    va_start(args, fmt);
+    int length = vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+
+    if (length > 0) {
+        size_t size = static_cast<size_t>(length) < sizeof(buffer) ? length : sizeof(buffer) - 1;
+        ConsoleWriter::write(buffer, size, CONSOLE_CRITICAL_WAIT_MS);
+    }
+}
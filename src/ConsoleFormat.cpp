@@ -5,52 +5,39 @@
 
 #include "ConsoleFormat.h"
 #include "StringUtils.h"
+#include "ConsoleWriter.h"
 #include <freertos/FreeRTOS.h>
-#include <freertos/semphr.h>
 #include <stdarg.h>
 #include <string.h>
 #include <algorithm>
 
+// Separador de seções do console
+#define SECTION_RULE "----------------------------------------"
+
 // Inicialização de membros estáticos
 ConsoleManager* ConsoleManager::s_instance = nullptr;
-std::vector<String> ConsoleFilter::s_blockedPatterns;
+PatternMatcher<CONSOLE_FILTER_MAX_STATES> ConsoleFilter::s_matcher;
 
 // Implementação da classe ConsoleFilter
-void ConsoleFilter::addBlockedPattern(const char* pattern) {
-    if (pattern && strlen(pattern) > 0) {
-        // Verifica se o padrão já existe na lista
-        for (const auto& existingPattern : s_blockedPatterns) {
-            if (existingPattern == pattern) {
-                return; // Padrão já existe, não adiciona duplicado
-            }
-        }
-
-        // Adiciona o novo padrão
-        s_blockedPatterns.push_back(String(pattern));
-    }
+bool ConsoleFilter::addBlockedPattern(const char* pattern) {
+    // Padrões duplicados são ignorados pelo autômato
+    return s_matcher.addPattern(pattern);
 }
 
 bool ConsoleFilter::shouldFilter(const char* message) {
-    if (!message || strlen(message) == 0) {
-        return false; // Mensagem vazia, não filtra
-    }
-
-    // Converte para String para facilitar a comparação
-    String msgStr(message);
-
-    // Verifica cada padrão bloqueado
-    for (const auto& pattern : s_blockedPatterns) {
-        if (msgStr.indexOf(pattern) >= 0) {
-            return true; // Mensagem contém padrão bloqueado
-        }
-    }
+    // Passada única sobre a mensagem, independente do número de padrões
+    return s_matcher.matches(message);
+}
 
-    return false; // Nenhum padrão encontrado, não filtra
+size_t ConsoleFilter::getPatternCount() {
+    return s_matcher.patternCount();
 }
 
 // Implementação do ConsoleManager
 ConsoleManager::ConsoleManager()
-    : m_lineState(LineState::NEW_LINE),
+    : m_stateMutex("console.state"),
+      m_outputMutex("console.output"),
+      m_lineState(LineState::NEW_LINE),
       m_lastOutputTime(0),
       m_activeReservation(0),
       m_inReservedMode(false),
@@ -58,18 +45,19 @@ ConsoleManager::ConsoleManager()
       m_historyIndex(0) {
 
     // Cria os semáforos para controle de acesso
-    m_stateMutex = xSemaphoreCreateMutex();
-    m_outputMutex = xSemaphoreCreateMutex();
+    m_stateMutex.create();
+    m_outputMutex.create();
 
     // Inicializa os buffers
     memset(m_lineBuffer, 0, sizeof(m_lineBuffer));
     memset(m_statusLineBuffer, 0, sizeof(m_statusLineBuffer));
+    memset(m_outputBuffer, 0, sizeof(m_outputBuffer));
 
     // Inicializa o histórico de mensagens
     memset(m_messageHistory, 0, sizeof(m_messageHistory));
 
     // Define padrões padrão para bloquear
-    if (ConsoleFilter::s_blockedPatterns.empty()) {
+    if (ConsoleFilter::getPatternCount() == 0) {
         ConsoleFilter::addBlockedPattern("Watchdog resetado");
         ConsoleFilter::addBlockedPattern("Task watchdog got triggered");
         ConsoleFilter::addBlockedPattern("WATCHDOG-TIMER");
@@ -82,15 +70,8 @@ ConsoleManager::ConsoleManager()
 
 ConsoleManager::~ConsoleManager() {
     // Libera os recursos
-    if (m_stateMutex) {
-        vSemaphoreDelete(m_stateMutex);
-        m_stateMutex = nullptr;
-    }
-
-    if (m_outputMutex) {
-        vSemaphoreDelete(m_outputMutex);
-        m_outputMutex = nullptr;
-    }
+    m_stateMutex.destroy();
+    m_outputMutex.destroy();
 }
 
 ConsoleManager& ConsoleManager::getInstance() {
@@ -100,19 +81,33 @@ ConsoleManager& ConsoleManager::getInstance() {
     return *s_instance;
 }
 
-bool ConsoleManager::safeTakeMutex(SemaphoreHandle_t mutex, uint32_t timeoutMs) {
-    if (!mutex) {
+bool ConsoleManager::safeTakeMutex(InstrumentedMutex& mutex, uint32_t timeoutMs) {
+    if (!mutex.isCreated()) {
         return false;
     }
 
     // Tenta adquirir o mutex com timeout
-    return xSemaphoreTake(mutex, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+    return mutex.take(pdMS_TO_TICKS(timeoutMs));
+}
+
+void ConsoleManager::safeGiveMutex(InstrumentedMutex& mutex) {
+    mutex.give();
 }
 
-void ConsoleManager::safeGiveMutex(SemaphoreHandle_t mutex) {
-    if (mutex) {
-        xSemaphoreGive(mutex);
+bool ConsoleManager::emit(int length, MessagePriority priority) {
+    if (length <= 0) {
+        return false;
+    }
+
+    // snprintf retorna o tamanho sem truncamento
+    size_t size = static_cast<size_t>(length);
+    if (size >= sizeof(m_outputBuffer)) {
+        size = sizeof(m_outputBuffer) - 1;
     }
+
+    // Apenas mensagens críticas podem esperar por espaço no anel
+    uint32_t timeoutMs = (priority == MessagePriority::MSG_CRITICAL) ? CONSOLE_CRITICAL_WAIT_MS : 0;
+    return ConsoleWriter::write(m_outputBuffer, size, timeoutMs);
 }
 
 void ConsoleManager::addToHistory(const char* message, MessagePriority priority, bool isStatusLine) {
@@ -189,21 +184,17 @@ bool ConsoleManager::detectUnauthorizedOutput() {
 void ConsoleManager::recoverState() {
     // Tenta restaurar o estado do console após uma interferência
     if (safeTakeMutex(m_stateMutex, 200) && safeTakeMutex(m_outputMutex, 200)) {
-        // Força uma nova linha para garantir estado limpo
-        Serial.println();
-
-        // Reinicia o estado
-        m_lineState = LineState::NEW_LINE;
-
-        // Se estávamos em modo reservado, restaura a linha de status
-        if (m_inReservedMode && m_statusLineBuffer[0] != '\0') {
-            Serial.print('\r');
-            Serial.print(m_statusLineBuffer);
-            m_lineState = LineState::RESERVED_LINE;
+        // Força uma nova linha para garantir estado limpo e, se estávamos
+        // em modo reservado, restaura a linha de status
+        bool restoreStatus = m_inReservedMode && m_statusLineBuffer[0] != '\0';
+        int length = snprintf(m_outputBuffer, sizeof(m_outputBuffer), "\r\n%s%s",
+                              restoreStatus ? "\r" : "", restoreStatus ? m_statusLineBuffer : "");
+
+        if (emit(length, MessagePriority::MSG_HIGH)) {
+            m_lineState = restoreStatus ? LineState::RESERVED_LINE : LineState::NEW_LINE;
+            m_lastOutputTime = millis();
         }
 
-        m_lastOutputTime = millis();
-
         safeGiveMutex(m_outputMutex);
         safeGiveMutex(m_stateMutex);
     }
@@ -237,17 +228,17 @@ void ConsoleManager::printFormatted(const char* fmt, MessagePriority priority, .
     addToHistory(m_lineBuffer, priority, false);
 
     // Avalia se precisamos inserir uma quebra de linha para organização
-    if (shouldInsertBlankLine()) {
-        Serial.println(); // Força nova linha
-        m_lineState = LineState::NEW_LINE;
-    }
+    bool blankLine = shouldInsertBlankLine();
 
-    // Imprime o texto formatado
-    Serial.print(m_lineBuffer);
+    // Imprime o texto formatado em uma única escrita
+    int length = snprintf(m_outputBuffer, sizeof(m_outputBuffer), "%s%s",
+                          blankLine ? "\r\n" : "", m_lineBuffer);
 
-    // Atualiza estado
-    m_lastOutputTime = millis();
-    m_lineState = LineState::MID_LINE;
+    // Atualiza estado apenas se a saída foi enfileirada
+    if (emit(length, priority)) {
+        m_lastOutputTime = millis();
+        m_lineState = LineState::MID_LINE;
+    }
 
     safeGiveMutex(m_outputMutex);
     safeGiveMutex(m_stateMutex);
@@ -281,16 +272,17 @@ void ConsoleManager::println(const char* fmt, MessagePriority priority, ...) {
     addToHistory(m_lineBuffer, priority, false);
 
     // Se estamos no meio de uma linha, adiciona quebra primeiro
-    if (m_lineState != LineState::NEW_LINE) {
-        Serial.println();
-    }
+    bool breakLine = m_lineState != LineState::NEW_LINE;
 
     // Imprime a linha completa
-    Serial.println(m_lineBuffer);
+    int length = snprintf(m_outputBuffer, sizeof(m_outputBuffer), "%s%s\r\n",
+                          breakLine ? "\r\n" : "", m_lineBuffer);
 
-    // Atualiza estado
-    m_lastOutputTime = millis();
-    m_lineState = LineState::NEW_LINE;
+    // Atualiza estado apenas se a saída foi enfileirada
+    if (emit(length, priority)) {
+        m_lastOutputTime = millis();
+        m_lineState = LineState::NEW_LINE;
+    }
 
     safeGiveMutex(m_outputMutex);
     safeGiveMutex(m_stateMutex);
@@ -300,32 +292,20 @@ void ConsoleManager::resetOutput() {
     // Verifica se os mutex são válidos
     if (!safeTakeMutex(m_stateMutex, 300) || !safeTakeMutex(m_outputMutex, 300)) {
         // Se adquiriu o primeiro mutex mas não o segundo, libera o primeiro
-        if (m_stateMutex) {
-            safeGiveMutex(m_stateMutex);
-        }
+        safeGiveMutex(m_stateMutex);
         return; // Timeout - não conseguiu adquirir os mutexes
     }
 
-    // Limpa o buffer serial
-    Serial.flush();
-
-    // Garante que não há mensagens pendentes interrompendo nosso fluxo
-    delay(10);
-
-    // Adiciona várias quebras de linha para separação visual e limpeza
-    Serial.println();
-    Serial.println();
-    Serial.println();
-
-    // Limpa qualquer caractere parcial ou resíduo de buffer
-    for (int i = 0; i < 5; i++) {
-        Serial.print(' ');
+    // Adiciona várias quebras de linha para separação visual e limpa
+    // qualquer caractere parcial. A saída anterior já está no anel de
+    // transmissão, em ordem, então não é preciso esperar a serial.
+    int length = snprintf(m_outputBuffer, sizeof(m_outputBuffer), "\r\n\r\n\r\n     \r\n");
+    if (emit(length, MessagePriority::MSG_HIGH)) {
+        m_lastOutputTime = millis();
+        m_lineState = LineState::NEW_LINE;
     }
-    Serial.println();
 
     // Reinicia estado
-    m_lastOutputTime = millis();
-    m_lineState = LineState::NEW_LINE;
     m_inReservedMode = false;
     m_activeReservation = 0;
 
@@ -355,22 +335,18 @@ void ConsoleManager::beginSection(const char* title, MessagePriority priority) {
         return; // Não conseguiu o mutex de saída
     }
 
-    // Se não estamos no início de uma linha, adiciona quebra primeiro
-    if (m_lineState != LineState::NEW_LINE) {
-        Serial.println();
-    }
-
-    // Adiciona linha em branco para separação
-    Serial.println();
+    // Se não estamos no início de uma linha, adiciona quebra primeiro,
+    // seguida de linha em branco para separação e do cabeçalho da seção
+    bool breakLine = m_lineState != LineState::NEW_LINE;
+    int length = snprintf(m_outputBuffer, sizeof(m_outputBuffer),
+                          "%s\r\n" SECTION_RULE "\r\n%s\r\n" SECTION_RULE "\r\n",
+                          breakLine ? "\r\n" : "", title);
 
-    // Imprime cabeçalho da seção
-    Serial.println("----------------------------------------");
-    Serial.println(title);
-    Serial.println("----------------------------------------");
-
-    // Atualiza estado
-    m_lastOutputTime = millis();
-    m_lineState = LineState::NEW_LINE;
+    // Atualiza estado apenas se a saída foi enfileirada
+    if (emit(length, priority)) {
+        m_lastOutputTime = millis();
+        m_lineState = LineState::NEW_LINE;
+    }
 
     // Adiciona ao histórico
     char sectionHeader[64];
@@ -400,16 +376,17 @@ void ConsoleManager::endSection(MessagePriority priority) {
     }
 
     // Se não estamos no início de uma linha, adiciona quebra primeiro
-    if (m_lineState != LineState::NEW_LINE) {
-        Serial.println();
-    }
+    bool breakLine = m_lineState != LineState::NEW_LINE;
 
     // Imprime rodapé da seção
-    Serial.println("----------------------------------------");
+    int length = snprintf(m_outputBuffer, sizeof(m_outputBuffer), "%s" SECTION_RULE "\r\n",
+                          breakLine ? "\r\n" : "");
 
-    // Atualiza estado
-    m_lastOutputTime = millis();
-    m_lineState = LineState::NEW_LINE;
+    // Atualiza estado apenas se a saída foi enfileirada
+    if (emit(length, priority)) {
+        m_lastOutputTime = millis();
+        m_lineState = LineState::NEW_LINE;
+    }
 
     // Adiciona ao histórico
     addToHistory("END SECTION", priority, false);
@@ -444,15 +421,16 @@ void ConsoleManager::updateLine(const char* fmt, ...) {
             }
 
             // Retorno de carro para início da linha e imprime
-            Serial.print('\r');
-            Serial.print(m_statusLineBuffer);
+            int length = snprintf(m_outputBuffer, sizeof(m_outputBuffer), "\r%s", m_statusLineBuffer);
 
             // Adiciona ao histórico
             addToHistory(buffer, MessagePriority::MSG_HIGH, true);
 
-            // Atualiza estado
-            m_lastOutputTime = millis();
-            m_lineState = LineState::RESERVED_LINE;
+            // Atualiza estado apenas se a saída foi enfileirada
+            if (emit(length, MessagePriority::MSG_HIGH)) {
+                m_lastOutputTime = millis();
+                m_lineState = LineState::RESERVED_LINE;
+            }
 
             safeGiveMutex(m_outputMutex);
             safeGiveMutex(m_stateMutex);
@@ -494,8 +472,9 @@ uint32_t ConsoleManager::reserveLine() {
 
     // Se necessário, adiciona quebra de linha para começar linha limpa
     if (safeTakeMutex(m_outputMutex, 200)) {
-        if (m_lineState != LineState::NEW_LINE) {
-            Serial.println();
+        if (m_lineState != LineState::NEW_LINE &&
+            emit(snprintf(m_outputBuffer, sizeof(m_outputBuffer), "\r\n"), MessagePriority::MSG_HIGH)) {
+            m_lineState = LineState::NEW_LINE;
         }
 
         safeGiveMutex(m_outputMutex);
@@ -527,9 +506,12 @@ bool ConsoleManager::releaseLine(uint32_t token) {
     m_activeReservation = 0;
 
     // Adiciona quebra de linha após linha reservada
+    // Se a quebra for descartada, o estado continua indicando linha
+    // ocupada e a próxima mensagem começa com a quebra pendente
     if (safeTakeMutex(m_outputMutex, 200)) {
-        Serial.println();
-        m_lineState = LineState::NEW_LINE;
+        if (emit(snprintf(m_outputBuffer, sizeof(m_outputBuffer), "\r\n"), MessagePriority::MSG_HIGH)) {
+            m_lineState = LineState::NEW_LINE;
+        }
         safeGiveMutex(m_outputMutex);
     }
 
@@ -582,21 +564,20 @@ bool ConsoleManager::updateLineWithToken(const char* fmt, uint32_t token, ...) {
     bool interrupted = (m_lineState != LineState::RESERVED_LINE && m_lineState != LineState::NEW_LINE) ||
                        (now - m_lastOutputTime > 300);
 
-    if (interrupted) {
-        // Força quebra de linha se houve interrupção
-        Serial.println();
-    }
-
-    // Retorno de carro e imprime a linha atualizada
-    Serial.print('\r');
-    Serial.print(m_statusLineBuffer);
+    // Força quebra de linha se houve interrupção, depois retorno de
+    // carro e a linha atualizada, tudo em uma única escrita
+    int length = snprintf(m_outputBuffer, sizeof(m_outputBuffer), "%s\r%s",
+                          interrupted ? "\r\n" : "", m_statusLineBuffer);
 
     // Adiciona ao histórico
     addToHistory(m_lineBuffer, MessagePriority::MSG_HIGH, true);
 
-    // Atualiza estado
-    m_lastOutputTime = now;
-    m_lineState = LineState::RESERVED_LINE;
+    // Se a atualização for descartada, o estado não muda e a próxima
+    // atualização reavalia a interrupção e reescreve a linha inteira
+    if (emit(length, MessagePriority::MSG_HIGH)) {
+        m_lastOutputTime = now;
+        m_lineState = LineState::RESERVED_LINE;
+    }
 
     safeGiveMutex(m_outputMutex);
     safeGiveMutex(m_stateMutex);
@@ -0,0 +1,90 @@
+/**
+ * @file ConsoleWriter.cpp
+ * @brief Implementação da escrita não bloqueante no console serial.
+ */
+
+#include "ConsoleWriter.h"
+#include "InstrumentedMutex.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Serializa a verificação de espaço e a cópia para o anel
+static InstrumentedMutex s_writeMutex("console.write");
+
+static ConsoleWriter::Stats s_stats = {};
+static portMUX_TYPE s_statsLock = portMUX_INITIALIZER_UNLOCKED;
+
+void ConsoleWriter::begin(unsigned long baudRate) {
+    s_writeMutex.create();
+
+    // Com anel de transmissão, o driver copia os bytes e retorna; a
+    // interrupção de FIFO vazia os envia. Sem ele, cada escrita espera
+    // a FIFO de hardware de 128 bytes esvaziar na velocidade da serial.
+    Serial.setTxBufferSize(CONSOLE_TX_BUFFER_SIZE);
+    Serial.begin(baudRate);
+}
+
+bool ConsoleWriter::write(const char* data, size_t length, uint32_t timeoutMs) {
+    if (!data || length == 0) {
+        return true;
+    }
+
+    uint32_t start = micros();
+    bool queued = false;
+
+    if (s_writeMutex.take(pdMS_TO_TICKS(CONSOLE_WRITE_LOCK_MS))) {
+        while (true) {
+            // Só escreve se a mensagem inteira couber, para não bloquear
+            // dentro do driver esperando o anel esvaziar
+            if (static_cast<size_t>(Serial.availableForWrite()) >= length) {
+                Serial.write(reinterpret_cast<const uint8_t*>(data), length);
+                queued = true;
+                break;
+            }
+
+            if (micros() - start >= timeoutMs * 1000UL) {
+                break;
+            }
+            vTaskDelay(1);
+        }
+
+        s_writeMutex.give();
+    }
+
+    uint32_t elapsed = micros() - start;
+
+    portENTER_CRITICAL(&s_statsLock);
+    if (queued) {
+        s_stats.bytesQueued += length;
+    } else {
+        s_stats.bytesDropped += length;
+        s_stats.messagesDropped++;
+    }
+    s_stats.blockedMicros += elapsed;
+    if (elapsed > s_stats.maxBlockedMicros) {
+        s_stats.maxBlockedMicros = elapsed;
+    }
+    portEXIT_CRITICAL(&s_statsLock);
+
+    return queued;
+}
+
+bool ConsoleWriter::write(const char* text, uint32_t timeoutMs) {
+    return text ? write(text, strlen(text), timeoutMs) : true;
+}
+
+size_t ConsoleWriter::getFreeSpace() {
+    int available = Serial.availableForWrite();
+    return available > 0 ? static_cast<size_t>(available) : 0;
+}
+
+void ConsoleWriter::flush() {
+    Serial.flush();
+}
+
+ConsoleWriter::Stats ConsoleWriter::getStats() {
+    portENTER_CRITICAL(&s_statsLock);
+    Stats copy = s_stats;
+    portEXIT_CRITICAL(&s_statsLock);
+    return copy;
+}
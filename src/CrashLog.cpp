@@ -0,0 +1,220 @@
+/**
+ * @file CrashLog.cpp
+ * @brief Implementação do anel de logs em RTC RAM.
+ */
+
+#include "CrashLog.h"
+#include "LogSystem.h"
+#include <esp_system.h>
+#include <esp32/rom/crc.h>
+#include <freertos/FreeRTOS.h>
+
+// Identifica um cabeçalho inicializado por este firmware
+#define CRASH_LOG_MAGIC           0x43524C47  // "CRLG"
+
+// Bytes fixos de cada registro: tamanho, nível, timestamp, tamanho do módulo
+#define CRASH_LOG_RECORD_OVERHEAD 7
+
+/**
+ * Cabeçalho do anel. Os contadores head/tail são absolutos; a posição no
+ * anel é obtida pelo resto da divisão por CRASH_LOG_RING_SIZE.
+ */
+struct CrashLogHeader {
+    uint32_t magic;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t crc;
+};
+
+// Memória preservada entre resets (não inicializada pelo bootloader)
+RTC_NOINIT_ATTR static CrashLogHeader s_header;
+RTC_NOINIT_ATTR static uint8_t s_ring[CRASH_LOG_RING_SIZE];
+
+// Cópia linear dos registros do boot anterior
+static uint8_t s_previous[CRASH_LOG_RING_SIZE];
+static uint16_t s_previousCount = 0;
+
+// Início de cada registro anterior, para acessá-los por índice do mais
+// recente ao mais antigo; montado uma vez em init()
+static uint16_t s_previousOffsets[CRASH_LOG_RING_SIZE / CRASH_LOG_RECORD_OVERHEAD];
+static bool s_previousValid = false;
+
+static bool s_ready = false;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static inline uint32_t headerCrc(const CrashLogHeader& header) {
+    return crc32_le(0, reinterpret_cast<const uint8_t*>(&header), offsetof(CrashLogHeader, crc));
+}
+
+static inline void sealHeader() {
+    s_header.crc = headerCrc(s_header);
+}
+
+static inline uint8_t ringByte(uint32_t pos) {
+    return s_ring[pos % CRASH_LOG_RING_SIZE];
+}
+
+static inline void ringCopyIn(uint32_t pos, const uint8_t* data, size_t len) {
+    size_t offset = pos % CRASH_LOG_RING_SIZE;
+    size_t first = CRASH_LOG_RING_SIZE - offset;
+    if (first >= len) {
+        memcpy(&s_ring[offset], data, len);
+    } else {
+        memcpy(&s_ring[offset], data, first);
+        memcpy(s_ring, data + first, len - first);
+    }
+}
+
+// Valida um registro copiado para área linear
+static bool recordValid(const uint8_t* record, size_t available) {
+    if (available < CRASH_LOG_RECORD_OVERHEAD) return false;
+
+    uint8_t len = record[0];
+    uint8_t level = record[1];
+    uint8_t moduleLen = record[6];
+
+    return len >= CRASH_LOG_RECORD_OVERHEAD && len <= available &&
+           level <= static_cast<uint8_t>(LogLevel::FATAL) &&
+           moduleLen < LOG_MODULE_NAME_MAX_SIZE &&
+           CRASH_LOG_RECORD_OVERHEAD + moduleLen <= len;
+}
+
+void CrashLog::init() {
+    bool headerValid = s_header.magic == CRASH_LOG_MAGIC &&
+                       s_header.crc == headerCrc(s_header) &&
+                       s_header.head - s_header.tail <= CRASH_LOG_RING_SIZE;
+
+    if (headerValid) {
+        // Lineariza os registros do boot anterior, parando no primeiro inválido
+        uint32_t used = s_header.head - s_header.tail;
+        for (uint32_t i = 0; i < used; i++) {
+            s_previous[i] = ringByte(s_header.tail + i);
+        }
+
+        size_t offset = 0;
+        while (offset < used && recordValid(&s_previous[offset], used - offset)) {
+            s_previousOffsets[s_previousCount++] = offset;
+            offset += s_previous[offset];
+        }
+
+        s_previousValid = true;
+    } else {
+        // Power-on ou memória corrompida: começa do zero
+        s_header.magic = CRASH_LOG_MAGIC;
+    }
+
+    s_header.head = 0;
+    s_header.tail = 0;
+    sealHeader();
+
+    s_ready = true;
+}
+
+void CrashLog::append(LogLevel level, const char* module, const char* message) {
+    if (!s_ready || !module || !message) {
+        return;
+    }
+
+    size_t moduleLen = strnlen(module, LOG_MODULE_NAME_MAX_SIZE - 1);
+    size_t messageLen = strnlen(message, CRASH_LOG_MAX_MESSAGE);
+    size_t recordLen = CRASH_LOG_RECORD_OVERHEAD + moduleLen + messageLen;
+
+    // Monta o registro fora da seção crítica
+    uint8_t record[CRASH_LOG_RECORD_OVERHEAD + LOG_MODULE_NAME_MAX_SIZE + CRASH_LOG_MAX_MESSAGE];
+    uint32_t timestamp = millis();
+    record[0] = static_cast<uint8_t>(recordLen);
+    record[1] = static_cast<uint8_t>(level);
+    memcpy(&record[2], &timestamp, sizeof(timestamp));
+    record[6] = static_cast<uint8_t>(moduleLen);
+    memcpy(&record[CRASH_LOG_RECORD_OVERHEAD], module, moduleLen);
+    memcpy(&record[CRASH_LOG_RECORD_OVERHEAD + moduleLen], message, messageLen);
+
+    portENTER_CRITICAL(&s_lock);
+
+    // Descarta os registros mais antigos até caber. O cabeçalho é selado
+    // antes de sobrescrever os dados, para que um reset no meio da escrita
+    // nunca aponte para um registro parcialmente sobrescrito.
+    uint32_t tail = s_header.tail;
+    while (CRASH_LOG_RING_SIZE - (s_header.head - tail) < recordLen) {
+        uint8_t oldLen = ringByte(tail);
+        if (oldLen < CRASH_LOG_RECORD_OVERHEAD) {
+            tail = s_header.head;
+            break;
+        }
+        tail += oldLen;
+    }
+    if (tail != s_header.tail) {
+        s_header.tail = tail;
+        sealHeader();
+    }
+
+    ringCopyIn(s_header.head, record, recordLen);
+    s_header.head += recordLen;
+    sealHeader();
+
+    portEXIT_CRITICAL(&s_lock);
+}
+
+// snprintf retorna o tamanho que o texto teria; limita ao que foi escrito
+static size_t writtenLength(int written, size_t maxSize) {
+    if (written <= 0 || maxSize == 0) {
+        return 0;
+    }
+    return static_cast<size_t>(written) < maxSize ? written : maxSize - 1;
+}
+
+size_t CrashLog::formatPreviousHeader(char* buffer, size_t maxSize) {
+    int written = snprintf(buffer, maxSize,
+        "=== Log do boot anterior (%u mensagens, reset: %s) ===\n\n",
+        (uint32_t)s_previousCount, getResetReasonString());
+    return writtenLength(written, maxSize);
+}
+
+size_t CrashLog::formatPreviousEntry(uint16_t index, char* buffer, size_t maxSize) {
+    if (index >= s_previousCount) {
+        return 0;
+    }
+
+    const uint8_t* record = &s_previous[s_previousOffsets[s_previousCount - 1 - index]];
+    uint32_t timestamp;
+    memcpy(&timestamp, &record[2], sizeof(timestamp));
+
+    char module[LOG_MODULE_NAME_MAX_SIZE];
+    uint8_t moduleLen = record[6];
+    memcpy(module, &record[CRASH_LOG_RECORD_OVERHEAD], moduleLen);
+    module[moduleLen] = '\0';
+
+    int messageLen = record[0] - CRASH_LOG_RECORD_OVERHEAD - moduleLen;
+    const char* message = reinterpret_cast<const char*>(&record[CRASH_LOG_RECORD_OVERHEAD + moduleLen]);
+
+    int written = snprintf(buffer, maxSize,
+        "[%5u.%03u][%-5s][%-10s] %.*s\n",
+        timestamp / 1000, timestamp % 1000,
+        LogRouter::getInstance().levelToString(static_cast<LogLevel>(record[1])),
+        module, messageLen, message);
+    return writtenLength(written, maxSize);
+}
+
+bool CrashLog::hasPreviousLog() {
+    return s_previousValid;
+}
+
+uint16_t CrashLog::getPreviousCount() {
+    return s_previousCount;
+}
+
+const char* CrashLog::getResetReasonString() {
+    switch (esp_reset_reason()) {
+        case ESP_RST_POWERON:   return "power-on";
+        case ESP_RST_EXT:       return "pino externo";
+        case ESP_RST_SW:        return "software";
+        case ESP_RST_PANIC:     return "pânico";
+        case ESP_RST_INT_WDT:   return "watchdog de interrupção";
+        case ESP_RST_TASK_WDT:  return "watchdog de tarefa";
+        case ESP_RST_WDT:       return "watchdog";
+        case ESP_RST_DEEPSLEEP: return "deep sleep";
+        case ESP_RST_BROWNOUT:  return "brownout";
+        case ESP_RST_SDIO:      return "SDIO";
+        default:                return "desconhecido";
+    }
+}
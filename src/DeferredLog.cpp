@@ -0,0 +1,184 @@
+/**
+ * @file DeferredLog.cpp
+ * @brief Implementação do anel de logs com formatação adiada.
+ */
+
+#include "DeferredLog.h"
+#include "LogSystem.h"
+#include "ConsoleWriter.h"
+#include <stdarg.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace DeferredLog {
+    // Anel de bytes com os quadros pendentes. Os contadores são absolutos
+    // e o índice no anel é obtido pelo resto da divisão pelo tamanho.
+    static uint8_t s_ring[DEFLOG_RING_SIZE];
+    static uint32_t s_head = 0;
+    static uint32_t s_tail = 0;
+    static portMUX_TYPE s_ringLock = portMUX_INITIALIZER_UNLOCKED;
+
+    static Stats s_stats = {0, 0, 0};
+    static TaskHandle_t s_drainTask = nullptr;
+
+    // Intervalo entre drenagens pela tarefa de fundo (ms)
+    static const uint32_t DRAIN_INTERVAL_MS = 10;
+
+    // Espera máxima por espaço no anel de transmissão do console (ms)
+    static const uint32_t DRAIN_WRITE_TIMEOUT_MS = 100;
+
+    // Copia bytes para o anel tratando a volta ao início
+    static inline void ringWrite(uint32_t pos, const uint8_t* data, size_t len) {
+        size_t offset = pos % DEFLOG_RING_SIZE;
+        size_t first = DEFLOG_RING_SIZE - offset;
+        if (first >= len) {
+            memcpy(&s_ring[offset], data, len);
+        } else {
+            memcpy(&s_ring[offset], data, first);
+            memcpy(s_ring, data + first, len - first);
+        }
+    }
+
+    // Copia bytes do anel tratando a volta ao início
+    static inline void ringRead(uint32_t pos, uint8_t* data, size_t len) {
+        size_t offset = pos % DEFLOG_RING_SIZE;
+        size_t first = DEFLOG_RING_SIZE - offset;
+        if (first >= len) {
+            memcpy(data, &s_ring[offset], len);
+        } else {
+            memcpy(data, &s_ring[offset], first);
+            memcpy(data + first, s_ring, len - first);
+        }
+    }
+
+    static inline void putU32At(uint8_t* dest, uint32_t value) {
+        memcpy(dest, &value, sizeof(value));
+    }
+
+    void store(LogLevel level, const char* module, const char* fmt, ...) {
+        va_list args;
+        va_start(args, fmt);
+        LogRouter::getInstance().storeV(level, module, fmt, args);
+        va_end(args);
+    }
+
+    void commit(LogLevel level, const char* module, const char* fmt,
+                uint8_t* frame, const ArgEncoder& enc) {
+        size_t payloadLen = (enc.position() - frame) - 2;
+        size_t frameLen = payloadLen + 3;
+
+        // Cabeçalho
+        frame[0] = DEFLOG_FRAME_SYNC;
+        frame[1] = static_cast<uint8_t>(payloadLen);
+        frame[2] = static_cast<uint8_t>(level) | (enc.truncated() ? DEFLOG_FLAG_TRUNCATED : 0);
+        putU32At(&frame[3], millis());
+        putU32At(&frame[7], reinterpret_cast<uintptr_t>(fmt));
+        putU32At(&frame[11], reinterpret_cast<uintptr_t>(module));
+
+        // Checksum simples sobre a carga
+        uint8_t checksum = 0;
+        for (size_t i = 2; i < payloadLen + 2; i++) {
+            checksum ^= frame[i];
+        }
+        frame[payloadLen + 2] = checksum;
+
+        // Seção crítica curta: apenas a cópia para o anel
+        portENTER_CRITICAL(&s_ringLock);
+        if (DEFLOG_RING_SIZE - (s_head - s_tail) >= frameLen) {
+            ringWrite(s_head, frame, frameLen);
+            s_head += frameLen;
+            s_stats.framesWritten++;
+        } else {
+            s_stats.framesDropped++;
+        }
+        portEXIT_CRITICAL(&s_ringLock);
+    }
+
+    size_t drain() {
+        uint8_t chunk[256];
+        size_t total = 0;
+        uint32_t dropped = 0;
+
+        while (true) {
+            size_t chunkLen = 0;
+            uint32_t chunkFrames = 0;
+
+            // Retira apenas quadros completos: o ConsoleWriter grava cada
+            // bloco inteiro, sem intercalar com o texto de outras tarefas
+            portENTER_CRITICAL(&s_ringLock);
+            while (s_head != s_tail) {
+                uint8_t header[2];
+                ringRead(s_tail, header, sizeof(header));
+                size_t frameLen = header[1] + 3;
+
+                if (chunkLen + frameLen > sizeof(chunk)) {
+                    break;
+                }
+
+                ringRead(s_tail, &chunk[chunkLen], frameLen);
+                chunkLen += frameLen;
+                chunkFrames++;
+                s_tail += frameLen;
+            }
+            portEXIT_CRITICAL(&s_ringLock);
+
+            if (chunkLen == 0) {
+                break;
+            }
+
+            if (ConsoleWriter::write(reinterpret_cast<const char*>(chunk), chunkLen,
+                                     DRAIN_WRITE_TIMEOUT_MS)) {
+                total += chunkLen;
+            } else {
+                dropped += chunkFrames;
+            }
+        }
+
+        if (total > 0 || dropped > 0) {
+            portENTER_CRITICAL(&s_ringLock);
+            s_stats.bytesWritten += total;
+            s_stats.framesDropped += dropped;
+            portEXIT_CRITICAL(&s_ringLock);
+        }
+
+        return total;
+    }
+
+    void flush() {
+        drain();
+        ConsoleWriter::flush();
+    }
+
+    Stats getStats() {
+        portENTER_CRITICAL(&s_ringLock);
+        Stats copy = s_stats;
+        portEXIT_CRITICAL(&s_ringLock);
+        return copy;
+    }
+
+    /**
+     * Tarefa de baixa prioridade que envia os quadros para o console.
+     */
+    static void drainTaskFunc(void*) {
+        while (true) {
+            drain();
+            vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+        }
+    }
+
+    void begin() {
+        if (s_drainTask != nullptr) {
+            return;
+        }
+
+        xTaskCreatePinnedToCore(
+            drainTaskFunc,
+            "DeferredLog",
+            2048,
+            NULL,
+            1,
+            &s_drainTask,
+            TASK_WEB_CORE
+        );
+    }
+}
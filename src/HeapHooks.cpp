@@ -0,0 +1,121 @@
+/**
+ * @file HeapHooks.cpp
+ * @brief Wrappers de malloc/calloc/realloc/free para o HeapProfiler e o
+ *        AllocationGuard.
+ *
+ * O linker redireciona as chamadas para __wrap_* quando o firmware é ligado
+ * com -Wl,--wrap=malloc (ambientes esp32dev_heap_profile e
+ * esp32dev_alloc_guard). Isso inclui
+ * operator new e as bibliotecas do framework ligadas estaticamente;
+ * alocações feitas diretamente com heap_caps_malloc não passam por aqui.
+ */
+
+#include "HeapProfiler.h"
+#include "AllocationGuard.h"
+
+#if HEAP_PROFILE_ENABLED || ALLOC_GUARD_ENABLED
+
+#include <esp_debug_helpers.h>
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+}
+
+#if HEAP_PROFILE_ENABLED
+// Converte um endereço de retorno do ABI com janelas do Xtensa (2 bits
+// altos = incremento da janela) no endereço da instrução de chamada
+static inline uint32_t callAddress(uint32_t returnAddress) {
+    if (returnAddress & 0x80000000) {
+        returnAddress = (returnAddress & 0x3FFFFFFF) | 0x40000000;
+    }
+    return returnAddress - 3;
+}
+
+// Captura os endereços de retorno a partir de quem chamou o wrapper.
+// Precisa ser expandida no próprio wrapper para que o primeiro quadro
+// seja o dele.
+static inline __attribute__((always_inline)) void captureFrames(uint32_t* frames) {
+    esp_backtrace_frame_t frame;
+    esp_backtrace_get_start(&frame.pc, &frame.sp, &frame.next_pc);
+
+    int depth = 0;
+    while (depth < HEAP_PROFILE_SITE_DEPTH && frame.next_pc != 0) {
+        frames[depth++] = callAddress(frame.next_pc);
+        if (!esp_backtrace_get_next_frame(&frame)) {
+            break;
+        }
+    }
+
+    while (depth < HEAP_PROFILE_SITE_DEPTH) {
+        frames[depth++] = 0;
+    }
+}
+
+// Quadros do ponto de chamada, capturados no próprio wrapper
+#define CAPTURE_SITE(frames) \
+    uint32_t frames[HEAP_PROFILE_SITE_DEPTH]; \
+    captureFrames(frames)
+#else
+#define CAPTURE_SITE(frames) \
+    const uint32_t* frames = nullptr
+#endif
+
+static inline void noteAlloc(void* ptr, size_t size, const uint32_t* frames) {
+#if HEAP_PROFILE_ENABLED
+    HeapProfiler::recordAlloc(ptr, size, frames);
+#endif
+#if ALLOC_GUARD_ENABLED
+    AllocationGuard::onAllocation(size);
+#endif
+    (void)ptr;
+    (void)size;
+    (void)frames;
+}
+
+static inline void noteFree(void* ptr) {
+#if HEAP_PROFILE_ENABLED
+    HeapProfiler::recordFree(ptr);
+#endif
+    (void)ptr;
+}
+
+extern "C" void* __wrap_malloc(size_t size) {
+    CAPTURE_SITE(frames);
+
+    void* ptr = __real_malloc(size);
+    noteAlloc(ptr, size, frames);
+    return ptr;
+}
+
+extern "C" void* __wrap_calloc(size_t count, size_t size) {
+    CAPTURE_SITE(frames);
+
+    void* ptr = __real_calloc(count, size);
+    noteAlloc(ptr, count * size, frames);
+    return ptr;
+}
+
+extern "C" void* __wrap_realloc(void* ptr, size_t size) {
+    CAPTURE_SITE(frames);
+
+    void* result = __real_realloc(ptr, size);
+
+    // Em caso de falha o bloco original continua válido
+    if (result || size == 0) {
+        noteFree(ptr);
+        noteAlloc(result, size, frames);
+    }
+    return result;
+}
+
+extern "C" void __wrap_free(void* ptr) {
+    // Remove o registro antes de liberar, para que outra tarefa não
+    // receba o mesmo endereço enquanto ele ainda consta como vivo
+    noteFree(ptr);
+    __real_free(ptr);
+}
+
+#endif // HEAP_PROFILE_ENABLED || ALLOC_GUARD_ENABLED
@@ -0,0 +1,158 @@
+/**
+ * @file HeapIntegrityChecker.cpp
+ * @brief Implementação da verificação incremental do heap.
+ */
+
+#include "HeapIntegrityChecker.h"
+#include "LogSystem.h"
+#include "SystemMonitor.h"
+#include <esp_heap_caps.h>
+#include <soc/soc_memory_layout.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Nome do módulo para logs
+#define MODULE_NAME "HeapCheck"
+
+/**
+ * Região de heap verificada, inteira, em uma fatia. A sondagem usa o último endereço
+ * da região, pois reservas de inicialização (.data, .bss, pilhas) ficam no
+ * início das regiões e o heap registrado termina junto com elas.
+ */
+struct HeapRegion {
+    intptr_t probe;
+    uint32_t size;
+};
+
+static HeapRegion s_regions[HEAP_CHECK_MAX_REGIONS];
+static HeapIntegrityChecker::Stats s_stats = {};
+static uint32_t s_passMicros = 0;
+static TaskHandle_t s_task = nullptr;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+bool HeapIntegrityChecker::begin() {
+    if (s_task != nullptr) {
+        return true;
+    }
+
+    // Com o heap íntegro, uma sondagem que falha indica apenas que a região
+    // não foi registrada como heap (memória reservada)
+    if (!heap_caps_check_integrity_all(true)) {
+        LOG_FATAL(MODULE_NAME, "Heap corrompido já na inicialização");
+        return false;
+    }
+
+    uint8_t count = 0;
+    size_t i = 0;
+    while (i < soc_memory_region_count && count < HEAP_CHECK_MAX_REGIONS) {
+        // Regiões contíguas do mesmo tipo formam um único heap
+        intptr_t start = soc_memory_regions[i].start;
+        intptr_t end = start + soc_memory_regions[i].size;
+        size_t type = soc_memory_regions[i].type;
+        i++;
+        while (i < soc_memory_region_count &&
+               soc_memory_regions[i].start == end &&
+               soc_memory_regions[i].type == type) {
+            end += soc_memory_regions[i].size;
+            i++;
+        }
+
+        intptr_t probe = end - sizeof(uint32_t);
+        if (heap_caps_check_integrity_addr(probe, false)) {
+            s_regions[count].probe = probe;
+            s_regions[count].size = end - start;
+            count++;
+        }
+    }
+
+    s_stats.regions = count;
+    if (count == 0) {
+        LOG_WARN(MODULE_NAME, "Nenhuma região de heap encontrada para verificação");
+        return false;
+    }
+
+    BaseType_t created = xTaskCreatePinnedToCore(
+        taskFunc,
+        "HeapCheck",
+        HEAP_CHECK_STACK_SIZE,
+        NULL,
+        HEAP_CHECK_TASK_PRIORITY,
+        &s_task,
+        HEAP_CHECK_TASK_CORE
+    );
+
+    if (created != pdPASS) {
+        LOG_ERROR(MODULE_NAME, "Falha ao criar tarefa de verificação do heap");
+        s_task = nullptr;
+        return false;
+    }
+
+    LOG_INFO(MODULE_NAME, "Verificação incremental: %u regiões inteiras, uma a cada %u ms",
+             count, HEAP_CHECK_SLICE_INTERVAL_MS);
+    return true;
+}
+
+bool HeapIntegrityChecker::runSlice() {
+    uint8_t index = s_stats.nextRegion;
+    const HeapRegion& region = s_regions[index];
+
+    uint32_t start = micros();
+    bool valid = heap_caps_check_integrity_addr(region.probe, false);
+    uint32_t elapsed = micros() - start;
+
+    bool passComplete = false;
+
+    portENTER_CRITICAL(&s_lock);
+    s_stats.slices++;
+    s_stats.lastSliceMicros = elapsed;
+    if (elapsed > s_stats.maxSliceMicros) {
+        s_stats.maxSliceMicros = elapsed;
+        s_stats.maxSliceBytes = region.size;
+    }
+    if (!valid) {
+        s_stats.failures++;
+    }
+
+    s_passMicros += elapsed;
+    s_stats.nextRegion = (index + 1) % s_stats.regions;
+    if (s_stats.nextRegion == 0) {
+        s_stats.passes++;
+        s_stats.lastPassMicros = s_passMicros;
+        s_stats.lastPassTime = millis();
+        s_passMicros = 0;
+        passComplete = true;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    LOG_TRACE(MODULE_NAME, "Região %u (%u bytes): %s em %u us",
+              index, region.size, valid ? "ok" : "CORROMPIDA", elapsed);
+
+    if (passComplete && DEBUG_MEMORY) {
+        LOG_DEBUG(MODULE_NAME, "Passada #%u concluída: %u us no total, maior região %u us (%u bytes)",
+                  s_stats.passes, s_stats.lastPassMicros, s_stats.maxSliceMicros,
+                  s_stats.maxSliceBytes);
+    }
+
+    return valid;
+}
+
+void HeapIntegrityChecker::taskFunc(void*) {
+    const TickType_t interval = pdMS_TO_TICKS(HEAP_CHECK_SLICE_INTERVAL_MS);
+
+    while (true) {
+        vTaskDelay(interval);
+
+        if (!runSlice()) {
+            // Confirma com a verificação completa, que imprime os detalhes
+            // da corrupção e decide entre alertar e reiniciar
+            SystemMonitor::getInstance().checkSystemIntegrity();
+        }
+    }
+}
+
+HeapIntegrityChecker::Stats HeapIntegrityChecker::getStats() {
+    portENTER_CRITICAL(&s_lock);
+    Stats stats = s_stats;
+    portEXIT_CRITICAL(&s_lock);
+    return stats;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file HeapProfiler.cpp
+ * @brief Tabelas de atribuição de alocações e linha do tempo de fragmentação.
+ *
+ * Chamado a partir dos wrappers de malloc/free: nada aqui pode alocar
+ * memória nem registrar logs.
+ */
+
+#include "HeapProfiler.h"
+
+#if HEAP_PROFILE_ENABLED
+
+#include <esp_heap_caps.h>
+#include <freertos/task.h>
+
+static_assert((HEAP_PROFILE_MAX_LIVE & (HEAP_PROFILE_MAX_LIVE - 1)) == 0,
+              "HEAP_PROFILE_MAX_LIVE deve ser potência de 2");
+
+// Índice reservado para blocos sem tarefa ou ponto de chamada atribuído
+#define NO_INDEX            0xFF
+
+// Tabela de hash dos pontos de chamada (endereçamento aberto)
+#define SITE_HASH_SIZE      (HEAP_PROFILE_MAX_SITES * 2)
+
+/**
+ * Bloco vivo rastreado. ptr == 0 marca posição vazia.
+ */
+struct LiveBlock {
+    uint32_t ptr;
+    uint32_t size;
+    uint8_t site;
+    uint8_t module;
+};
+
+static LiveBlock s_live[HEAP_PROFILE_MAX_LIVE];
+static uint16_t s_liveBlocks = 0;
+static uint32_t s_untracked = 0;
+
+static TaskHandle_t s_moduleTasks[HEAP_PROFILE_MAX_MODULES];
+static HeapProfiler::ModuleStats s_modules[HEAP_PROFILE_MAX_MODULES];
+static uint8_t s_moduleCount = 0;
+
+static HeapProfiler::SiteStats s_sites[HEAP_PROFILE_MAX_SITES];
+static uint8_t s_siteHash[SITE_HASH_SIZE];
+static uint16_t s_siteCount = 0;
+static bool s_siteHashReady = false;
+
+static HeapProfiler::TimelineSample s_timeline[HEAP_PROFILE_TIMELINE_SIZE];
+static uint16_t s_timelineHead = 0;
+static uint16_t s_timelineCount = 0;
+static uint32_t s_lastSampleTime = 0;
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static inline uint32_t hashPointer(uint32_t ptr) {
+    // Multiplicação de Fibonacci; os 3 bits baixos são sempre zero
+    return ((ptr >> 3) * 2654435761u) & (HEAP_PROFILE_MAX_LIVE - 1);
+}
+
+// Tarefa atual como módulo; a última posição agrupa as excedentes
+static uint8_t moduleIndex() {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+    for (uint8_t i = 0; i < s_moduleCount; i++) {
+        if (s_moduleTasks[i] == task) {
+            return i;
+        }
+    }
+
+    if (s_moduleCount == HEAP_PROFILE_MAX_MODULES) {
+        return HEAP_PROFILE_MAX_MODULES - 1;
+    }
+
+    uint8_t index = s_moduleCount++;
+    HeapProfiler::ModuleStats& module = s_modules[index];
+    const char* name = (s_moduleCount == HEAP_PROFILE_MAX_MODULES) ? "outras" :
+                       (task ? pcTaskGetTaskName(task) : "boot");
+
+    strncpy(module.name, name, sizeof(module.name) - 1);
+    module.name[sizeof(module.name) - 1] = '\0';
+    s_moduleTasks[index] = task;
+    return index;
+}
+
+static uint8_t siteIndex(const uint32_t* frames) {
+    if (!s_siteHashReady) {
+        memset(s_siteHash, NO_INDEX, sizeof(s_siteHash));
+        s_siteHashReady = true;
+    }
+
+    uint32_t hash = 0;
+    for (int i = 0; i < HEAP_PROFILE_SITE_DEPTH; i++) {
+        hash = (hash ^ frames[i]) * 16777619u;
+    }
+
+    for (uint32_t probe = 0; probe < SITE_HASH_SIZE; probe++) {
+        uint32_t slot = (hash + probe) % SITE_HASH_SIZE;
+        uint8_t index = s_siteHash[slot];
+
+        if (index == NO_INDEX) {
+            if (s_siteCount == HEAP_PROFILE_MAX_SITES) {
+                return NO_INDEX;
+            }
+            index = s_siteCount++;
+            memcpy(s_sites[index].frames, frames, sizeof(s_sites[index].frames));
+            s_siteHash[slot] = index;
+            return index;
+        }
+
+        if (memcmp(s_sites[index].frames, frames, sizeof(s_sites[index].frames)) == 0) {
+            return index;
+        }
+    }
+
+    return NO_INDEX;
+}
+
+// Remove a posição i com deslocamento reverso, mantendo as sondagens válidas
+static void removeLive(uint32_t i) {
+    uint32_t j = i;
+    while (true) {
+        j = (j + 1) & (HEAP_PROFILE_MAX_LIVE - 1);
+        if (s_live[j].ptr == 0) {
+            break;
+        }
+
+        uint32_t home = hashPointer(s_live[j].ptr);
+        bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+            s_live[i] = s_live[j];
+            i = j;
+        }
+    }
+    s_live[i].ptr = 0;
+}
+
+void HeapProfiler::recordAlloc(void* ptr, size_t size, const uint32_t* frames) {
+    if (!ptr) {
+        return;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+
+    // Mantém a tabela de blocos vivos com no máximo 7/8 de ocupação
+    if (s_liveBlocks >= HEAP_PROFILE_MAX_LIVE - HEAP_PROFILE_MAX_LIVE / 8) {
+        s_untracked++;
+        portEXIT_CRITICAL(&s_lock);
+        return;
+    }
+
+    uint8_t module = moduleIndex();
+    uint8_t site = siteIndex(frames);
+
+    uint32_t slot = hashPointer(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ptr)));
+    while (s_live[slot].ptr != 0) {
+        slot = (slot + 1) & (HEAP_PROFILE_MAX_LIVE - 1);
+    }
+    s_live[slot].ptr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ptr));
+    s_live[slot].size = size;
+    s_live[slot].module = module;
+    s_live[slot].site = site;
+    s_liveBlocks++;
+
+    ModuleStats& moduleStats = s_modules[module];
+    moduleStats.allocCount++;
+    moduleStats.totalBytes += size;
+    moduleStats.liveBytes += size;
+    if (moduleStats.liveBytes > moduleStats.peakLiveBytes) {
+        moduleStats.peakLiveBytes = moduleStats.liveBytes;
+    }
+
+    if (site != NO_INDEX) {
+        SiteStats& siteStats = s_sites[site];
+        siteStats.allocCount++;
+        siteStats.totalBytes += size;
+        siteStats.liveBytes += size;
+    }
+
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void HeapProfiler::recordFree(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    uint32_t address = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ptr));
+
+    portENTER_CRITICAL(&s_lock);
+
+    uint32_t slot = hashPointer(address);
+    while (s_live[slot].ptr != 0) {
+        if (s_live[slot].ptr == address) {
+            const LiveBlock& block = s_live[slot];
+
+            ModuleStats& moduleStats = s_modules[block.module];
+            moduleStats.freeCount++;
+            moduleStats.liveBytes -= block.size;
+
+            if (block.site != NO_INDEX) {
+                SiteStats& siteStats = s_sites[block.site];
+                siteStats.freeCount++;
+                siteStats.liveBytes -= block.size;
+            }
+
+            removeLive(slot);
+            s_liveBlocks--;
+            break;
+        }
+        slot = (slot + 1) & (HEAP_PROFILE_MAX_LIVE - 1);
+    }
+
+    // Blocos não encontrados foram alocados antes do hook ou não couberam na tabela
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void HeapProfiler::sample() {
+    uint32_t now = millis();
+    if (s_timelineCount > 0 && now - s_lastSampleTime < HEAP_PROFILE_SAMPLE_INTERVAL_MS) {
+        return;
+    }
+    s_lastSampleTime = now;
+
+    // Consulta o heap fora da seção crítica
+    TimelineSample entry;
+    entry.uptime = now / 1000;
+    entry.freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    entry.largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    entry.fragmentation = entry.freeHeap > 0 ?
+        100 - (entry.largestBlock * 100 / entry.freeHeap) : 0;
+
+    portENTER_CRITICAL(&s_lock);
+    entry.liveBlocks = s_liveBlocks;
+    s_timeline[s_timelineHead] = entry;
+    s_timelineHead = (s_timelineHead + 1) % HEAP_PROFILE_TIMELINE_SIZE;
+    if (s_timelineCount < HEAP_PROFILE_TIMELINE_SIZE) {
+        s_timelineCount++;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void HeapProfiler::getSnapshot(Snapshot& snapshot) {
+    portENTER_CRITICAL(&s_lock);
+
+    snapshot.moduleCount = s_moduleCount;
+    memcpy(snapshot.modules, s_modules, s_moduleCount * sizeof(ModuleStats));
+
+    snapshot.siteCount = s_siteCount;
+    memcpy(snapshot.sites, s_sites, s_siteCount * sizeof(SiteStats));
+
+    // Lineariza a linha do tempo, do mais antigo ao mais recente
+    snapshot.timelineCount = s_timelineCount;
+    uint16_t start = (s_timelineHead + HEAP_PROFILE_TIMELINE_SIZE - s_timelineCount) % HEAP_PROFILE_TIMELINE_SIZE;
+    for (uint16_t i = 0; i < s_timelineCount; i++) {
+        snapshot.timeline[i] = s_timeline[(start + i) % HEAP_PROFILE_TIMELINE_SIZE];
+    }
+
+    snapshot.liveBlocks = s_liveBlocks;
+    snapshot.untracked = s_untracked;
+
+    portEXIT_CRITICAL(&s_lock);
+}
+
+#endif // HEAP_PROFILE_ENABLED
@@ -0,0 +1,261 @@
+/**
+ * @file InstrumentedMutex.cpp
+ * @brief Implementação do mutex instrumentado e do registro de mutexes.
+ *
+ * Não loga: o próprio ConsoleWriter usa um InstrumentedMutex.
+ */
+
+#include "InstrumentedMutex.h"
+#include "ConsoleCommands.h"
+#include "TraceRecorder.h"
+#include <esp_timer.h>
+
+const uint32_t InstrumentedMutex::HISTOGRAM_BOUNDS[HISTOGRAM_BUCKETS - 1] = {
+    10, 100, 1000, 10000, 100000
+};
+
+static InstrumentedMutex* s_registry[LOCK_PROFILE_MAX_LOCKS] = {nullptr};
+static uint8_t s_count = 0;
+
+// Protege o registro; os contadores usam o lock de cada mutex
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void copyTaskName(char* destination, TaskHandle_t task) {
+    if (task) {
+        strncpy(destination, pcTaskGetName(task), configMAX_TASK_NAME_LEN - 1);
+        destination[configMAX_TASK_NAME_LEN - 1] = '\0';
+    } else {
+        destination[0] = '\0';
+    }
+}
+
+#if LOCK_PROFILE_ENABLED
+static uint32_t elapsedMicros(int64_t start, int64_t end) {
+    int64_t elapsed = end - start;
+    return elapsed > 0 ? (elapsed > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(elapsed)) : 0;
+}
+#endif
+
+InstrumentedMutex::InstrumentedMutex(const char* name)
+    : m_name(name), m_handle(nullptr), m_owner(nullptr), m_acquiredAt(0),
+      m_lock(portMUX_INITIALIZER_UNLOCKED) {
+#if TRACE_ENABLED
+    m_traceName = 0;
+#endif
+    clear();
+}
+
+InstrumentedMutex::~InstrumentedMutex() {
+    destroy();
+}
+
+void InstrumentedMutex::clear() {
+    // O nome do dono é preenchido na cópia; aqui só os contadores
+    memset(&m_stats, 0, sizeof(m_stats));
+    m_stats.name = m_name;
+}
+
+bool InstrumentedMutex::create() {
+    if (m_handle) {
+        return true;
+    }
+
+    m_handle = xSemaphoreCreateMutex();
+    if (!m_handle) {
+        return false;
+    }
+
+#if TRACE_ENABLED
+    m_traceName = TraceRecorder::internName(m_name);
+#endif
+
+    // Sem espaço no registro o mutex funciona, só não aparece nos relatórios
+    portENTER_CRITICAL(&s_lock);
+    if (s_count < LOCK_PROFILE_MAX_LOCKS) {
+        s_registry[s_count++] = this;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    return true;
+}
+
+void InstrumentedMutex::destroy() {
+    if (!m_handle) {
+        return;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    for (uint8_t i = 0; i < s_count; i++) {
+        if (s_registry[i] == this) {
+            for (uint8_t j = i; j < s_count - 1; j++) {
+                s_registry[j] = s_registry[j + 1];
+            }
+            s_registry[--s_count] = nullptr;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    vSemaphoreDelete(m_handle);
+    m_handle = nullptr;
+    m_owner = nullptr;
+}
+
+uint8_t InstrumentedMutex::bucketOf(uint32_t micros) {
+    uint8_t bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && micros >= HISTOGRAM_BOUNDS[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+bool InstrumentedMutex::take(TickType_t ticks) {
+    if (!m_handle) {
+        return false;
+    }
+
+#if !LOCK_PROFILE_ENABLED
+    if (xSemaphoreTake(m_handle, ticks) != pdTRUE) {
+        return false;
+    }
+    m_owner = xTaskGetCurrentTaskHandle();
+    return true;
+#else
+    int64_t start = esp_timer_get_time();
+    bool contended = false;
+
+    // Tentativa sem espera: o caminho comum não toca no trace
+    if (xSemaphoreTake(m_handle, 0) != pdTRUE) {
+        contended = true;
+        bool taken = false;
+
+        if (ticks > 0) {
+#if TRACE_ENABLED
+            TraceRecorder::record(TraceRecorder::BEGIN, m_traceName);
+#endif
+            taken = xSemaphoreTake(m_handle, ticks) == pdTRUE;
+#if TRACE_ENABLED
+            TraceRecorder::record(TraceRecorder::END, m_traceName, taken ? 1 : 0);
+#endif
+        }
+
+        if (!taken) {
+            uint32_t waited = elapsedMicros(start, esp_timer_get_time());
+
+            portENTER_CRITICAL(&m_lock);
+            m_stats.timeouts++;
+            m_stats.totalWaitMicros += waited;
+            copyTaskName(m_stats.lastTimeoutWaiter, xTaskGetCurrentTaskHandle());
+            copyTaskName(m_stats.lastTimeoutHolder, m_owner);
+            portEXIT_CRITICAL(&m_lock);
+            return false;
+        }
+    }
+
+    int64_t now = esp_timer_get_time();
+    uint32_t waited = elapsedMicros(start, now);
+    m_acquiredAt = now;
+
+    portENTER_CRITICAL(&m_lock);
+    m_owner = xTaskGetCurrentTaskHandle();
+    m_stats.acquisitions++;
+    if (contended) {
+        m_stats.contended++;
+    }
+    m_stats.totalWaitMicros += waited;
+    if (waited > m_stats.maxWaitMicros) {
+        m_stats.maxWaitMicros = waited;
+    }
+    m_stats.waitHistogram[bucketOf(waited)]++;
+    portEXIT_CRITICAL(&m_lock);
+
+    return true;
+#endif // LOCK_PROFILE_ENABLED
+}
+
+void InstrumentedMutex::give() {
+    // Só o dono libera; m_owner só muda nas mãos de quem detém o mutex
+    if (!m_handle || m_owner != xTaskGetCurrentTaskHandle()) {
+        return;
+    }
+
+#if LOCK_PROFILE_ENABLED
+    uint32_t held = elapsedMicros(m_acquiredAt, esp_timer_get_time());
+
+    portENTER_CRITICAL(&m_lock);
+    m_owner = nullptr;
+    m_stats.totalHoldMicros += held;
+    if (held > m_stats.maxHoldMicros) {
+        m_stats.maxHoldMicros = held;
+    }
+    m_stats.holdHistogram[bucketOf(held)]++;
+    portEXIT_CRITICAL(&m_lock);
+#else
+    m_owner = nullptr;
+#endif
+
+    xSemaphoreGive(m_handle);
+}
+
+uint8_t InstrumentedMutex::getCount() {
+    return s_count;
+}
+
+bool InstrumentedMutex::getStats(uint8_t index, Stats& stats) {
+    bool found = false;
+
+    portENTER_CRITICAL(&s_lock);
+    if (index < s_count) {
+        InstrumentedMutex* mutex = s_registry[index];
+        portENTER_CRITICAL(&mutex->m_lock);
+        stats = mutex->m_stats;
+        copyTaskName(stats.owner, mutex->m_owner);
+        portEXIT_CRITICAL(&mutex->m_lock);
+        found = true;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    return found;
+}
+
+void InstrumentedMutex::resetAll() {
+    portENTER_CRITICAL(&s_lock);
+    for (uint8_t i = 0; i < s_count; i++) {
+        InstrumentedMutex* mutex = s_registry[i];
+        portENTER_CRITICAL(&mutex->m_lock);
+        mutex->clear();
+        portEXIT_CRITICAL(&mutex->m_lock);
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void InstrumentedMutex::printReport(const char* args) {
+    if (args && strcmp(args, "reset") == 0) {
+        resetAll();
+        ConsoleCommands::printf("Contadores dos mutexes zerados\n");
+        return;
+    }
+
+    if (!LOCK_PROFILE_ENABLED) {
+        ConsoleCommands::printf("Contadores desligados (LOCK_PROFILE_ENABLED); só o dono é atualizado\n");
+    }
+
+    ConsoleCommands::printf("%-20s %10s %9s %8s %10s %10s %10s %-16s\n",
+                            "mutex", "aquisições", "esperas", "timeouts",
+                            "espera máx", "posse máx", "posse méd", "dono");
+
+    Stats stats;
+    for (uint8_t i = 0; getStats(i, stats); i++) {
+        uint32_t meanHold = stats.acquisitions
+            ? static_cast<uint32_t>(stats.totalHoldMicros / stats.acquisitions) : 0;
+        ConsoleCommands::printf("%-20s %10u %9u %8u %10u %10u %10u %-16s\n",
+                                stats.name, stats.acquisitions, stats.contended, stats.timeouts,
+                                stats.maxWaitMicros, stats.maxHoldMicros, meanHold,
+                                stats.owner[0] ? stats.owner : "-");
+        if (stats.timeouts > 0) {
+            ConsoleCommands::printf("  último timeout: %s esperando, %s com o mutex\n",
+                                    stats.lastTimeoutWaiter,
+                                    stats.lastTimeoutHolder[0] ? stats.lastTimeoutHolder : "-");
+        }
+    }
+}
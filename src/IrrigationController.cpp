@@ -5,6 +5,7 @@
 
 #include "IrrigationController.h"
 #include "LogSystem.h"
+#include "ProfileZone.h"
 
 // Define o nome do módulo para logging
 #define MODULE_NAME "IrrigationController"
@@ -72,12 +73,14 @@ bool IrrigationController::init() {
 
     LOG_INFO(MODULE_NAME, "Controlador inicializado com sucesso");
     LOG_INFO(MODULE_NAME, "Limiar de umidade: %.1f%% - %.1f%%",
-             MOISTURE_THRESHOLD_LOW, MOISTURE_THRESHOLD_HIGH);
+             m_tuning.thresholdLow, m_tuning.thresholdHigh);
 
     return true;
 }
 
 bool IrrigationController::update() {
+    PROFILE_ZONE("irrigation.update");
+
     if (!m_initialized) {
         return false;
     }
@@ -132,27 +135,27 @@ bool IrrigationController::updateDecision(const SensorData& sensorData) {
         // Bomba desligada - verifica se deve ligar
         if (sensorData.humidityPercent < m_data.currentThreshold) {
             // Verifica tempo mínimo entre ativações
-            if (currentTime - m_data.lastDeactivationTime >= IRRIGATION_MIN_INTERVAL) {
+            if (currentTime - m_data.lastDeactivationTime >= m_tuning.minInterval) {
                 shouldActivate = true;
                 LOG_INFO(MODULE_NAME, "Decisão automática: ATIVAR - Umidade %.1f%% < %.1f%%",
                          sensorData.humidityPercent, m_data.currentThreshold);
             } else {
-                uint32_t remaining = IRRIGATION_MIN_INTERVAL - (currentTime - m_data.lastDeactivationTime);
+                uint32_t remaining = m_tuning.minInterval - (currentTime - m_data.lastDeactivationTime);
                 LOG_DEBUG(MODULE_NAME, "Aguardando intervalo mínimo - restam %u ms", remaining);
             }
         }
     } else {
         // Bomba ligada - verifica se deve desligar
-        if (sensorData.humidityPercent >= MOISTURE_THRESHOLD_HIGH) {
+        if (sensorData.humidityPercent >= m_tuning.thresholdHigh) {
             shouldDeactivate = true;
             LOG_INFO(MODULE_NAME, "Decisão automática: DESATIVAR - Umidade %.1f%% >= %.1f%%",
-                     sensorData.humidityPercent, MOISTURE_THRESHOLD_HIGH);
+                     sensorData.humidityPercent, m_tuning.thresholdHigh);
         }
     }
 
     // Executa a decisão
     if (shouldActivate) {
-        return activateInternal(IRRIGATION_MAX_RUNTIME, false);
+        return activateInternal(m_tuning.maxRuntime, false);
     } else if (shouldDeactivate) {
         return deactivate(false);
     }
@@ -186,7 +189,7 @@ bool IrrigationController::activateInternal(uint32_t duration, bool manual) {
     uint32_t currentTime = millis();
 
     // Verifica intervalo mínimo apenas para ativação automática
-    if (!manual && (currentTime - m_data.lastDeactivationTime < IRRIGATION_MIN_INTERVAL)) {
+    if (!manual && (currentTime - m_data.lastDeactivationTime < m_tuning.minInterval)) {
         LOG_WARN(MODULE_NAME, "Bloqueado: intervalo mínimo não respeitado");
         return false;
     }
@@ -206,6 +209,7 @@ bool IrrigationController::activateInternal(uint32_t duration, bool manual) {
     // Atualiza estado interno
     m_data.pumpActive = true;
     m_data.activationTime = currentTime;
+    m_lastRuntimeUpdate = currentTime;  // Sem isso, o tempo parado entraria no runtime
     m_data.manualMode = manual;
     m_data.dailyActivations++;
 
@@ -310,7 +314,7 @@ bool IrrigationController::checkSafetyConditions() {
     }
 
     // Verifica se não excedeu limite diário de ativações
-    if (m_data.dailyActivations > 50) { // Limite razoável
+    if (m_data.dailyActivations >= IRRIGATION_MAX_DAILY_ACTIVATIONS) {
         LOG_ERROR(MODULE_NAME, "Limite diário de ativações excedido: %d", m_data.dailyActivations);
         return false;
     }
@@ -366,6 +370,32 @@ void IrrigationController::resetDailyCounters() {
     LOG_INFO(MODULE_NAME, "Contadores diários resetados");
 }
 
+bool IrrigationController::setTuning(const IrrigationTuning& tuning) {
+    if (tuning.thresholdLow < 0.0f || tuning.thresholdHigh > 100.0f ||
+        tuning.thresholdLow >= tuning.thresholdHigh) {
+        LOG_ERROR(MODULE_NAME, "Limiares inválidos: %.1f%% - %.1f%%",
+                  tuning.thresholdLow, tuning.thresholdHigh);
+        return false;
+    }
+
+    if (tuning.maxRuntime == 0 || tuning.maxRuntime > IRRIGATION_MAX_RUNTIME) {
+        LOG_ERROR(MODULE_NAME, "Duração máxima inválida: %u ms (limite %u ms)",
+                  tuning.maxRuntime, IRRIGATION_MAX_RUNTIME);
+        return false;
+    }
+
+    m_tuning = tuning;
+    m_data.currentThreshold = tuning.thresholdLow;
+
+    LOG_INFO(MODULE_NAME, "Parâmetros: %.1f%% - %.1f%%, intervalo %u ms, duração %u ms",
+             tuning.thresholdLow, tuning.thresholdHigh, tuning.minInterval, tuning.maxRuntime);
+    return true;
+}
+
+const IrrigationTuning& IrrigationController::getTuning() const {
+    return m_tuning;
+}
+
 bool IrrigationController::isActive() const {
     return m_data.pumpActive;
 }
@@ -0,0 +1,280 @@
+/**
+ * @file JobScheduler.cpp
+ * @brief Implementação da roda de tempo hierárquica dos jobs periódicos.
+ */
+
+#include "JobScheduler.h"
+#include "ConsoleCommands.h"
+#include "LogSystem.h"
+#include <esp_timer.h>
+
+// Define o nome do módulo para logging
+#define MODULE_NAME "Jobs"
+
+static const uint8_t WHEEL_LEVELS = 3;
+static const uint32_t WHEEL_SLOTS = 1U << JOB_SCHEDULER_WHEEL_BITS;
+static const uint32_t WHEEL_MASK = WHEEL_SLOTS - 1;
+static const uint32_t WHEEL_SPAN = 1U << (WHEEL_LEVELS * JOB_SCHEDULER_WHEEL_BITS);
+static const uint32_t TICK_MICROS = JOB_SCHEDULER_TICK_MS * 1000U;
+
+static_assert(JOB_SCHEDULER_MAX_JOBS <= 127, "Os índices dos jobs são int8_t");
+
+/**
+ * Job registrado; next encadeia os jobs de uma mesma posição da roda.
+ */
+struct Job {
+    JobScheduler::Handler handler;
+    void* context;
+    uint32_t periodTicks;
+    uint32_t dueTick;
+    int8_t next;
+    JobScheduler::Stats stats;
+};
+
+/**
+ * Roda de um core. currentTick é o próximo tick a processar; só a tarefa do
+ * core avança a roda, mas add() pode inserir de outra tarefa.
+ */
+struct Wheel {
+    uint32_t currentTick;
+    bool started;
+    int8_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+};
+
+static Job s_jobs[JOB_SCHEDULER_MAX_JOBS];
+static uint8_t s_count = 0;
+static Wheel s_wheels[JobScheduler::CORE_COUNT];
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t currentTickOf(int64_t micros) {
+    return static_cast<uint32_t>(micros / TICK_MICROS);
+}
+
+/**
+ * Coloca o job no nível pela distância até o vencimento. Chamar com o lock.
+ */
+static void place(Wheel& wheel, int8_t index) {
+    Job& job = s_jobs[index];
+    uint32_t due = job.dueTick;
+    uint32_t delta = due - wheel.currentTick;
+
+    // Vencido: entra na posição do próximo tick processado
+    if (static_cast<int32_t>(delta) < 0) {
+        delta = 0;
+        due = wheel.currentTick;
+    }
+
+    int8_t* head;
+    if (delta < WHEEL_SLOTS) {
+        head = &wheel.slots[0][due & WHEEL_MASK];
+    } else if (delta < (WHEEL_SLOTS << JOB_SCHEDULER_WHEEL_BITS)) {
+        head = &wheel.slots[1][(due >> JOB_SCHEDULER_WHEEL_BITS) & WHEEL_MASK];
+    } else {
+        // Além do alcance da roda: estaciona no fim e reposiciona ao descer
+        if (delta >= WHEEL_SPAN) {
+            due = wheel.currentTick + WHEEL_SPAN - 1;
+        }
+        head = &wheel.slots[2][(due >> (2 * JOB_SCHEDULER_WHEEL_BITS)) & WHEEL_MASK];
+    }
+
+    job.next = *head;
+    *head = index;
+}
+
+/**
+ * Redistribui os jobs de uma posição de nível superior. Chamar com o lock.
+ */
+static void cascade(Wheel& wheel, uint8_t level, uint32_t slot) {
+    int8_t index = wheel.slots[level][slot];
+    wheel.slots[level][slot] = -1;
+
+    while (index >= 0) {
+        int8_t next = s_jobs[index].next;
+        place(wheel, index);
+        index = next;
+    }
+}
+
+static void startWheel(Wheel& wheel, uint32_t tick) {
+    for (uint8_t level = 0; level < WHEEL_LEVELS; level++) {
+        for (uint32_t slot = 0; slot < WHEEL_SLOTS; slot++) {
+            wheel.slots[level][slot] = -1;
+        }
+    }
+    wheel.currentTick = tick;
+    wheel.started = true;
+}
+
+int8_t JobScheduler::add(const char* name, uint32_t periodMs, uint32_t phaseMs, uint8_t core,
+                         Handler handler, void* context) {
+    if (!handler || core >= CORE_COUNT) {
+        return INVALID_JOB;
+    }
+
+    uint32_t now = currentTickOf(esp_timer_get_time());
+    int8_t index;
+
+    portENTER_CRITICAL(&s_lock);
+    if (s_count >= JOB_SCHEDULER_MAX_JOBS) {
+        portEXIT_CRITICAL(&s_lock);
+        LOG_ERROR(MODULE_NAME, "Tabela de jobs cheia; '%s' não registrado", name);
+        return INVALID_JOB;
+    }
+
+    Wheel& wheel = s_wheels[core];
+    if (!wheel.started) {
+        startWheel(wheel, now);
+    }
+
+    index = static_cast<int8_t>(s_count);
+    Job& job = s_jobs[index];
+    job.handler = handler;
+    job.context = context;
+    job.periodTicks = (periodMs + JOB_SCHEDULER_TICK_MS - 1) / JOB_SCHEDULER_TICK_MS;
+    if (job.periodTicks == 0) {
+        job.periodTicks = 1;
+    }
+    job.stats = Stats();
+    job.stats.name = name;
+    job.stats.periodMs = job.periodTicks * JOB_SCHEDULER_TICK_MS;
+    job.stats.phaseMs = (phaseMs / JOB_SCHEDULER_TICK_MS % job.periodTicks) * JOB_SCHEDULER_TICK_MS;
+    job.stats.core = core;
+
+    // Primeiro ponto da grade a partir do próximo tick da roda
+    uint32_t from = static_cast<int32_t>(now - wheel.currentTick) > 0 ? now : wheel.currentTick;
+    uint32_t phase = job.stats.phaseMs / JOB_SCHEDULER_TICK_MS;
+    job.dueTick = from + (phase + job.periodTicks - from % job.periodTicks) % job.periodTicks;
+
+    place(wheel, index);
+    s_count++;
+    portEXIT_CRITICAL(&s_lock);
+
+    LOG_DEBUG(MODULE_NAME, "Job '%s': %u ms, fase %u ms, core %u",
+              name, job.stats.periodMs, job.stats.phaseMs, core);
+    return index;
+}
+
+void JobScheduler::run(uint8_t core) {
+    if (core >= CORE_COUNT) {
+        return;
+    }
+
+    Wheel& wheel = s_wheels[core];
+    uint32_t target = currentTickOf(esp_timer_get_time());
+
+    portENTER_CRITICAL(&s_lock);
+    while (wheel.started && static_cast<int32_t>(target - wheel.currentTick) >= 0) {
+        uint32_t tick = wheel.currentTick;
+        uint32_t slot = tick & WHEEL_MASK;
+
+        // Início de volta: desce os jobs da posição atual dos níveis de cima
+        if (slot == 0) {
+            uint32_t slot1 = (tick >> JOB_SCHEDULER_WHEEL_BITS) & WHEEL_MASK;
+            if (slot1 == 0) {
+                cascade(wheel, 2, (tick >> (2 * JOB_SCHEDULER_WHEEL_BITS)) & WHEEL_MASK);
+            }
+            cascade(wheel, 1, slot1);
+        }
+
+        int8_t expired = wheel.slots[0][slot];
+        wheel.slots[0][slot] = -1;
+        wheel.currentTick = tick + 1;
+
+        while (expired >= 0) {
+            int8_t index = expired;
+            Job& job = s_jobs[index];
+            expired = job.next;
+
+            // O handler roda fora do lock; a lista vencida já foi destacada
+            portEXIT_CRITICAL(&s_lock);
+            int64_t start = esp_timer_get_time();
+            job.handler(job.context);
+            int64_t end = esp_timer_get_time();
+            portENTER_CRITICAL(&s_lock);
+
+            uint32_t startTick = currentTickOf(start);
+            uint32_t lateTicks = startTick - job.dueTick;
+            uint32_t lateMicros = lateTicks < UINT32_MAX / TICK_MICROS
+                ? lateTicks * TICK_MICROS + static_cast<uint32_t>(start % TICK_MICROS) : UINT32_MAX;
+            uint32_t runMicros = static_cast<uint32_t>(end - start);
+
+            Stats& stats = job.stats;
+            stats.runs++;
+            stats.lastRunMicros = runMicros;
+            stats.totalRunMicros += runMicros;
+            if (runMicros > stats.maxRunMicros) {
+                stats.maxRunMicros = runMicros;
+            }
+            stats.lastLateMicros = lateMicros;
+            stats.totalLateMicros += lateMicros;
+            if (lateMicros > stats.maxLateMicros) {
+                stats.maxLateMicros = lateMicros;
+            }
+
+            // Próximo vencimento na grade; os que já passaram não são repetidos
+            uint32_t now = currentTickOf(end);
+            uint32_t next = job.dueTick + job.periodTicks;
+            if (static_cast<int32_t>(next - now) <= 0) {
+                uint32_t missed = (now - job.dueTick) / job.periodTicks;
+                stats.skipped += missed;
+                next = job.dueTick + (missed + 1) * job.periodTicks;
+            }
+            job.dueTick = next;
+            place(wheel, index);
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+uint8_t JobScheduler::getCount() {
+    return s_count;
+}
+
+bool JobScheduler::getStats(uint8_t index, Stats& stats) {
+    bool valid;
+
+    portENTER_CRITICAL(&s_lock);
+    valid = index < s_count;
+    if (valid) {
+        stats = s_jobs[index].stats;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    return valid;
+}
+
+void JobScheduler::resetStats() {
+    portENTER_CRITICAL(&s_lock);
+    for (uint8_t i = 0; i < s_count; i++) {
+        Stats& stats = s_jobs[i].stats;
+        Stats cleared = Stats();
+        cleared.name = stats.name;
+        cleared.periodMs = stats.periodMs;
+        cleared.phaseMs = stats.phaseMs;
+        cleared.core = stats.core;
+        stats = cleared;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void JobScheduler::printReport(const char* args) {
+    if (args && strcmp(args, "reset") == 0) {
+        resetStats();
+        ConsoleCommands::printf("Contadores dos jobs zerados\n");
+        return;
+    }
+
+    ConsoleCommands::printf("%-16s %4s %8s %6s %10s %9s %9s %9s %10s %10s\n",
+                            "job", "core", "período", "fase", "execuções", "perdidos",
+                            "exec méd", "exec máx", "atraso méd", "atraso máx");
+
+    Stats stats;
+    for (uint8_t i = 0; getStats(i, stats); i++) {
+        uint32_t meanRun = stats.runs ? static_cast<uint32_t>(stats.totalRunMicros / stats.runs) : 0;
+        uint32_t meanLate = stats.runs ? static_cast<uint32_t>(stats.totalLateMicros / stats.runs) : 0;
+        ConsoleCommands::printf("%-16s %4u %8u %6u %10u %9u %9u %9u %10u %10u\n",
+                                stats.name, stats.core, stats.periodMs, stats.phaseMs,
+                                stats.runs, stats.skipped, meanRun, stats.maxRunMicros,
+                                meanLate, stats.maxLateMicros);
+    }
+}
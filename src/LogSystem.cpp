@@ -5,14 +5,108 @@
 
 #include "LogSystem.h"
 #include "StringUtils.h"
+#include "CrashLog.h"
+#include "ProfileZone.h"
 #include <string.h>
 #include <stdarg.h>
 #include <esp_log.h>  // Para controle de logs do ESP-IDF
 
+// ====================================================================
+// Implementação do LogRateLimiter
+// ====================================================================
+
+// Tokens gastos ocupam os 4 bits baixos do estado; o restante guarda o
+// intervalo de reabastecimento (millis / LOG_RATE_LIMIT_REFILL_MS) do
+// último consumo, truncado
+#define LOG_RATE_SPENT_BITS         4
+#define LOG_RATE_SPENT_MASK         ((1U << LOG_RATE_SPENT_BITS) - 1)
+#define LOG_RATE_PERIOD_MASK        (0xFFFFFFFFU >> LOG_RATE_SPENT_BITS)
+
+static_assert(LOG_RATE_LIMIT_BURST <= LOG_RATE_SPENT_MASK,
+              "LOG_RATE_LIMIT_BURST deve caber nos bits de tokens gastos");
+
+// Pontos de chamada com supressões ainda não relatadas
+static LogRateLimiter* s_pendingLimiters[LOG_RATE_LIMIT_PENDING];
+static uint8_t s_pendingCount = 0;
+static portMUX_TYPE s_pendingLock = portMUX_INITIALIZER_UNLOCKED;
+
+bool LogRateLimiter::allow(uint32_t* suppressedOut, LogLevel callLevel, const char* callModule) {
+    uint32_t period = (millis() / LOG_RATE_LIMIT_REFILL_MS) & LOG_RATE_PERIOD_MASK;
+    uint32_t current = state.load(std::memory_order_relaxed);
+
+    while (true) {
+        // Recupera um token por intervalo decorrido desde o último consumo
+        uint32_t spent = current & LOG_RATE_SPENT_MASK;
+        uint32_t refill = (period - (current >> LOG_RATE_SPENT_BITS)) & LOG_RATE_PERIOD_MASK;
+        spent = refill >= spent ? 0 : spent - refill;
+
+        if (spent >= LOG_RATE_LIMIT_BURST) {
+            suppressed.fetch_add(1, std::memory_order_relaxed);
+
+            // Só a primeira supressão desde o último resumo toca no lock
+            if (!queued.exchange(true, std::memory_order_acq_rel)) {
+                portENTER_CRITICAL(&s_pendingLock);
+                if (s_pendingCount < LOG_RATE_LIMIT_PENDING) {
+                    module = callModule;
+                    level = static_cast<uint8_t>(callLevel);
+                    s_pendingLimiters[s_pendingCount++] = this;
+                } else {
+                    // Fila cheia: tenta de novo na próxima supressão
+                    queued.store(false, std::memory_order_relaxed);
+                }
+                portEXIT_CRITICAL(&s_pendingLock);
+            }
+            return false;
+        }
+
+        uint32_t next = (period << LOG_RATE_SPENT_BITS) | (spent + 1);
+        if (state.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    *suppressedOut = suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+void LogRateLimiter::flushPending(void*) {
+    LogRateLimiter* pending[LOG_RATE_LIMIT_PENDING];
+    uint8_t count;
+
+    portENTER_CRITICAL(&s_pendingLock);
+    count = s_pendingCount;
+    memcpy(pending, s_pendingLimiters, count * sizeof(pending[0]));
+    s_pendingCount = 0;
+    portEXIT_CRITICAL(&s_pendingLock);
+
+    for (uint8_t i = 0; i < count; i++) {
+        LogRateLimiter* limiter = pending[i];
+
+        // Liberado antes da leitura: supressões seguintes voltam à fila
+        limiter->queued.store(false, std::memory_order_release);
+        uint32_t total = limiter->suppressed.exchange(0, std::memory_order_relaxed);
+
+        // Zero se a própria chamada já relatou ao recuperar o bucket
+        if (total > 0) {
+            LOG_EMIT(static_cast<LogLevel>(limiter->level), limiter->module,
+                     "%u mensagens deste ponto suprimidas", (unsigned)total);
+        }
+    }
+}
+
 // ====================================================================
 // Implementação do CircularLogBuffer
 // ====================================================================
 
+// Layout do registro: tamanho (2), timestamp (4), nível (1), módulo (1),
+// mensagem (sem terminador) e tamanho novamente (2)
+#define LOG_RECORD_HEADER           8
+#define LOG_RECORD_OVERHEAD         (LOG_RECORD_HEADER + 2)
+
+static_assert(LOG_RING_BYTES >= 2 * (LOG_RECORD_OVERHEAD + LOG_MAX_MESSAGE_SIZE),
+              "LOG_RING_BYTES deve comportar ao menos duas mensagens de tamanho máximo");
+static_assert(LOG_MODULE_TABLE_SIZE <= 256, "Índice de módulo ocupa um byte");
+
 CircularLogBuffer* CircularLogBuffer::s_instance = nullptr;
 
 CircularLogBuffer& CircularLogBuffer::getInstance() {
@@ -23,110 +117,191 @@ CircularLogBuffer& CircularLogBuffer::getInstance() {
 }
 
 CircularLogBuffer::CircularLogBuffer()
-    : m_head(0) {
-    // Cria mutex para proteção de acesso
-    m_mutex = xSemaphoreCreateMutex();
+    : m_head(0),
+      m_used(0),
+      m_firstSequence(0),
+      m_nextSequence(0),
+      m_lock(portMUX_INITIALIZER_UNLOCKED),
+      m_moduleCount(0),
+      m_moduleLock(portMUX_INITIALIZER_UNLOCKED) {
+}
 
-    // Inicializa o buffer
-    memset(m_entries, 0, sizeof(m_entries));
+void CircularLogBuffer::copyIn(size_t position, const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t first = LOG_RING_BYTES - position;
+    if (first >= length) {
+        memcpy(&m_ring[position], bytes, length);
+    } else {
+        memcpy(&m_ring[position], bytes, first);
+        memcpy(m_ring, bytes + first, length - first);
+    }
 }
 
-CircularLogBuffer::~CircularLogBuffer() {
-    if (m_mutex) {
-        vSemaphoreDelete(m_mutex);
-        m_mutex = nullptr;
+void CircularLogBuffer::copyOut(size_t position, void* data, size_t length) const {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    size_t first = LOG_RING_BYTES - position;
+    if (first >= length) {
+        memcpy(bytes, &m_ring[position], length);
+    } else {
+        memcpy(bytes, &m_ring[position], first);
+        memcpy(bytes + first, m_ring, length - first);
     }
 }
 
-void CircularLogBuffer::addEntry(const LogEntry& entry) {
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        // Copia a entrada para a posição atual
-        m_entries[m_head] = entry;
+uint8_t CircularLogBuffer::internModule(const char* module) {
+    // MODULE_NAME é um literal: o ponteiro acha a entrada em quase todas as
+    // chamadas. Um buffer reaproveitado pode repetir o ponteiro com outro
+    // nome, então o acerto só vale se o nome também confere
+    uint8_t count = m_moduleCount.load(std::memory_order_acquire);
+    for (uint8_t i = 0; i < count; i++) {
+        if (m_moduleKeys[i] == module) {
+            if (strncmp(m_modules[i], module, LOG_MODULE_NAME_MAX_SIZE - 1) == 0) {
+                return i;
+            }
+            break;
+        }
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (strncmp(m_modules[i], module, LOG_MODULE_NAME_MAX_SIZE - 1) == 0) {
+            return i;
+        }
+    }
+
+    if (count == LOG_MODULE_TABLE_SIZE) {
+        return LOG_MODULE_TABLE_SIZE - 1;
+    }
 
-        // Avança o ponteiro de forma circular
-        m_head = (m_head + 1) % LOG_BUFFER_SIZE;
+    // Módulo novo (raro): outro núcleo pode ter registrado o mesmo nome
+    // desde a leitura acima, então a busca é refeita sob o lock da tabela
+    portENTER_CRITICAL(&m_moduleLock);
+    uint8_t index = m_moduleCount.load(std::memory_order_relaxed);
+    for (uint8_t i = count; i < index; i++) {
+        if (strncmp(m_modules[i], module, LOG_MODULE_NAME_MAX_SIZE - 1) == 0) {
+            portEXIT_CRITICAL(&m_moduleLock);
+            return i;
+        }
+    }
 
-        xSemaphoreGive(m_mutex);
+    if (index == LOG_MODULE_TABLE_SIZE) {
+        portEXIT_CRITICAL(&m_moduleLock);
+        return LOG_MODULE_TABLE_SIZE - 1;
     }
+
+    // A última posição agrupa os módulos que não couberam na tabela
+    StringUtils::safeCopyString(m_modules[index],
+        index == LOG_MODULE_TABLE_SIZE - 1 ? "outros" : module,
+        LOG_MODULE_NAME_MAX_SIZE);
+    m_moduleKeys[index] = index == LOG_MODULE_TABLE_SIZE - 1 ? nullptr : module;
+    m_moduleCount.store(index + 1, std::memory_order_release);
+    portEXIT_CRITICAL(&m_moduleLock);
+
+    return index;
 }
 
-size_t CircularLogBuffer::getEntries(char* buffer, size_t maxSize) {
-    if (!buffer || maxSize == 0) {
-        return 0;
+void CircularLogBuffer::addEntry(LogLevel level, const char* module, const char* message) {
+    // Monta cabeçalho e rodapé fora da seção crítica
+    uint16_t messageLength = strnlen(message, LOG_MAX_MESSAGE_SIZE - 1);
+    uint16_t recordLength = LOG_RECORD_OVERHEAD + messageLength;
+    uint32_t timestamp = millis();
+
+    uint8_t header[LOG_RECORD_HEADER];
+    memcpy(&header[0], &recordLength, sizeof(recordLength));
+    memcpy(&header[2], &timestamp, sizeof(timestamp));
+    header[6] = static_cast<uint8_t>(level);
+    header[7] = internModule(module);
+
+    portENTER_CRITICAL(&m_lock);
+
+    // Descarta os registros mais antigos até caber
+    while (LOG_RING_BYTES - m_used < recordLength) {
+        size_t tail = (m_head + LOG_RING_BYTES - m_used) % LOG_RING_BYTES;
+        uint16_t oldLength;
+        copyOut(tail, &oldLength, sizeof(oldLength));
+        m_used -= oldLength;
+        m_firstSequence++;
     }
 
-    size_t totalWritten = 0;
+    copyIn(m_head, header, sizeof(header));
+    copyIn((m_head + LOG_RECORD_HEADER) % LOG_RING_BYTES, message, messageLength);
+    copyIn((m_head + recordLength - 2) % LOG_RING_BYTES, &recordLength, sizeof(recordLength));
 
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        // Determina o tamanho necessário para formatar cada entrada
-        const size_t entrySizeEstimate = 128;
+    m_head = (m_head + recordLength) % LOG_RING_BYTES;
+    m_used += recordLength;
+    m_nextSequence++;
 
-        // Estima o número de entradas que cabem no buffer
-        size_t maxEntries = maxSize / entrySizeEstimate;
-        if (maxEntries > LOG_BUFFER_SIZE) {
-            maxEntries = LOG_BUFFER_SIZE;
-        }
+    portEXIT_CRITICAL(&m_lock);
+}
 
-        // Escreve o cabeçalho
-        int written = snprintf(buffer, maxSize,
-            "=== Log de Sistema (últimas %u mensagens) ===\n\n",
-            (uint32_t)maxEntries);
+CircularLogBuffer::Iterator CircularLogBuffer::newest() {
+    portENTER_CRITICAL(&m_lock);
+    Iterator iterator(*this, m_head, m_nextSequence);
+    portEXIT_CRITICAL(&m_lock);
+    return iterator;
+}
 
-        if (written > 0) {
-            totalWritten += written;
-        }
+bool CircularLogBuffer::Iterator::next(Record& record) {
+    CircularLogBuffer& ring = m_buffer;
+    bool valid = false;
 
-        // Índice inicial para leitura (mais recente primeiro)
-        size_t index = (m_head == 0) ? LOG_BUFFER_SIZE - 1 : (m_head - 1);
-
-        // Lê as entradas em ordem reversa (mais recente primeiro)
-        for (size_t i = 0; i < maxEntries; i++) {
-            const LogEntry& entry = m_entries[index];
-
-            // Verifica se a entrada é válida (timestamp > 0)
-            if (entry.timestamp > 0) {
-                // Formata a timestamp como segundos.milissegundos
-                uint32_t seconds = entry.timestamp / 1000;
-                uint32_t milliseconds = entry.timestamp % 1000;
-
-                // Formata a mensagem
-                written = snprintf(buffer + totalWritten, maxSize - totalWritten,
-                    "[%5u.%03u][%-5s][%-10s] %s\n",
-                    seconds, milliseconds,
-                    LogRouter::getInstance().levelToString(entry.level),
-                    entry.module,
-                    entry.message);
-
-                if (written > 0 && totalWritten + written < maxSize) {
-                    totalWritten += written;
-                } else {
-                    // Buffer cheio, adiciona indicador e sai
-                    const char* truncated = "... (truncado)\n";
-                    size_t truncatedLen = strlen(truncated);
+    portENTER_CRITICAL(&ring.m_lock);
 
-                    if (totalWritten + truncatedLen < maxSize) {
-                        strcpy(buffer + totalWritten, truncated);
-                        totalWritten += truncatedLen;
-                    }
-                    break;
-                }
-            }
+    // O registro anterior ainda existe se sua sequência não foi descartada
+    if (static_cast<int32_t>(m_sequence - 1 - ring.m_firstSequence) >= 0) {
+        uint16_t recordLength;
+        ring.copyOut((m_end + LOG_RING_BYTES - 2) % LOG_RING_BYTES, &recordLength, sizeof(recordLength));
 
-            // Move para a entrada anterior de forma circular
-            index = (index == 0) ? LOG_BUFFER_SIZE - 1 : (index - 1);
-        }
+        size_t start = (m_end + LOG_RING_BYTES - recordLength) % LOG_RING_BYTES;
+        uint8_t header[LOG_RECORD_HEADER];
+        ring.copyOut(start, header, sizeof(header));
+
+        record.length = recordLength - LOG_RECORD_OVERHEAD;
+        memcpy(&record.timestamp, &header[2], sizeof(record.timestamp));
+        record.level = static_cast<LogLevel>(header[6]);
+        record.module = ring.m_modules[header[7]];
+        ring.copyOut((start + LOG_RECORD_HEADER) % LOG_RING_BYTES, record.message, record.length);
+        record.message[record.length] = '\0';
 
-        xSemaphoreGive(m_mutex);
+        m_end = start;
+        m_sequence--;
+        valid = true;
     }
 
-    // Garante terminação null
-    if (totalWritten < maxSize) {
-        buffer[totalWritten] = '\0';
-    } else if (maxSize > 0) {
-        buffer[maxSize - 1] = '\0';
+    portEXIT_CRITICAL(&ring.m_lock);
+
+    return valid;
+}
+
+size_t CircularLogBuffer::getCount() {
+    portENTER_CRITICAL(&m_lock);
+    size_t count = m_nextSequence - m_firstSequence;
+    portEXIT_CRITICAL(&m_lock);
+    return count;
+}
+
+// snprintf retorna o tamanho que o texto teria; limita ao que foi escrito
+static size_t writtenLength(int written, size_t maxSize) {
+    if (written <= 0 || maxSize == 0) {
+        return 0;
     }
+    return static_cast<size_t>(written) < maxSize ? written : maxSize - 1;
+}
 
-    return totalWritten;
+size_t CircularLogBuffer::formatHeader(char* buffer, size_t maxSize) {
+    int written = snprintf(buffer, maxSize,
+        "=== Log de Sistema (últimas %u mensagens) ===\n\n",
+        (uint32_t)getCount());
+    return writtenLength(written, maxSize);
+}
+
+size_t CircularLogBuffer::formatRecord(const Record& record, char* buffer, size_t maxSize) {
+    // Formata a timestamp como segundos.milissegundos
+    int written = snprintf(buffer, maxSize,
+        "[%5u.%03u][%-5s][%-10s] %s\n",
+        record.timestamp / 1000, record.timestamp % 1000,
+        LogRouter::getInstance().levelToString(record.level),
+        record.module,
+        record.message);
+    return writtenLength(written, maxSize);
 }
 
 // ====================================================================
@@ -143,9 +318,9 @@ TelemetryManager& TelemetryManager::getInstance() {
 }
 
 TelemetryManager::TelemetryManager()
-    : m_nextToken(1) {
+    : m_nextToken(1), m_mutex("telemetry.sessions") {
     // Cria mutex para proteção de acesso
-    m_mutex = xSemaphoreCreateMutex();
+    m_mutex.create();
 
     // Inicializa sessões
     for (int i = 0; i < MAX_TELEMETRY_SESSIONS; i++) {
@@ -155,10 +330,7 @@ TelemetryManager::TelemetryManager()
 }
 
 TelemetryManager::~TelemetryManager() {
-    if (m_mutex) {
-        vSemaphoreDelete(m_mutex);
-        m_mutex = nullptr;
-    }
+    m_mutex.destroy();
 }
 
 uint32_t TelemetryManager::beginSession(const char* name) {
@@ -168,7 +340,7 @@ uint32_t TelemetryManager::beginSession(const char* name) {
 
     uint32_t newToken = 0;
 
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    if (m_mutex.take(pdMS_TO_TICKS(100))) {
         // Procura por um slot livre
         for (int i = 0; i < MAX_TELEMETRY_SESSIONS; i++) {
             if (!m_sessions[i].active) {
@@ -185,7 +357,7 @@ uint32_t TelemetryManager::beginSession(const char* name) {
             }
         }
 
-        xSemaphoreGive(m_mutex);
+        m_mutex.give();
     }
 
     return newToken;
@@ -258,7 +430,7 @@ bool TelemetryManager::endSession(uint32_t token) {
     bool result = false;
     int sessionIndex = -1;
 
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    if (m_mutex.take(pdMS_TO_TICKS(100))) {
         // Procura pela sessão com o token especificado
         for (int i = 0; i < MAX_TELEMETRY_SESSIONS; i++) {
             if (m_sessions[i].active && m_sessions[i].token == token) {
@@ -274,7 +446,7 @@ bool TelemetryManager::endSession(uint32_t token) {
             }
         }
 
-        xSemaphoreGive(m_mutex);
+        m_mutex.give();
     }
 
     // Se encontrou a sessão, libera sua linha reservada
@@ -296,7 +468,7 @@ bool TelemetryManager::endSession(uint32_t token) {
 TelemetrySession* TelemetryManager::findSession(uint32_t token) {
     TelemetrySession* result = nullptr;
 
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+    if (m_mutex.take(pdMS_TO_TICKS(100))) {
         // Procura pela sessão com o token especificado
         for (int i = 0; i < MAX_TELEMETRY_SESSIONS; i++) {
             if (m_sessions[i].active && m_sessions[i].token == token) {
@@ -305,7 +477,7 @@ TelemetrySession* TelemetryManager::findSession(uint32_t token) {
             }
         }
 
-        xSemaphoreGive(m_mutex);
+        m_mutex.give();
     }
 
     return result;
@@ -345,6 +517,8 @@ LogRouter::~LogRouter() {
 }
 
 void LogRouter::log(LogLevel level, const char* module, const char* fmt, ...) {
+    PROFILE_ZONE("log.route");
+
     // Verifica se o nível de log deve ser processado
     bool shouldOutputToSerial = static_cast<int>(level) >= static_cast<int>(LOG_LEVEL_SERIAL);
     bool shouldStoreInMemory = static_cast<int>(level) >= static_cast<int>(LOG_LEVEL_MEMORY);
@@ -373,6 +547,11 @@ void LogRouter::log(LogLevel level, const char* module, const char* fmt, ...) {
     // Garante terminação da string
     buffer[LOG_MAX_MESSAGE_SIZE - 1] = '\0';
 
+    // Cópia persistente em RTC RAM para análise após reset
+    if (static_cast<int>(level) >= static_cast<int>(CRASH_LOG_LEVEL)) {
+        CrashLog::append(level, moduleName, buffer);
+    }
+
     // Saída para console se configurado
     if (shouldOutputToSerial) {
         // Mapeia para prioridade do ConsoleManager
@@ -387,26 +566,44 @@ void LogRouter::log(LogLevel level, const char* module, const char* fmt, ...) {
         ConsoleManager::getInstance().println(consoleMessage, priority);
     }
 
-    // Armazena em buffer circular se configurado
+    // Armazena em buffer circular se configurado; o anel recebe o literal
+    // original (não a cópia na pilha), que é a chave da tabela de módulos
     if (shouldStoreInMemory) {
-        // Cria entrada de log
-        LogEntry entry;
-        entry.timestamp = millis();
-        entry.level = level;
+        storeEntry(level, (module && module[0]) ? module : "SYS", buffer);
+    }
+}
+
+void LogRouter::store(LogLevel level, const char* module, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    storeV(level, module, fmt, args);
+    va_end(args);
+}
 
-        // Copia nome do módulo de forma segura e otimizada
-        StringUtils::safeCopyString(entry.module, moduleName, sizeof(entry.module));
+void LogRouter::storeV(LogLevel level, const char* module, const char* fmt, va_list args) {
+    if (static_cast<int>(level) < static_cast<int>(LOG_LEVEL_MEMORY)) {
+        return;
+    }
+
+    // Formata a mensagem
+    char buffer[LOG_MAX_MESSAGE_SIZE];
+    vsnprintf(buffer, sizeof(buffer) - 1, fmt, args);
 
-        // Copia mensagem de forma segura e otimizada
-        StringUtils::safeCopyString(entry.message, buffer, sizeof(entry.message));
+    // Garante terminação da string
+    buffer[LOG_MAX_MESSAGE_SIZE - 1] = '\0';
 
-        // Adiciona ao buffer circular
-        CircularLogBuffer::getInstance().addEntry(entry);
+    const char* moduleName = (module && strlen(module) > 0) ? module : "SYS";
+
+    if (static_cast<int>(level) >= static_cast<int>(CRASH_LOG_LEVEL)) {
+        CrashLog::append(level, moduleName, buffer);
     }
+
+    storeEntry(level, moduleName, buffer);
 }
 
-size_t LogRouter::getStoredLogs(char* buffer, size_t maxSize) {
-    return CircularLogBuffer::getInstance().getEntries(buffer, maxSize);
+void LogRouter::storeEntry(LogLevel level, const char* module, const char* message) {
+    // O anel copia apenas os bytes da mensagem e interna o nome do módulo
+    CircularLogBuffer::getInstance().addEntry(level, module, message);
 }
 
 uint32_t LogRouter::beginTelemetry(const char* name) {
@@ -0,0 +1,171 @@
+/**
+ * @file LoopTimingMonitor.cpp
+ * @brief Implementação do monitoramento de pontualidade das tarefas.
+ */
+
+#include "LoopTimingMonitor.h"
+#include "ConsoleCommands.h"
+#include <esp_timer.h>
+
+const uint32_t LoopTimingMonitor::HISTOGRAM_BOUNDS[HISTOGRAM_BUCKETS - 1] = {
+    50, 100, 250, 500, 1000, 2500, 5000
+};
+
+/**
+ * Referência de tempo e contadores de uma tarefa. Só a própria tarefa
+ * escreve; as leituras de outras tarefas passam pelo lock.
+ */
+struct LoopState {
+    TickType_t baseTick;
+    int64_t baseMicros;
+    bool started;
+    bool anchored;          // baseMicros já tomado de um despertar
+    LoopTimingMonitor::Stats stats;
+};
+
+static LoopState s_loops[LoopTimingMonitor::LOOP_COUNT] = {};
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void recordLate(LoopState& state, uint32_t lateMicros) {
+    uint8_t bucket = 0;
+    while (bucket < LoopTimingMonitor::HISTOGRAM_BUCKETS - 1 &&
+           lateMicros >= LoopTimingMonitor::HISTOGRAM_BOUNDS[bucket]) {
+        bucket++;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    LoopTimingMonitor::Stats& stats = state.stats;
+    stats.wakes++;
+    stats.lastLateMicros = lateMicros;
+    if (lateMicros > stats.maxLateMicros) {
+        stats.maxLateMicros = lateMicros;
+    }
+    if (lateMicros > stats.windowMaxLateMicros) {
+        stats.windowMaxLateMicros = lateMicros;
+    }
+    stats.histogram[bucket]++;
+
+    if (lateMicros >= LOOP_TIMING_MISS_US) {
+        stats.overruns++;
+        stats.missStreak++;
+        if (stats.missStreak > stats.maxMissStreak) {
+            stats.maxMissStreak = stats.missStreak;
+        }
+    } else {
+        stats.missStreak = 0;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void LoopTimingMonitor::begin(Loop loop, TickType_t startTick) {
+    if (loop >= LOOP_COUNT) {
+        return;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    s_loops[loop].baseTick = startTick;
+    s_loops[loop].baseMicros = 0;
+    s_loops[loop].started = true;
+    s_loops[loop].anchored = false;
+    s_loops[loop].stats = {};
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void LoopTimingMonitor::onWake(Loop loop, TickType_t expectedTick) {
+    int64_t now = esp_timer_get_time();
+
+    if (loop >= LOOP_COUNT || !s_loops[loop].started) {
+        return;
+    }
+
+    LoopState& state = s_loops[loop];
+
+    // Distância em µs desde o tick de referência; a diferença de ticks é
+    // tomada sem sinal para sobreviver ao estouro do contador
+    int64_t offset = static_cast<int64_t>(static_cast<TickType_t>(expectedTick - state.baseTick)) *
+        portTICK_PERIOD_MS * 1000;
+
+    // O instante de begin() cai em qualquer ponto do tick, o que deslocaria
+    // todas as medições em até um tick. A referência vem do primeiro
+    // despertar, que é descartado por não ter com o que ser comparado
+    if (!state.anchored) {
+        state.baseMicros = now - offset;
+        state.anchored = true;
+        return;
+    }
+
+    int64_t late = now - (state.baseMicros + offset);
+    if (late < 0) {
+        // Acordou antes do previsto: o primeiro despertar já estava atrasado
+        state.baseMicros += late;
+        late = 0;
+    }
+    uint32_t lateMicros = late > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(late);
+
+    recordLate(state, lateMicros);
+}
+
+void LoopTimingMonitor::onSignal(Loop loop, uint32_t signaledMicros) {
+    uint32_t now = static_cast<uint32_t>(esp_timer_get_time());
+
+    if (loop >= LOOP_COUNT || !s_loops[loop].started) {
+        return;
+    }
+
+    // Diferença sem sinal: sobrevive ao estouro dos 32 bits
+    recordLate(s_loops[loop], now - signaledMicros);
+}
+
+LoopTimingMonitor::Stats LoopTimingMonitor::getStats(Loop loop) {
+    if (loop >= LOOP_COUNT) {
+        return Stats();
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    Stats stats = s_loops[loop].stats;
+    portEXIT_CRITICAL(&s_lock);
+    return stats;
+}
+
+uint32_t LoopTimingMonitor::takeWindowMax(Loop loop) {
+    if (loop >= LOOP_COUNT) {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    uint32_t windowMax = s_loops[loop].stats.windowMaxLateMicros;
+    s_loops[loop].stats.windowMaxLateMicros = 0;
+    portEXIT_CRITICAL(&s_lock);
+    return windowMax;
+}
+
+const char* LoopTimingMonitor::getName(Loop loop) {
+    switch (loop) {
+        case SENSOR_LOOP: return "sensores";
+        case WEB_LOOP:    return "web";
+        default:          return "?";
+    }
+}
+
+void LoopTimingMonitor::printReport(const char*) {
+    for (uint8_t i = 0; i < LOOP_COUNT; i++) {
+        Loop loop = static_cast<Loop>(i);
+        Stats stats = getStats(loop);
+
+        ConsoleCommands::printf("Tarefa %s: %u despertares, atraso máx %u µs, %u prazos perdidos, "
+                                "sequência atual %u, máx %u\n",
+                                getName(loop), stats.wakes, stats.maxLateMicros, stats.overruns,
+                                stats.missStreak, stats.maxMissStreak);
+
+        uint32_t lower = 0;
+        for (uint8_t b = 0; b < HISTOGRAM_BUCKETS; b++) {
+            if (b < HISTOGRAM_BUCKETS - 1) {
+                ConsoleCommands::printf("  %5u-%-5u µs %10u\n", lower, HISTOGRAM_BOUNDS[b] - 1,
+                                        stats.histogram[b]);
+                lower = HISTOGRAM_BOUNDS[b];
+            } else {
+                ConsoleCommands::printf("  %5u+      µs %10u\n", lower, stats.histogram[b]);
+            }
+        }
+    }
+}
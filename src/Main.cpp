@@ -16,6 +16,17 @@
 #include "WifiPerformance.h"
 #include "LogSystem.h"
 #include "OutputManager.h"
+#include "CrashLog.h"
+#include "ConsoleWriter.h"
+#include "AllocationGuard.h"
+#include "HeapIntegrityChecker.h"
+#include "ConsoleCommands.h"
+#include "ProfileZone.h"
+#include "LoopTimingMonitor.h"
+#include "TraceRecorder.h"
+#include "InstrumentedMutex.h"
+#include "JobScheduler.h"
+#include <esp_timer.h>
 
 // Define o nome do módulo para logging
 #define MODULE_NAME "Main"
@@ -29,7 +40,10 @@ TaskHandle_t g_sensorTask = nullptr;
 TaskHandle_t g_webTask = nullptr;
 
 // Semáforos para sincronização
-SemaphoreHandle_t g_sensorMutex = nullptr;
+InstrumentedMutex g_sensorMutex("sensor");
+
+// Instante (µs, 32 bits baixos) da última notificação de dados novos à tarefa web
+volatile uint32_t g_sensorPublishMicros = 0;
 
 // Semáforo para sincronização de WiFi
 SemaphoreHandle_t g_wifiConnectedSemaphore = nullptr;
@@ -43,6 +57,8 @@ SemaphoreHandle_t g_wifiConnectedSemaphore = nullptr;
 void wifiEventHandler(WiFiEvent_t event, WiFiEventInfo_t info) {
     static bool semaphoreDone = false;
 
+    TRACE_INSTANT("wifi.main", event);
+
     // Previne sinalização múltipla do semáforo
     if (semaphoreDone) {
         return;
@@ -95,27 +111,44 @@ void wifiEventHandler(WiFiEvent_t event, WiFiEventInfo_t info) {
  * @param pvParameters Parâmetros da tarefa (não utilizados).
  */
 void sensorTaskFunc(void *pvParameters) {
-    const TickType_t xFrequency = pdMS_TO_TICKS(10); // 100Hz
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    const TickType_t xFrequency = pdMS_TO_TICKS(TASK_LOOP_PERIOD_MS); // 100Hz
 
     LOG_DEBUG(MODULE_NAME, "Tarefa de sensores iniciada (Core %d)", xPortGetCoreID());
 
     // Espera para garantir que todas as inicializações foram concluídas
     vTaskDelay(pdMS_TO_TICKS(200));
 
+    // A referência é tomada após a espera inicial; antes dela, vTaskDelayUntil
+    // tentaria recuperar os 200 ms com ciclos sem intervalo
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    LoopTimingMonitor::begin(LoopTimingMonitor::SENSOR_LOOP, xLastWakeTime);
+
     while (true) {
-        // Atualiza sensores
-        if (g_sensorMutex != nullptr &&
-            xSemaphoreTake(g_sensorMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-            g_sensorManager->update();
-            xSemaphoreGive(g_sensorMutex);
-        }
+        {
+            // Um ciclo de sensores não deve alocar no heap
+            ALLOC_GUARD_SCOPE();
+            TRACE_SCOPE("sensor.cycle");
+
+            // Atualiza sensores
+            bool published = false;
+            if (g_sensorMutex.take(pdMS_TO_TICKS(50))) {
+                published = g_sensorManager->update();
+                g_sensorMutex.give();
+            }
 
-        // Atualiza monitor do sistema
-        SystemMonitor::getInstance().update();
+            // Acorda a tarefa web somente quando há dados novos
+            if (published && g_webTask != nullptr) {
+                g_sensorPublishMicros = static_cast<uint32_t>(esp_timer_get_time());
+                xTaskNotifyGive(g_webTask);
+            }
+
+            // Watchdog e estatísticas de memória (SystemMonitor::init)
+            JobScheduler::run(TASK_SENSOR_CORE);
+        }
 
         // Executa no intervalo definido (preciso)
         vTaskDelayUntil(&xLastWakeTime, xFrequency);
+        LoopTimingMonitor::onWake(LoopTimingMonitor::SENSOR_LOOP, xLastWakeTime);
 
         #if defined(WOKWI_ENV) || defined(WOKWI)
             // No Wokwi, adicionamos um pequeno delay adicional para
@@ -125,47 +158,59 @@ void sensorTaskFunc(void *pvParameters) {
     }
 }
 
+/**
+ * Job "wifi.check": verifica a conexão WiFi na tarefa web.
+ */
+void wifiCheckJob(void*) {
+    WiFiManager::getInstance().update();
+}
+
+/**
+ * Job "memory.report": relatório completo de memória (DEBUG_MEMORY).
+ */
+void memoryReportJob(void*) {
+    MemoryManager::getInstance().printStats();
+}
+
 /**
  * Tarefa responsável pela interface web.
  *
- * Executa no core 1 para não interferir com a leitura dos sensores.
+ * Executa no core 1 para não interferir com a leitura dos sensores. Dorme
+ * até a tarefa de sensores notificar dados novos; o timeout mantém o
+ * console e a manutenção em dia quando não há notificações.
  *
  * @param pvParameters Parâmetros da tarefa (não utilizados).
  */
 void webTaskFunc(void *pvParameters) {
-    const TickType_t xFrequency = pdMS_TO_TICKS(10); // 100Hz
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    uint32_t counter = 0;
-
     LOG_DEBUG(MODULE_NAME, "Tarefa web iniciada (Core %d)", xPortGetCoreID());
 
     // Espera para garantir que todas as inicializações foram concluídas
     vTaskDelay(pdMS_TO_TICKS(500));
 
+    // Notificações enviadas durante a espera inicial não contam atraso
+    ulTaskNotifyTake(pdTRUE, 0);
+    LoopTimingMonitor::begin(LoopTimingMonitor::WEB_LOOP, xTaskGetTickCount());
+
     while (true) {
-        // Atualiza interface web
-        if (g_sensorMutex != nullptr &&
-            xSemaphoreTake(g_sensorMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-            g_webServer->update();
-            xSemaphoreGive(g_sensorMutex);
-        }
+        bool notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WEB_TASK_IDLE_TIMEOUT_MS)) > 0;
 
-        // Verifica conexão WiFi periodicamente
-        if (counter % 100 == 0) { // A cada 1 segundo
-            WiFiManager::getInstance().update();
-        }
+        TRACE_SCOPE("web.cycle");
 
-        // Imprime estatísticas de memória a cada 10 segundos
-        if (counter % 1000 == 0) { // A cada 10 segundos
-            if (DEBUG_MEMORY) {
-                MemoryManager::getInstance().printStats();
+        // Atualiza interface web com os dados recém-publicados
+        if (notified) {
+            LoopTimingMonitor::onSignal(LoopTimingMonitor::WEB_LOOP, g_sensorPublishMicros);
+
+            if (g_sensorMutex.take(pdMS_TO_TICKS(50))) {
+                g_webServer->update();
+                g_sensorMutex.give();
             }
         }
 
-        counter++;
+        // Executa comandos recebidos pela serial
+        ConsoleCommands::poll();
 
-        // Executa no intervalo definido (preciso)
-        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+        // Verificação do WiFi, limpeza de clientes e relatório de memória
+        JobScheduler::run(TASK_WEB_CORE);
 
         #if defined(WOKWI_ENV) || defined(WOKWI)
             // No Wokwi, adicionamos um pequeno delay adicional para
@@ -205,10 +250,18 @@ bool waitForWiFiConnection(uint32_t timeout_ms) {
 }
 
 void setup() {
-    // Inicializa a comunicação serial
-    Serial.begin(SERIAL_BAUD_RATE);
+    // Recupera o log do boot anterior antes que novos registros o sobrescrevam
+    CrashLog::init();
+
+    // Inicializa a comunicação serial com anel de transmissão não bloqueante
+    ConsoleWriter::begin(SERIAL_BAUD_RATE);
     delay(500); // Pequeno delay para estabilização
 
+    // No modo diferido, os logs saem como quadros binários drenados por uma tarefa própria
+    #if LOG_DEFERRED_MODE
+        DeferredLog::begin();
+    #endif
+
     // Inicialização do sistema de logging já realizada pelo include
 
     // Banner de inicialização
@@ -216,6 +269,11 @@ void setup() {
     LOG_INFO(MODULE_NAME, "Sistema de Monitoramento do Solo v%s", FIRMWARE_VERSION);
     LOG_INFO(MODULE_NAME, "===========================================");
 
+    if (CrashLog::hasPreviousLog()) {
+        LOG_WARN(MODULE_NAME, "Log do boot anterior recuperado: %u mensagens (reset: %s) - veja /logs?boot=previous",
+                 CrashLog::getPreviousCount(), CrashLog::getResetReasonString());
+    }
+
     // Delay para estabilização da saída serial
     delay(100);
 
@@ -241,12 +299,23 @@ void setup() {
     // 1. Primeiramente os serviços de sistema
     SystemMonitor::getInstance().init();
     MemoryManager::getInstance().init();
+    HeapIntegrityChecker::begin();
     OutputManager::initialize();
     OutputManager::attachConsoleManager(&ConsoleManager::getInstance());
 
+    ConsoleCommands::registerCommand("loops", "Pontualidade das tarefas de sensores e web",
+                                     LoopTimingMonitor::printReport);
+    ConsoleCommands::registerCommand("locks", "Contenção dos mutexes; 'locks reset' zera",
+                                     InstrumentedMutex::printReport);
+    ConsoleCommands::registerCommand("jobs", "Execução e atraso dos jobs periódicos; 'jobs reset' zera",
+                                     JobScheduler::printReport);
+    #if PROFILE_ZONES_ENABLED
+        ConsoleCommands::registerCommand("profile", "Latências das zonas (p50/p99/max); 'profile reset' zera",
+                                         ProfileZone::printReport);
+    #endif
+
     // 2. Cria semáforos antes de qualquer coisa que dependa deles
-    g_sensorMutex = xSemaphoreCreateMutex();
-    if (g_sensorMutex == nullptr) {
+    if (!g_sensorMutex.create()) {
         LOG_FATAL(MODULE_NAME, "ERRO: Falha ao criar semáforo de sensores!");
         while (true) {
             delay(1000);
@@ -379,6 +448,16 @@ void setup() {
     // 7. Pequeno delay para estabilização antes de criar tarefas
     delay(300);
 
+    // Jobs periódicos da tarefa web
+    JobScheduler::add("wifi.check", WIFI_CHECK_INTERVAL_MS, 0, TASK_WEB_CORE, wifiCheckJob);
+    if (LOG_RATE_LIMIT_ENABLED) {
+        JobScheduler::add("log.suppressed", LOG_RATE_LIMIT_FLUSH_MS, 750, TASK_WEB_CORE,
+                          LogRateLimiter::flushPending);
+    }
+    if (DEBUG_MEMORY) {
+        JobScheduler::add("memory.report", MEMORY_STATS_INTERVAL_MS, 250, TASK_WEB_CORE, memoryReportJob);
+    }
+
     // 8. Finalmente, cria tarefas FreeRTOS com tamanhos de stack adequados
     #if defined(WOKWI_ENV) || defined(WOKWI)
         // Stacks maiores para o simulador Wokwi
@@ -431,6 +510,9 @@ void setup() {
     LOG_INFO(MODULE_NAME, "===========================================");
     LOG_INFO(MODULE_NAME, "Sistema inicializado com sucesso!");
     LOG_INFO(MODULE_NAME, "===========================================");
+
+    // A partir daqui os caminhos críticos devem operar sem alocar no heap
+    AllocationGuard::markBootComplete();
 }
 
 void loop() {
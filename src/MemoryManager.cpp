@@ -5,6 +5,11 @@
 
 #include "MemoryManager.h"
 #include "LogSystem.h"
+#include "RequestArena.h"
+#include "HeapProfiler.h"
+#include "AllocationGuard.h"
+#include "HeapIntegrityChecker.h"
+#include "LoopTimingMonitor.h"
 #include <esp_heap_caps.h>
 
 // Nome do módulo para logs
@@ -13,8 +18,7 @@
 // Inicializa o ponteiro da instância singleton como null
 MemoryManager *MemoryManager::s_instance = nullptr;
 
-MemoryManager::MemoryManager()
-    : m_lastCheckTime(0), m_jsonBufferInUse(false) {
+MemoryManager::MemoryManager() {
     // Inicializa as estatísticas de memória
     updateStats();
 
@@ -36,19 +40,12 @@ bool MemoryManager::init() {
     // Inicialização das estruturas de memória
     updateStats(); // Atualiza estatísticas iniciais
 
-    // Limpa o buffer JSON
-    memset(m_jsonBuffer, 0, JSON_BUFFER_SIZE);
-    m_jsonBufferInUse = false;
-
-    // Inicializa os pools
-    for (uint8_t i = 0; i < SensorDataPool::POOL_SIZE; i++) {
-        m_sensorDataPool.inUse[i] = false;
-    }
-
+    // Os pools são inicializados na construção e não podem ser reiniciados
+    // aqui, pois objetos podem já ter sido adquiridos por outras tarefas
     LOG_INFO(MODULE_NAME, "Pool de SensorData: %u slots configurados",
-                 SensorDataPool::POOL_SIZE);
-    LOG_INFO(MODULE_NAME, "Buffer JSON: %u bytes alocados",
-                 JSON_BUFFER_SIZE);
+                 SENSOR_DATA_POOL_SIZE);
+    LOG_INFO(MODULE_NAME, "Buffers JSON: %u x %u bytes alocados",
+                 JSON_BUFFER_POOL_SIZE, JSON_BUFFER_SIZE);
     LOG_INFO(MODULE_NAME, "Heap livre inicial: %u bytes",
                  m_stats.freeHeap);
 
@@ -56,81 +53,78 @@ bool MemoryManager::init() {
 }
 
 SensorData *MemoryManager::acquireSensorData() {
-    // Procura um slot livre no pool
-    for (uint8_t i = 0; i < SensorDataPool::POOL_SIZE; i++) {
-        if (!m_sensorDataPool.inUse[i]) {
-            m_sensorDataPool.inUse[i] = true;
-            // Reseta o objeto antes de retorná-lo
-            m_sensorDataPool.items[i] = SensorData();
-
-            if (DEBUG_MEMORY) {
-                LOG_DEBUG(MODULE_NAME, "SensorData adquirido (slot %u)", i);
-            }
-            return &m_sensorDataPool.items[i];
-        }
+    // Retira um slot livre do pool, já construído com valores padrão
+    SensorData *data = m_sensorDataPool.acquire();
+
+    if (data == nullptr) {
+        LOG_ERROR(MODULE_NAME, "Pool de SensorData esgotado");
+        return nullptr;
     }
 
-    // Se não encontrou slot livre, retorna nullptr
-    LOG_ERROR(MODULE_NAME, "Pool de SensorData esgotado");
-    return nullptr;
+    if (DEBUG_MEMORY) {
+        LOG_DEBUG(MODULE_NAME, "SensorData adquirido (%u em uso)",
+                  m_sensorDataPool.getStats().inUse);
+    }
+    return data;
 }
 
 bool MemoryManager::releaseSensorData(SensorData *data) {
-    // Verifica se o ponteiro é válido e pertence ao pool
     if (data == nullptr) return false;
 
-    for (uint8_t i = 0; i < SensorDataPool::POOL_SIZE; i++) {
-        if (data == &m_sensorDataPool.items[i]) {
-            m_sensorDataPool.inUse[i] = false;
-            if (DEBUG_MEMORY) {
-                LOG_DEBUG(MODULE_NAME, "SensorData liberado (slot %u)", i);
-            }
-            return true;
-        }
+    // Verifica se o ponteiro pertence ao pool (e, em depuração, se não foi liberado antes)
+    if (!m_sensorDataPool.release(data)) {
+        LOG_ERROR(MODULE_NAME, "SensorData não pertence ao pool ou já foi liberado");
+        return false;
     }
 
-    // Se chegou aqui, o ponteiro não pertence ao pool
-    LOG_ERROR(MODULE_NAME, "SensorData não pertence ao pool");
-    return false;
+    if (DEBUG_MEMORY) {
+        LOG_DEBUG(MODULE_NAME, "SensorData liberado (%u em uso)",
+                  m_sensorDataPool.getStats().inUse);
+    }
+    return true;
 }
 
 char* MemoryManager::acquireJsonBuffer() {
-    if (m_jsonBufferInUse) {
-        LOG_WARN(MODULE_NAME, "Buffer JSON já em uso");
+    JsonBuffer *buffer = m_jsonBufferPool.acquire();
+    if (buffer == nullptr) {
+        LOG_WARN(MODULE_NAME, "Buffers JSON esgotados");
         return nullptr;
     }
 
-    m_jsonBufferInUse = true;
     // Limpa o buffer antes de retorná-lo
-    memset(m_jsonBuffer, 0, JSON_BUFFER_SIZE);
+    memset(buffer->data, 0, JSON_BUFFER_SIZE);
 
     if (DEBUG_MEMORY) {
         LOG_DEBUG(MODULE_NAME, "Buffer JSON adquirido");
     }
-    return m_jsonBuffer;
+    return buffer->data;
 }
 
-bool MemoryManager::releaseJsonBuffer() {
-    if (!m_jsonBufferInUse) {
-        LOG_WARN(MODULE_NAME, "Buffer JSON já está livre");
+bool MemoryManager::releaseJsonBuffer(char *buffer) {
+    if (buffer == nullptr) return false;
+
+    // data é o primeiro membro, então o endereço coincide com o do JsonBuffer
+    if (!m_jsonBufferPool.release(reinterpret_cast<JsonBuffer *>(buffer))) {
+        LOG_WARN(MODULE_NAME, "Buffer JSON não pertence ao pool ou já está livre");
         return false;
     }
 
-    m_jsonBufferInUse = false;
     if (DEBUG_MEMORY) {
         LOG_DEBUG(MODULE_NAME, "Buffer JSON liberado");
     }
     return true;
 }
 
+ObjectPoolStats MemoryManager::getSensorDataPoolStats() const {
+    return m_sensorDataPool.getStats();
+}
+
+ObjectPoolStats MemoryManager::getJsonBufferPoolStats() const {
+    return m_jsonBufferPool.getStats();
+}
+
 const SystemStats &MemoryManager::updateStats() {
-    // Atualiza estatísticas apenas a cada segundo para evitar sobrecarga
     uint32_t currentTime = millis();
-    if (currentTime - m_lastCheckTime < 1000 && m_lastCheckTime > 0) {
-        return m_stats;
-    }
-
-    m_lastCheckTime = currentTime;
 
     // Atualiza estatísticas de heap
     m_stats.freeHeap = esp_get_free_heap_size();
@@ -152,6 +146,25 @@ const SystemStats &MemoryManager::updateStats() {
     // avançado, então deixamos em 0 por enquanto
     m_stats.cpuLoad = 0;
 
+    // Violações da garantia de zero alocações (0 fora do esp32dev_alloc_guard)
+    m_stats.hotPathAllocs = AllocationGuard::getViolationCount();
+
+    // Pontualidade das tarefas; o atraso é o máximo da janela desde a última atualização
+    LoopTimingMonitor::Stats sensorLoop = LoopTimingMonitor::getStats(LoopTimingMonitor::SENSOR_LOOP);
+    m_stats.sensorLoopLate = LoopTimingMonitor::takeWindowMax(LoopTimingMonitor::SENSOR_LOOP);
+    m_stats.sensorLoopMisses = sensorLoop.overruns;
+    m_stats.sensorLoopStreak = sensorLoop.maxMissStreak;
+
+    LoopTimingMonitor::Stats webLoop = LoopTimingMonitor::getStats(LoopTimingMonitor::WEB_LOOP);
+    m_stats.webLoopLate = LoopTimingMonitor::takeWindowMax(LoopTimingMonitor::WEB_LOOP);
+    m_stats.webLoopMisses = webLoop.overruns;
+    m_stats.webLoopStreak = webLoop.maxMissStreak;
+
+    // Linha do tempo de fragmentação em baixa taxa
+    #if HEAP_PROFILE_ENABLED
+        HeapProfiler::sample();
+    #endif
+
     return m_stats;
 }
 
@@ -174,21 +187,45 @@ void MemoryManager::printStats() {
     if (!DEBUG_MEMORY) return;
 
     // As estatísticas agora são exibidas no rotator de mensagens
-    // do SensorManager, reduzindo a verbosidade do console
-
-    // A cada 30 segundos (ou múltiplo disso) exibimos um relatório completo
-    static uint32_t lastFullReport = 0;
-    updateStats();
-
-    if (millis() - lastFullReport >= 30000) {
-        LOG_INFO(MODULE_NAME, "=== Relatório de Memória ===");
-        LOG_INFO(MODULE_NAME, "Heap livre: %u bytes", m_stats.freeHeap);
-        LOG_INFO(MODULE_NAME, "Heap livre mínimo: %u bytes", m_stats.minFreeHeap);
-        LOG_INFO(MODULE_NAME, "Fragmentação: %u%%", m_stats.heapFragmentation);
-        LOG_INFO(MODULE_NAME, "Maior bloco livre: %u bytes",
-                    heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
-        LOG_INFO(MODULE_NAME, "Tempo de atividade: %u segundos", m_stats.uptime);
-
-        lastFullReport = millis();
+    // do SensorManager, reduzindo a verbosidade do console. Este relatório
+    // completo é o job "memory.report", a cada MEMORY_STATS_INTERVAL_MS;
+    // m_stats é atualizado pelo job "memory.stats"
+    LOG_INFO(MODULE_NAME, "=== Relatório de Memória ===");
+    LOG_INFO(MODULE_NAME, "Heap livre: %u bytes", m_stats.freeHeap);
+    LOG_INFO(MODULE_NAME, "Heap livre mínimo: %u bytes", m_stats.minFreeHeap);
+    LOG_INFO(MODULE_NAME, "Fragmentação: %u%%", m_stats.heapFragmentation);
+    LOG_INFO(MODULE_NAME, "Maior bloco livre: %u bytes",
+                heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+    LOG_INFO(MODULE_NAME, "Tempo de atividade: %u segundos", m_stats.uptime);
+
+    ObjectPoolStats sensorPool = m_sensorDataPool.getStats();
+    ObjectPoolStats jsonPool = m_jsonBufferPool.getStats();
+    LOG_INFO(MODULE_NAME, "Pool SensorData: %u/%u em uso, pico %u, %u falhas",
+                sensorPool.inUse, sensorPool.capacity, sensorPool.highWater, sensorPool.failures);
+    LOG_INFO(MODULE_NAME, "Pool JSON: %u/%u em uso, pico %u, %u falhas",
+                jsonPool.inUse, jsonPool.capacity, jsonPool.highWater, jsonPool.failures);
+
+    RequestArena::Stats arenas = RequestArena::getStats();
+    LOG_INFO(MODULE_NAME, "Arenas web: %u/%u em uso, pico %u bytes, %u esgotamentos, %u estouros",
+                arenas.slabs.inUse, arenas.slabs.capacity, arenas.peakBytes,
+                arenas.exhausted, arenas.overflows);
+
+    HeapIntegrityChecker::Stats heapCheck = HeapIntegrityChecker::getStats();
+    LOG_INFO(MODULE_NAME, "Integridade do heap: %u passadas, %u falhas, região %u/%u, região máx %u us (%u bytes), passada %u us",
+                heapCheck.passes, heapCheck.failures, heapCheck.nextRegion, heapCheck.regions,
+                heapCheck.maxSliceMicros, heapCheck.maxSliceBytes, heapCheck.lastPassMicros);
+
+    for (uint8_t i = 0; i < LoopTimingMonitor::LOOP_COUNT; i++) {
+        LoopTimingMonitor::Loop loop = static_cast<LoopTimingMonitor::Loop>(i);
+        LoopTimingMonitor::Stats timing = LoopTimingMonitor::getStats(loop);
+        LOG_INFO(MODULE_NAME, "Tarefa %s: atraso máx %u us, %u prazos perdidos (sequência máx %u)",
+                    LoopTimingMonitor::getName(loop), timing.maxLateMicros,
+                    timing.overruns, timing.maxMissStreak);
     }
+
+    #if ALLOC_GUARD_ENABLED
+        AllocationGuard::Stats guard = AllocationGuard::getStats();
+        LOG_INFO(MODULE_NAME, "Alocações após o boot: %u em caminhos críticos (%u bytes), %u no total",
+                    guard.hotPathAllocs, guard.hotPathBytes, guard.steadyAllocs);
+    #endif
 }
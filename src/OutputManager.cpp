@@ -5,6 +5,11 @@
 
 #include "OutputManager.h"
 #include "AsyncSoilWebServer.h"
+#include "FixedString.h"
+#include "ProfileZone.h"
+
+// Nome do módulo para logs
+#define MODULE_NAME "Output"
 
 // Inicialização das variáveis estáticas
 AsyncSoilWebServer* OutputManager::s_webSocketServer = nullptr;
@@ -140,12 +145,14 @@ void OutputManager::routeToConsole(const char* module, LogLevel level, const cha
 }
 
 void OutputManager::routeToWebSocket(const char* sensor, TelemetryBuffer& data) {
+    PROFILE_ZONE("output.websocket");
+
     if (!s_webSocketServer) {
         return;
     }
 
     // Cria documento JSON para a telemetria
-    StaticJsonDocument<512> doc;
+    StaticJsonDocument<640> doc;
 
     // Criamos os objetos principais que a página web espera
     JsonObject root = doc.to<JsonObject>();
@@ -180,8 +187,18 @@ void OutputManager::routeToWebSocket(const char* sensor, TelemetryBuffer& data)
     stats["uptime"] = data.uptime;
     stats["wifiRssi"] = data.wifiRssi;
 
+    // Pontualidade das tarefas periódicas
+    stats["sensorLoopLate"] = data.sensorLoopLate;
+    stats["sensorLoopMisses"] = data.sensorLoopMisses;
+    stats["sensorLoopStreak"] = data.sensorLoopStreak;
+    stats["webLoopLate"] = data.webLoopLate;
+    stats["webLoopMisses"] = data.webLoopMisses;
+    stats["webLoopStreak"] = data.webLoopStreak;
+
     // Adicionar mais informações para a interface web
-    stats["wifi"] = String(data.wifiRssi) + " dBm";
+    FixedString<16> wifiLabel;
+    wifiLabel.appendf("%d dBm", data.wifiRssi);
+    stats["wifi"] = wifiLabel.c_str();
     stats["ipAddress"] = data.ipAddress;
 
     // A página web está buscando 'clients' - uma contagem de clientes
@@ -191,13 +208,19 @@ void OutputManager::routeToWebSocket(const char* sensor, TelemetryBuffer& data)
     root["source"] = sensor;
     root["timestamp"] = data.timestamp;
 
-    // Serializa para string
-    String jsonString;
-    serializeJson(doc, jsonString);
+    // Serializa na pilha: nenhuma String intermediária no heap
+    FixedString<WS_MESSAGE_BUFFER_SIZE> message;
+    serializeJson(doc, message);
+
+    // Um JSON truncado quebraria o parser da página; descarta o envio
+    if (message.truncated()) {
+        LOG_WARN(MODULE_NAME, "Telemetria excede %u bytes - envio descartado", WS_MESSAGE_BUFFER_SIZE);
+        return;
+    }
 
     // Agora que temos um único ponto de envio,
     // todas as mensagens terão o mesmo formato completo
-    s_webSocketServer->broadcastMessage(jsonString);
+    s_webSocketServer->broadcastMessage(message);
 }
 
 void OutputManager::routeToMemory(const char* module, LogLevel level, const char* message) {
@@ -0,0 +1,138 @@
+/**
+ * @file ProfileZone.cpp
+ * @brief Implementação das zonas de tempo e de seus histogramas.
+ */
+
+#include "ProfileZone.h"
+
+#if PROFILE_ZONES_ENABLED
+
+#include <freertos/FreeRTOS.h>
+#include "ConsoleCommands.h"
+
+static ProfileZone* s_head = nullptr;
+
+// Protege a lista e os histogramas; record() é chamado por várias tarefas
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+ProfileZone::ProfileZone(const char* name)
+    : m_name(name), m_next(nullptr) {
+    clear();
+
+    portENTER_CRITICAL(&s_lock);
+    m_next = s_head;
+    s_head = this;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void ProfileZone::clear() {
+    m_count = 0;
+    m_max = 0;
+    m_migrated = 0;
+    m_totalCycles = 0;
+    memset(m_buckets, 0, sizeof(m_buckets));
+}
+
+size_t ProfileZone::bucketOf(uint32_t cycles) {
+    if (cycles < SUB_BUCKETS) {
+        return cycles;
+    }
+
+    // Expoente da potência de 2 e os SUB_BITS bits seguintes ao mais alto
+    uint32_t exponent = 31 - __builtin_clz(cycles);
+    return (exponent - SUB_BITS + 1) * SUB_BUCKETS +
+           ((cycles >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1));
+}
+
+uint32_t ProfileZone::bucketUpperBound(size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+
+    uint32_t exponent = bucket / SUB_BUCKETS + SUB_BITS - 1;
+    uint64_t mantissa = SUB_BUCKETS + bucket % SUB_BUCKETS + 1;
+    return static_cast<uint32_t>((mantissa << (exponent - SUB_BITS)) - 1);
+}
+
+void ProfileZone::record(uint32_t cycles) {
+    size_t bucket = bucketOf(cycles);
+
+    portENTER_CRITICAL(&s_lock);
+    m_buckets[bucket]++;
+    m_count++;
+    m_totalCycles += cycles;
+    if (cycles > m_max) {
+        m_max = cycles;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void ProfileZone::discard() {
+    portENTER_CRITICAL(&s_lock);
+    m_migrated++;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+uint32_t ProfileZone::percentile(uint32_t rank) const {
+    uint32_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            // A faixa pode ir além da maior medição real
+            uint32_t bound = bucketUpperBound(i);
+            return bound < m_max ? bound : m_max;
+        }
+    }
+    return m_max;
+}
+
+ProfileZone::Summary ProfileZone::summarize() const {
+    Summary summary;
+    summary.name = m_name;
+
+    portENTER_CRITICAL(&s_lock);
+    summary.count = m_count;
+    summary.max = m_max;
+    summary.migrated = m_migrated;
+    summary.totalCycles = m_totalCycles;
+    summary.p50 = m_count ? percentile((m_count + 1) / 2) : 0;
+    summary.p99 = m_count ? percentile(static_cast<uint32_t>((static_cast<uint64_t>(m_count) * 99 + 99) / 100)) : 0;
+    portEXIT_CRITICAL(&s_lock);
+
+    return summary;
+}
+
+const ProfileZone* ProfileZone::first() {
+    return s_head;
+}
+
+void ProfileZone::resetAll() {
+    for (ProfileZone* zone = s_head; zone; zone = zone->m_next) {
+        portENTER_CRITICAL(&s_lock);
+        zone->clear();
+        portEXIT_CRITICAL(&s_lock);
+    }
+}
+
+void ProfileZone::printReport(const char* args) {
+    if (args && strcmp(args, "reset") == 0) {
+        resetAll();
+        ConsoleCommands::printf("Zonas de tempo zeradas\n");
+        return;
+    }
+
+    float cpuMhz = getCpuFrequencyMhz();
+
+    ConsoleCommands::printf("%-24s %10s %10s %10s %10s %10s %10s\n",
+                            "zona", "medições", "média µs", "p50 µs", "p99 µs", "max µs", "migradas");
+    for (const ProfileZone* zone = first(); zone; zone = zone->next()) {
+        Summary summary = zone->summarize();
+        float mean = summary.count ? summary.totalCycles / static_cast<float>(summary.count) : 0.0f;
+        ConsoleCommands::printf("%-24s %10u %10.1f %10.1f %10.1f %10.1f %10u\n",
+                                summary.name, summary.count, mean / cpuMhz,
+                                summary.p50 / cpuMhz, summary.p99 / cpuMhz, summary.max / cpuMhz,
+                                summary.migrated);
+    }
+}
+
+#endif // PROFILE_ZONES_ENABLED
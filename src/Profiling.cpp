@@ -1,78 +1,242 @@
 /**
  * @file Profiling.cpp
  * @brief Implementa funções para instrumentação e análise de desempenho de código.
+ *
+ * Todas as funções deste arquivo são marcadas com no_instrument_function:
+ * os hooks não podem instrumentar a si mesmos. Os hooks ficam em IRAM
+ * porque também são chamados por funções IRAM_ATTR durante escrita na flash.
+ *
+ * Funções inline de cabeçalhos (std::atomic, portENTER_CRITICAL) herdam a
+ * instrumentação ao serem expandidas aqui e chamariam os hooks de novo:
+ * os contadores usam os builtins __atomic_*, e os cabeçalhos do toolchain
+ * e do framework estão em -finstrument-functions-exclude-file-list.
  */
 
 #include <Arduino.h>
 #include "Config.h"
 #include "Profiling.h"
 
+#if FUNCTION_PROFILE_ENABLED
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "CycleCounter.h"
+
+#define NO_INSTRUMENT __attribute__((no_instrument_function))
+
+static_assert((PROFILE_MAX_FUNCTIONS & (PROFILE_MAX_FUNCTIONS - 1)) == 0,
+              "PROFILE_MAX_FUNCTIONS deve ser potência de 2");
+
 namespace Profiling {
-    // Variáveis para medir o tempo de execução de funções
-    static uint32_t function_entry_time = 0;
-    static uint32_t total_execution_time = 0;
-    static uint32_t function_calls = 0;
+    /**
+     * Quadro da pilha de chamadas de uma tarefa.
+     */
+    struct Frame {
+        uint32_t function;
+        uint32_t start;            ///< Ciclos na entrada
+        uint32_t childCycles;      ///< Ciclos inclusivos das funções chamadas
+    };
 
     /**
-     * Obtém as estatísticas de profiling acumuladas.
+     * Pilha de chamadas de uma tarefa. Só a própria tarefa a modifica.
      *
-     * @param total_time Ponteiro para armazenar o tempo total de execução.
-     * @param calls Ponteiro para armazenar o número de chamadas de função.
+     * As pilhas nunca são liberadas: o handle de uma tarefa excluída pode
+     * ser reaproveitado pelo FreeRTOS, e não há como distinguir as duas de
+     * forma barata dentro do hook. As tarefas do firmware são permanentes;
+     * tarefas transitórias além de PROFILE_MAX_TASKS entram em droppedCalls.
      */
-    void getStats(uint32_t *total_time, uint32_t *calls) {
-        if (total_time) {
-            *total_time = total_execution_time;
+    struct ShadowStack {
+        TaskHandle_t owner;
+        uint16_t depth;            ///< Pode exceder PROFILE_STACK_DEPTH
+        Frame frames[PROFILE_STACK_DEPTH];
+    };
+
+    static FunctionStats s_functions[PROFILE_MAX_FUNCTIONS];
+    static uint16_t s_functionCount = 0;
+
+    static ShadowStack s_stacks[PROFILE_MAX_TASKS];
+    static volatile uint8_t s_stackCount = 0;
+
+    // Incrementados pelos hooks dos dois cores fora do lock, com builtins
+    // (sem funções inline que seriam instrumentadas)
+    static uint32_t s_droppedCalls = 0;
+    static uint32_t s_depthOverflows = 0;
+
+    static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+    // Pilha da tarefa atual; antes do scheduler o handle é nulo ("boot")
+    static IRAM_ATTR NO_INSTRUMENT ShadowStack* currentStack() {
+        TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+        uint8_t count = s_stackCount;
+        for (uint8_t i = 0; i < count; i++) {
+            if (s_stacks[i].owner == task) {
+                return &s_stacks[i];
+            }
         }
-        if (calls) {
-            *calls = function_calls;
+
+        ShadowStack* stack = nullptr;
+        portENTER_CRITICAL(&s_lock);
+        if (s_stackCount < PROFILE_MAX_TASKS) {
+            stack = &s_stacks[s_stackCount];
+            stack->owner = task;
+            stack->depth = 0;
+            s_stackCount++;
         }
+        portEXIT_CRITICAL(&s_lock);
+
+        return stack;
+    }
+
+    static IRAM_ATTR NO_INSTRUMENT void record(uint32_t function, uint32_t inclusive, uint32_t exclusive) {
+        uint32_t slot = ((function >> 2) * 2654435761u) & (PROFILE_MAX_FUNCTIONS - 1);
+
+        portENTER_CRITICAL(&s_lock);
+
+        for (uint32_t probe = 0; probe < PROFILE_MAX_FUNCTIONS; probe++) {
+            FunctionStats& entry = s_functions[slot];
+
+            if (entry.address == function || entry.address == 0) {
+                if (entry.address == 0) {
+                    entry.address = function;
+                    s_functionCount++;
+                }
+                entry.calls++;
+                entry.inclusiveCycles += inclusive;
+                entry.exclusiveCycles += exclusive;
+                portEXIT_CRITICAL(&s_lock);
+                return;
+            }
+
+            slot = (slot + 1) & (PROFILE_MAX_FUNCTIONS - 1);
+        }
+
+        portEXIT_CRITICAL(&s_lock);
+        __atomic_fetch_add(&s_droppedCalls, 1, __ATOMIC_RELAXED);
+    }
+
+    NO_INSTRUMENT bool getFunction(size_t slot, FunctionStats &stats) {
+        if (slot >= PROFILE_MAX_FUNCTIONS) {
+            return false;
+        }
+
+        portENTER_CRITICAL(&s_lock);
+        stats = s_functions[slot];
+        portEXIT_CRITICAL(&s_lock);
+
+        return stats.address != 0;
+    }
+
+    NO_INSTRUMENT Summary getSummary() {
+        Summary summary;
+
+        portENTER_CRITICAL(&s_lock);
+        summary.functions = s_functionCount;
+        summary.tasks = s_stackCount;
+        summary.droppedCalls = __atomic_load_n(&s_droppedCalls, __ATOMIC_RELAXED);
+        summary.depthOverflows = __atomic_load_n(&s_depthOverflows, __ATOMIC_RELAXED);
+        portEXIT_CRITICAL(&s_lock);
+
+        return summary;
     }
 
     /**
      * Reinicia as estatísticas de profiling.
+     *
+     * As pilhas das tarefas são mantidas: funções em andamento são
+     * contabilizadas normalmente quando retornarem.
      */
-    void reset() {
-        total_execution_time = 0;
-        function_calls = 0;
+    NO_INSTRUMENT void reset() {
+        portENTER_CRITICAL(&s_lock);
+        memset(s_functions, 0, sizeof(s_functions));
+        s_functionCount = 0;
+        __atomic_store_n(&s_droppedCalls, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_depthOverflows, 0, __ATOMIC_RELAXED);
+        portEXIT_CRITICAL(&s_lock);
     }
 }
 
 extern "C" {
     /**
      * Função chamada automaticamente ao entrar em uma função instrumentada.
-     * Registra timestamp de entrada para profiling de desempenho.
+     * Empilha o endereço da função e o contador de ciclos de entrada.
+     * Em interrupção não faz nada: a pilha encontrada seria a da tarefa
+     * interrompida, que seria corrompida.
      *
      * @param this_fn Ponteiro para a função sendo acessada.
      * @param call_site Ponteiro para o local da chamada.
      */
-    void __cyg_profile_func_enter(void *this_fn, void *call_site) {
-        // Registra tempo de entrada
-        Profiling::function_entry_time = micros();
-        Profiling::function_calls++;
-
-        // No modo debug, pode imprimir endereços de função
-        if (DEBUG_MODE) {
-            APP_DEBUG_PRINT("PROFILE: Enter function at address %p called from %p\n",
-                         this_fn, call_site);
+    IRAM_ATTR NO_INSTRUMENT void __cyg_profile_func_enter(void *this_fn, void *call_site) {
+        if (xPortInIsrContext()) {
+            return;
+        }
+
+        Profiling::ShadowStack* stack = Profiling::currentStack();
+        if (!stack) {
+            __atomic_fetch_add(&Profiling::s_droppedCalls, 1, __ATOMIC_RELAXED);
+            return;
         }
+
+        if (stack->depth < PROFILE_STACK_DEPTH) {
+            Profiling::Frame& frame = stack->frames[stack->depth];
+            frame.function = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this_fn));
+            frame.childCycles = 0;
+            frame.start = CycleCounter::now();
+        } else {
+            __atomic_fetch_add(&Profiling::s_depthOverflows, 1, __ATOMIC_RELAXED);
+        }
+        stack->depth++;
     }
 
     /**
      * Função chamada automaticamente ao sair de uma função instrumentada.
-     * Calcula tempo de execução para profiling de desempenho.
+     * Desempilha o quadro, acumula os ciclos inclusivos e exclusivos e
+     * repassa os inclusivos ao quadro do chamador.
      *
      * @param this_fn Ponteiro para a função sendo finalizada.
      * @param call_site Ponteiro para o local da chamada.
      */
-    void __cyg_profile_func_exit(void *this_fn, void *call_site) {
-        uint32_t now = micros();
-        uint32_t execution_time = now - Profiling::function_entry_time;
-        Profiling::total_execution_time += execution_time;
-
-        // Opcional: imprime tempo de execução no modo debug
-        if (DEBUG_MODE) {
-            APP_DEBUG_PRINT("PROFILE: Exit function at address %p - execution time: %u us\n",
-                         this_fn, execution_time);
+    IRAM_ATTR NO_INSTRUMENT void __cyg_profile_func_exit(void *this_fn, void *call_site) {
+        if (xPortInIsrContext()) {
+            return;
+        }
+
+        uint32_t now = CycleCounter::now();
+
+        Profiling::ShadowStack* stack = Profiling::currentStack();
+        if (!stack || stack->depth == 0) {
+            return;
+        }
+
+        stack->depth--;
+        if (stack->depth >= PROFILE_STACK_DEPTH) {
+            return;
         }
+
+        const Profiling::Frame& frame = stack->frames[stack->depth];
+        uint32_t inclusive = now - frame.start;
+        uint32_t exclusive = inclusive - frame.childCycles;
+
+        if (stack->depth > 0) {
+            stack->frames[stack->depth - 1].childCycles += inclusive;
+        }
+
+        Profiling::record(frame.function, inclusive, exclusive);
     }
 }
+
+#else
+
+namespace Profiling {
+    bool getFunction(size_t, FunctionStats &) {
+        return false;
+    }
+
+    Summary getSummary() {
+        return Summary();
+    }
+
+    void reset() {}
+}
+
+#endif // FUNCTION_PROFILE_ENABLED
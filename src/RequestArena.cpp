@@ -0,0 +1,92 @@
+/**
+ * @file RequestArena.cpp
+ * @brief Implementação das arenas por requisição.
+ */
+
+#include "RequestArena.h"
+#include "LogSystem.h"
+#include <freertos/FreeRTOS.h>
+
+// Nome do módulo para logs
+#define MODULE_NAME "Arena"
+
+// Slabs pré-alocados, compartilhados pelo AsyncTCP e pela tarefa web
+static ObjectPool<RequestArena, REQUEST_ARENA_SLAB_COUNT> s_slabs;
+
+static uint32_t s_acquired = 0;
+static uint32_t s_overflows = 0;
+static uint32_t s_peakBytes = 0;
+static portMUX_TYPE s_statsLock = portMUX_INITIALIZER_UNLOCKED;
+
+RequestArena* RequestArena::acquire() {
+    RequestArena* arena = s_slabs.acquire();
+
+    if (arena) {
+        portENTER_CRITICAL(&s_statsLock);
+        s_acquired++;
+        portEXIT_CRITICAL(&s_statsLock);
+    } else {
+        LOG_WARN(MODULE_NAME, "Nenhum slab livre para a requisição");
+    }
+
+    return arena;
+}
+
+void RequestArena::release(RequestArena* arena) {
+    if (!arena) {
+        return;
+    }
+
+    portENTER_CRITICAL(&s_statsLock);
+    if (arena->m_offset > s_peakBytes) {
+        s_peakBytes = arena->m_offset;
+    }
+    portEXIT_CRITICAL(&s_statsLock);
+
+    if (!s_slabs.release(arena)) {
+        LOG_ERROR(MODULE_NAME, "Arena liberada não pertence ao pool");
+    }
+}
+
+RequestArena::Stats RequestArena::getStats() {
+    Stats stats;
+
+    portENTER_CRITICAL(&s_statsLock);
+    stats.acquired = s_acquired;
+    stats.overflows = s_overflows;
+    stats.peakBytes = s_peakBytes;
+    portEXIT_CRITICAL(&s_statsLock);
+
+    stats.slabs = s_slabs.getStats();
+    stats.exhausted = stats.slabs.failures;
+    return stats;
+}
+
+void* RequestArena::allocate(size_t size, size_t alignment) {
+    size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+
+    if (offset > REQUEST_ARENA_SLAB_SIZE || size > REQUEST_ARENA_SLAB_SIZE - offset) {
+        portENTER_CRITICAL(&s_statsLock);
+        s_overflows++;
+        portEXIT_CRITICAL(&s_statsLock);
+        return nullptr;
+    }
+
+    m_offset = offset + size;
+    return &m_slab[offset];
+}
+
+char* RequestArena::copyString(const void* data, size_t length) {
+    char* copy = static_cast<char*>(allocate(length + 1, 1));
+    if (copy) {
+        memcpy(copy, data, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+char* RequestArena::allocateRemaining(size_t* capacity) {
+    size_t available = remaining();
+    *capacity = available;
+    return available > 0 ? static_cast<char*>(allocate(available, 1)) : nullptr;
+}
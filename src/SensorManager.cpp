@@ -10,6 +10,9 @@
 #include "SystemMonitor.h"
 #include "WiFiManager.h"
 #include "StringUtils.h"
+#include "SignalFilter.h"
+#include "ProfileZone.h"
+#include "SensorTraceRecorder.h"
 
 // Define o nome do módulo para logging
 #define MODULE_NAME "SensorManager"
@@ -68,34 +71,18 @@ bool SensorManager::init() {
 }
 
 uint16_t SensorManager::applyFilter(uint16_t readings[], uint16_t newValue) {
-    // Atualiza o buffer circular
-    readings[m_filterIndex] = newValue;
-
-    // Calcula a média
-    uint32_t sum = 0;
-    for (uint8_t i = 0; i < FILTER_SIZE; i++) {
-        sum += readings[i];
-    }
-
-    return static_cast<uint16_t>(sum / FILTER_SIZE);
+    // Atualiza o buffer circular e calcula a média
+    return SignalFilter::movingAverage<FILTER_SIZE, uint32_t>(readings, m_filterIndex, newValue);
 }
 
 float SensorManager::applyFilter(float readings[], float newValue) {
     // Implementação para valores de ponto flutuante (DHT22)
-
-    // Atualiza o buffer circular com o novo valor
-    readings[m_filterIndex] = newValue;
-
-    // Calcula a média dos valores no buffer
-    float sum = 0.0f;
-    for (uint8_t i = 0; i < FILTER_SIZE; i++) {
-        sum += readings[i];
-    }
-
-    return sum / FILTER_SIZE;
+    return SignalFilter::movingAverage<FILTER_SIZE, float>(readings, m_filterIndex, newValue);
 }
 
 void SensorManager::readSensors() {
+    PROFILE_ZONE("sensor.read");
+
     // Atualiza contador
     m_readCount++;
 
@@ -119,6 +106,10 @@ void SensorManager::readSensors() {
     float temperature = Hardware::readTemperature();
     float humidity = Hardware::readHumidity();
 
+    // Grava as leituras antes dos filtros (botão pressionado = pino em LOW)
+    SENSOR_TRACE_RECORD(m_rawData.timestamp, phRaw, temperature, humidity,
+                        phosphorusButtonPressed ? LOW : HIGH, potassiumButtonPressed ? LOW : HIGH);
+
     // Aplica filtro de média móvel ao pH
     m_rawData.phRaw = applyFilter(m_phReadings, phRaw);
 
@@ -215,6 +206,12 @@ TelemetryBuffer SensorManager::prepareTelemetry() {
     telemetry.freeHeap = stats.freeHeap;
     telemetry.heapFragmentation = stats.heapFragmentation;
     telemetry.uptime = stats.uptime;
+    telemetry.sensorLoopLate = stats.sensorLoopLate;
+    telemetry.sensorLoopMisses = stats.sensorLoopMisses;
+    telemetry.sensorLoopStreak = stats.sensorLoopStreak;
+    telemetry.webLoopLate = stats.webLoopLate;
+    telemetry.webLoopMisses = stats.webLoopMisses;
+    telemetry.webLoopStreak = stats.webLoopStreak;
 
     // Preenche dados de WiFi
     WiFiManager& wifiManager = WiFiManager::getInstance();
@@ -238,6 +235,8 @@ TelemetryBuffer SensorManager::prepareTelemetry() {
 }
 
 bool SensorManager::update(bool forceUpdate) {
+    PROFILE_ZONE("sensor.update");
+
     uint32_t currentTime = millis();
     static uint32_t lastDisplayUpdate = 0;
     bool dataChanged = false;
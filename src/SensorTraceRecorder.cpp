@@ -0,0 +1,72 @@
+/**
+ * @file SensorTraceRecorder.cpp
+ * @brief Implementação do anel de leituras brutas dos sensores.
+ */
+
+#include "SensorTraceRecorder.h"
+
+static_assert(sizeof(SensorTraceRecorder::Record) == 12, "Registro do trace de sensores deve ter 12 bytes");
+
+#if SENSOR_TRACE_ENABLED
+
+static_assert((SENSOR_TRACE_RECORDS & (SENSOR_TRACE_RECORDS - 1)) == 0,
+              "SENSOR_TRACE_RECORDS deve ser potência de 2");
+
+static SensorTraceRecorder::Record s_records[SENSOR_TRACE_RECORDS];
+static uint32_t s_head = 0;
+static uint32_t s_discarded = 0;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void SensorTraceRecorder::record(const Record& record) {
+    // Só a tarefa de sensores grava; o lock protege a cópia lida pela web
+    portENTER_CRITICAL(&s_lock);
+    s_records[s_head & (SENSOR_TRACE_RECORDS - 1)] = record;
+    s_head++;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+uint32_t SensorTraceRecorder::getHead() {
+    portENTER_CRITICAL(&s_lock);
+    uint32_t head = s_head;
+    portEXIT_CRITICAL(&s_lock);
+    return head;
+}
+
+uint32_t SensorTraceRecorder::getTail() {
+    portENTER_CRITICAL(&s_lock);
+    uint32_t oldest = s_head > SENSOR_TRACE_RECORDS ? s_head - SENSOR_TRACE_RECORDS : 0;
+    uint32_t tail = s_discarded > oldest ? s_discarded : oldest;
+    portEXIT_CRITICAL(&s_lock);
+    return tail;
+}
+
+bool SensorTraceRecorder::readRecord(uint32_t position, Record& record) {
+    bool valid;
+
+    portENTER_CRITICAL(&s_lock);
+    valid = position < s_head && s_head - position <= SENSOR_TRACE_RECORDS;
+    if (valid) {
+        record = s_records[position & (SENSOR_TRACE_RECORDS - 1)];
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    return valid;
+}
+
+void SensorTraceRecorder::discardUntil(uint32_t position) {
+    portENTER_CRITICAL(&s_lock);
+    if (position > s_discarded && position <= s_head) {
+        s_discarded = position;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+uint32_t SensorTraceRecorder::getDropped() {
+    portENTER_CRITICAL(&s_lock);
+    uint32_t oldest = s_head > SENSOR_TRACE_RECORDS ? s_head - SENSOR_TRACE_RECORDS : 0;
+    uint32_t dropped = oldest > s_discarded ? oldest - s_discarded : 0;
+    portEXIT_CRITICAL(&s_lock);
+    return dropped;
+}
+
+#endif // SENSOR_TRACE_ENABLED
@@ -5,6 +5,7 @@
 
 #include "SystemMonitor.h"
 #include "LogSystem.h"
+#include "JobScheduler.h"
 
 // Define o nome do módulo para logging
 #define MODULE_NAME "SysMonitor"
@@ -13,8 +14,7 @@
 SystemMonitor *SystemMonitor::s_instance = nullptr;
 
 SystemMonitor::SystemMonitor()
-    : m_lastCheckTime(0),
-    m_lastWatchdogReset(0),
+    : m_lastWatchdogReset(0),
     m_watchdogActive(false),
     m_bootTime(millis()) {
 }
@@ -40,6 +40,13 @@ bool SystemMonitor::init() {
         LOG_INFO(MODULE_NAME, "Watchdog desativado por configuração");
     }
 
+    // Manutenção periódica na tarefa de sensores, em fases distintas
+    if (m_watchdogActive) {
+        JobScheduler::add("watchdog", WATCHDOG_TIMEOUT * 3 / 4, 500, TASK_SENSOR_CORE,
+                          watchdogJob, this);
+    }
+    JobScheduler::add("memory.stats", 1000, 0, TASK_SENSOR_CORE, memoryStatsJob);
+
     LOG_INFO(MODULE_NAME, "Monitor do sistema inicializado com sucesso");
     return true;
 }
@@ -74,56 +81,44 @@ bool SystemMonitor::setupWatchdog() {
     return true;
 }
 
-const SystemStats &SystemMonitor::update() {
-    // Atualiza estatísticas a cada 1 segundo
+void SystemMonitor::watchdogJob(void *context) {
+    // Reinicia o watchdog - isso é um processo normal. O job roda a 75% do
+    // timeout para garantir margem de segurança
+    SystemMonitor *monitor = static_cast<SystemMonitor *>(context);
     uint32_t currentTime = millis();
+    uint32_t timeElapsed = currentTime - monitor->m_lastWatchdogReset;
 
-    // Reinicia o watchdog se ativo - isso é um processo normal
-    // A lógica foi refinada para ser mais robusta e sem mensagens intrusivas
-    if (m_watchdogActive) {
-        uint32_t timeElapsed = currentTime - m_lastWatchdogReset;
-
-        // Redefine o tempo máximo para 75% do timeout para garantir margem de segurança
-        if (timeElapsed >= (WATCHDOG_TIMEOUT * 3 / 4)) {
-            // Reinicia o watchdog com tempo adequado
-            esp_task_wdt_reset();
-            m_lastWatchdogReset = currentTime;
-
-            // Se precisar mostrar estatísticas de watchdog em modo de debug,
-            // usa o sistema de telemetria para não interferir com outras saídas
-            #ifdef DEBUG_WATCHDOG
-            #if DEBUG_WATCHDOG
-            static uint32_t watchdogResets = 0;
-            static uint32_t telemetryToken = 0;
-
-            // Obtém token de telemetria na primeira vez ou reusa o existente
-            if (telemetryToken == 0) {
-                telemetryToken = TELEMETRY_BEGIN("Watchdog");
-            }
-
-            // Atualiza a telemetria
-            if (telemetryToken != 0) {
-                TELEMETRY_UPDATE(telemetryToken,
-                    "Watchdog: %u resets | Último intervalo: %u ms",
-                    ++watchdogResets, timeElapsed);
-            }
-            #endif
-            #endif
-        }
-    }
+    esp_task_wdt_reset();
+    monitor->m_lastWatchdogReset = currentTime;
 
-    // Atualiza as estatísticas de memória se for hora
-    if (currentTime - m_lastCheckTime >= 1000) {
-        m_lastCheckTime = currentTime;
-        MemoryManager::getInstance().updateStats();
+    // Se precisar mostrar estatísticas de watchdog em modo de debug,
+    // usa o sistema de telemetria para não interferir com outras saídas
+    #ifdef DEBUG_WATCHDOG
+    #if DEBUG_WATCHDOG
+    static uint32_t watchdogResets = 0;
+    static uint32_t telemetryToken = 0;
 
-        // Verifica integridade da memória a cada 10 segundos
-        if ((currentTime / 1000) % 10 == 0) {
-            checkSystemIntegrity();
-        }
+    // Obtém token de telemetria na primeira vez ou reusa o existente
+    if (telemetryToken == 0) {
+        telemetryToken = TELEMETRY_BEGIN("Watchdog");
     }
 
-    return MemoryManager::getInstance().getStats();
+    // Atualiza a telemetria
+    if (telemetryToken != 0) {
+        TELEMETRY_UPDATE(telemetryToken,
+            "Watchdog: %u resets | Último intervalo: %u ms",
+            ++watchdogResets, timeElapsed);
+    }
+    #endif
+    #endif
+    (void)timeElapsed;
+}
+
+void SystemMonitor::memoryStatsJob(void*) {
+    MemoryManager::getInstance().updateStats();
+
+    // A integridade do heap é verificada em fatias pelo
+    // HeapIntegrityChecker, fora do ciclo de sensores
 }
 
 const SystemStats &SystemMonitor::getStats() const {
@@ -160,6 +155,11 @@ void IRAM_ATTR SystemMonitor::restart(const char *reason) {
     LOG_FATAL(MODULE_NAME, "Razão: %s", reason);
     LOG_FATAL(MODULE_NAME, "Reiniciando ESP32...");
 
+    // No modo diferido, envia os quadros pendentes antes do texto de emergência
+    #if LOG_DEFERRED_MODE
+        DeferredLog::flush();
+    #endif
+
     // Em situação de reinicialização de emergência, também usamos Serial diretamente
     // como backup, pois o sistema de log pode depender de heap que pode estar corrompido
 
@@ -20,6 +20,12 @@ TelemetryBuffer::TelemetryBuffer()
       heapFragmentation(0),
       uptime(0),
       wifiRssi(0),
+      sensorLoopLate(0),
+      sensorLoopMisses(0),
+      sensorLoopStreak(0),
+      webLoopLate(0),
+      webLoopMisses(0),
+      webLoopStreak(0),
       timestamp(0),
       readCount(0) {
     memset(ipAddress, 0, sizeof(ipAddress));
@@ -53,6 +59,12 @@ void TelemetryBuffer::toJson(JsonObject& json) const {
     stats["uptime"] = uptime;
     stats["wifiRssi"] = wifiRssi;
     stats["ipAddress"] = ipAddress;
+    stats["sensorLoopLate"] = sensorLoopLate;
+    stats["sensorLoopMisses"] = sensorLoopMisses;
+    stats["sensorLoopStreak"] = sensorLoopStreak;
+    stats["webLoopLate"] = webLoopLate;
+    stats["webLoopMisses"] = webLoopMisses;
+    stats["webLoopStreak"] = webLoopStreak;
 }
 
 char* TelemetryBuffer::toConsoleString(char* buffer, size_t bufferSize, TelemetryType type) const {
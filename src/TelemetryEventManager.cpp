@@ -12,15 +12,12 @@
 // Inicialização das variáveis estáticas
 TelemetryEventListener TelemetryEventManager::s_listeners[MAX_LISTENERS] = {nullptr};
 uint8_t TelemetryEventManager::s_listenerCount = 0;
-SemaphoreHandle_t TelemetryEventManager::s_mutex = nullptr;
+InstrumentedMutex TelemetryEventManager::s_mutex("telemetry.listeners");
 
 void TelemetryEventManager::initialize() {
     // Cria o mutex apenas uma vez
-    if (s_mutex == nullptr) {
-        s_mutex = xSemaphoreCreateMutex();
-        if (s_mutex == nullptr) {
-            LOG_ERROR(MODULE_NAME, "Falha ao criar mutex para gerenciador de telemetria");
-        }
+    if (!s_mutex.isCreated() && !s_mutex.create()) {
+        LOG_ERROR(MODULE_NAME, "Falha ao criar mutex para gerenciador de telemetria");
     }
 }
 
@@ -28,18 +25,17 @@ bool TelemetryEventManager::addListener(TelemetryEventListener listener) {
     if (listener == nullptr) return false;
 
     // Sempre garantir inicialização antes de tentar usar o mutex
-    if (s_mutex == nullptr) {
+    if (!s_mutex.isCreated()) {
         initialize();
     }
 
     // Se falhar na inicialização, tenta uma última vez
-    if (s_mutex == nullptr) {
-        s_mutex = xSemaphoreCreateMutex();
-        if (s_mutex == nullptr) return false;
+    if (!s_mutex.create()) {
+        return false;
     }
 
     bool result = false;
-    if (xSemaphoreTake(s_mutex, portMAX_DELAY) == pdTRUE) {
+    if (s_mutex.take(portMAX_DELAY)) {
         if (s_listenerCount < MAX_LISTENERS) {
             // Verificar se o listener já está registrado para evitar duplicação
             bool found = false;
@@ -58,7 +54,7 @@ bool TelemetryEventManager::addListener(TelemetryEventListener listener) {
             }
             result = true;
         }
-        xSemaphoreGive(s_mutex);
+        s_mutex.give();
     }
     return result;
 }
@@ -67,13 +63,13 @@ bool TelemetryEventManager::removeListener(TelemetryEventListener listener) {
     if (listener == nullptr) return false;
 
     // Garantir inicialização do mutex para evitar crashes
-    if (s_mutex == nullptr) {
+    if (!s_mutex.isCreated()) {
         initialize();
-        if (s_mutex == nullptr) return false;
+        if (!s_mutex.isCreated()) return false;
     }
 
     bool result = false;
-    if (xSemaphoreTake(s_mutex, portMAX_DELAY) == pdTRUE) {
+    if (s_mutex.take(portMAX_DELAY)) {
         for (uint8_t i = 0; i < s_listenerCount; i++) {
             if (s_listeners[i] == listener) {
                 // Move os ouvintes restantes para preencher o espaço
@@ -86,7 +82,7 @@ bool TelemetryEventManager::removeListener(TelemetryEventListener listener) {
                 break;
             }
         }
-        xSemaphoreGive(s_mutex);
+        s_mutex.give();
     }
     return result;
 }
@@ -100,16 +96,16 @@ void TelemetryEventManager::distribute(const char* source, const TelemetryBuffer
     if (s_listenerCount == 0) {
         LOG_DEBUG(MODULE_NAME, "Sem listeners registrados para telemetria");
         // Se o sistema não está inicializado, tenta inicializar para futuros listeners
-        if (s_mutex == nullptr) {
+        if (!s_mutex.isCreated()) {
             initialize();
         }
         return;
     }
 
     // Garantir que temos mutex válido para acessar a lista de ouvintes
-    if (s_mutex == nullptr) {
+    if (!s_mutex.isCreated()) {
         initialize();
-        if (s_mutex == nullptr) return; // Falha na inicialização, não pode prosseguir
+        if (!s_mutex.isCreated()) return; // Falha na inicialização, não pode prosseguir
     }
 
     // Uso de buffer na stack para minimizar overhead de memória
@@ -117,13 +113,13 @@ void TelemetryEventManager::distribute(const char* source, const TelemetryBuffer
     uint8_t count = 0;
 
     // Seção crítica curta: copia referências dos listeners rapidamente
-    if (xSemaphoreTake(s_mutex, pdMS_TO_TICKS(10)) == pdTRUE) { // Timeout curto para não bloquear
+    if (s_mutex.take(pdMS_TO_TICKS(10))) { // Timeout curto para não bloquear
         count = s_listenerCount;
         LOG_DEBUG(MODULE_NAME, "Notificando %d listeners sobre telemetria", count);
         for (uint8_t i = 0; i < count && i < MAX_LISTENERS; i++) {
             listeners[i] = s_listeners[i];
         }
-        xSemaphoreGive(s_mutex);
+        s_mutex.give();
     }
 
     // Fora da seção crítica: invoca cada listener com os dados
@@ -0,0 +1,174 @@
+/**
+ * @file TraceRecorder.cpp
+ * @brief Implementação dos anéis de trace por core.
+ *
+ * record() pode ser chamado de qualquer tarefa e do console: não loga nem
+ * aloca.
+ */
+
+#include "TraceRecorder.h"
+
+#if TRACE_ENABLED
+
+#include <freertos/task.h>
+#include <esp_timer.h>
+#include "CycleCounter.h"
+
+static_assert((TRACE_RING_EVENTS & (TRACE_RING_EVENTS - 1)) == 0,
+              "TRACE_RING_EVENTS deve ser potência de 2");
+static_assert(sizeof(TraceRecorder::Event) == 16, "Evento de trace deve ter 16 bytes");
+
+// Ciclos entre âncoras de um core: bem abaixo do estouro de CCOUNT (2^32)
+static constexpr uint32_t ANCHOR_INTERVAL_CYCLES = 1u << 27;
+
+// Eventos entre âncoras: mesmo com o anel cheio há sempre algumas no dump
+static constexpr uint32_t ANCHOR_INTERVAL_EVENTS = TRACE_RING_EVENTS / 4;
+
+/**
+ * Anel de um core. A posição é reservada com incremento atômico, então
+ * tarefas que se interrompem no mesmo core nunca escrevem no mesmo evento.
+ */
+struct CoreRing {
+    uint32_t head;
+    uint32_t lastAnchor;        ///< CCOUNT da última âncora
+    uint32_t lastAnchorHead;    ///< Posição da última âncora
+    bool anchored;
+    TraceRecorder::Event events[TRACE_RING_EVENTS];
+};
+
+struct TaskEntry {
+    TaskHandle_t handle;
+    char name[configMAX_TASK_NAME_LEN];
+};
+
+static CoreRing s_rings[TraceRecorder::CORE_COUNT];
+
+static const char* s_names[TRACE_MAX_NAMES] = {"?"};
+static uint8_t s_nameCount = 1;
+
+static TaskEntry s_tasks[TRACE_MAX_TASKS];
+static volatile uint8_t s_taskCount = 0;
+
+static volatile bool s_paused = false;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+uint8_t TraceRecorder::internName(const char* name) {
+    uint8_t index = 0;
+
+    portENTER_CRITICAL(&s_lock);
+    if (s_nameCount < TRACE_MAX_NAMES) {
+        index = s_nameCount;
+        s_names[s_nameCount++] = name;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    return index;
+}
+
+uint8_t TraceRecorder::currentTask() {
+    TaskHandle_t handle = xTaskGetCurrentTaskHandle();
+
+    uint8_t count = s_taskCount;
+    for (uint8_t i = 0; i < count; i++) {
+        if (s_tasks[i].handle == handle) {
+            return i;
+        }
+    }
+
+    // Tarefa nova: o nome é copiado agora, enquanto ela certamente existe
+    uint8_t index = TRACE_MAX_TASKS - 1;
+    portENTER_CRITICAL(&s_lock);
+    if (s_taskCount < TRACE_MAX_TASKS - 1) {
+        index = s_taskCount;
+        s_tasks[index].handle = handle;
+        const char* name = handle ? pcTaskGetName(handle) : "boot";
+        strncpy(s_tasks[index].name, name, sizeof(s_tasks[index].name) - 1);
+        s_taskCount = index + 1;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    return index;
+}
+
+static inline void writeEvent(CoreRing& ring, uint8_t core, uint32_t timestamp,
+                              TraceRecorder::EventType type, uint8_t name, uint8_t task, int32_t value) {
+    uint32_t position = __atomic_fetch_add(&ring.head, 1, __ATOMIC_RELAXED);
+    TraceRecorder::Event& event = ring.events[position & (TRACE_RING_EVENTS - 1)];
+
+    // Invalida o evento antigo antes de sobrescrevê-lo
+    __atomic_store_n(&event.sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    event.timestamp = timestamp;
+    event.value = value;
+    event.name = name;
+    event.task = task;
+    event.type = type;
+    event.core = core;
+
+    __atomic_store_n(&event.sequence, position + 1, __ATOMIC_RELEASE);
+}
+
+void TraceRecorder::record(EventType type, uint8_t name, int32_t value) {
+    if (s_paused) {
+        return;
+    }
+
+    uint32_t now = CycleCounter::now();
+    uint8_t core = xPortGetCoreID();
+    uint8_t task = currentTask();
+    CoreRing& ring = s_rings[core];
+
+    if (!ring.anchored || now - ring.lastAnchor >= ANCHOR_INTERVAL_CYCLES ||
+        ring.head - ring.lastAnchorHead >= ANCHOR_INTERVAL_EVENTS) {
+        ring.anchored = true;
+        ring.lastAnchor = now;
+        ring.lastAnchorHead = ring.head;
+        writeEvent(ring, core, now, ANCHOR, 0, task, static_cast<int32_t>(esp_timer_get_time()));
+    }
+
+    writeEvent(ring, core, now, type, name, task, value);
+}
+
+void TraceRecorder::setPaused(bool paused) {
+    s_paused = paused;
+}
+
+uint8_t TraceRecorder::getNameCount() {
+    return s_nameCount;
+}
+
+const char* TraceRecorder::getName(uint8_t index) {
+    return index < s_nameCount ? s_names[index] : "?";
+}
+
+uint8_t TraceRecorder::getTaskCount() {
+    // A última posição agrupa as tarefas que não couberam na tabela
+    return s_taskCount == TRACE_MAX_TASKS - 1 ? TRACE_MAX_TASKS : s_taskCount;
+}
+
+const char* TraceRecorder::getTaskName(uint8_t index) {
+    return index < s_taskCount ? s_tasks[index].name : "outras";
+}
+
+uint32_t TraceRecorder::getHead(uint8_t core) {
+    return core < CORE_COUNT ? __atomic_load_n(&s_rings[core].head, __ATOMIC_ACQUIRE) : 0;
+}
+
+bool TraceRecorder::readEvent(uint8_t core, uint32_t position, Event& event) {
+    if (core >= CORE_COUNT) {
+        return false;
+    }
+
+    const Event& slot = s_rings[core].events[position & (TRACE_RING_EVENTS - 1)];
+
+    // Cópia validada pela sequência antes e depois, como um seqlock
+    uint32_t before = __atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE);
+    event = slot;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint32_t after = __atomic_load_n(&slot.sequence, __ATOMIC_RELAXED);
+
+    return before == position + 1 && after == before;
+}
+
+#endif // TRACE_ENABLED
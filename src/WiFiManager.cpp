@@ -10,6 +10,7 @@
 #include "OutputManager.h"
 #include "TelemetryBuffer.h"
 #include "StringUtils.h"
+#include "TraceRecorder.h"
 
 // Nome do módulo para logs
 static const char* MODULE_NAME = "WiFi";
@@ -33,6 +34,8 @@ WiFiManager &WiFiManager::getInstance() {
 }
 
 void WiFiManager::WiFiEventHandler(WiFiEvent_t event, WiFiEventInfo_t info) {
+    TRACE_INSTANT("wifi.manager", event);
+
     WiFiManager &instance = getInstance();
 
     switch (event) {
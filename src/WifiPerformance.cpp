@@ -8,6 +8,7 @@
 #include "Config.h"
 #include "WifiPerformance.h"
 #include "LogSystem.h"
+#include "TraceRecorder.h"
 // Incluindo cabeçalhos do FreeRTOS diretamente no arquivo de implementação
 #include <Arduino.h>
 #include <freertos/FreeRTOS.h>
@@ -26,6 +27,8 @@ extern "C" {
 // Handler de eventos do WiFi agora implementado como método estático da classe
 // para melhor encapsulamento e evitar conflitos de namespace
 void WifiPerformanceInitializer::wifiEventHandler(WiFiEvent_t event, WiFiEventInfo_t info) {
+    TRACE_INSTANT("wifi.performance", event);
+
     // Limita-se apenas ao evento mais crítico: conexão bem-sucedida
     if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
         // Evita operações complexas, apenas registra status básico